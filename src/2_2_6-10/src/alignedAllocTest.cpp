@@ -0,0 +1,216 @@
+#include "./include/defaultAllocTemplate.h"
+#include "./include/simpleAlloc.h"
+#include "./include/monotonicArena.h"
+#include "../../2_3/unintilizedCopy/include/cppAlloc.h"
+#include "../../4_2/vector/include/myVector.h"
+#include "../../4_2/dequeue/include/deque.h"
+#include "../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/*
+    对齐分配测试：
+    1. 第一级配置器的 allocate(n, align) 对 16 ~ 4096 的对齐边界都返回对齐的地址；
+    2. 第二级配置器在对齐要求不超过 __ALIGN 时仍走内存池，更严格的对齐转交第一级配置器；
+    3. alignas(64) 的类型放进以 sgiAlloc / arenaAlloc 为分配器的 My_Vector、My_Deque，
+       每个元素都是 64 字节对齐的，扩容之后依然如此；
+    4. CPP_ALLOC::__allocate 对超出默认对齐的类型使用对齐的 operator new。
+*/
+
+using singleAlloc = SGIAllocator::__DefaultAllocTemplate<false, 50>;
+using threadAlloc = SGIAllocator::__DefaultAllocTemplate<true, 51>;
+
+bool isAligned(const void * __ptr, std::size_t __align) { return ((std::uintptr_t)__ptr & (__align - 1)) == 0; }
+
+/*按缓存行填充的计数器*/
+struct alignas(64) PaddedCounter
+{
+    long value;
+
+    PaddedCounter(long __value = 0) : value(__value) {}
+};
+
+void checkMallocAlloc(void)
+{
+    for (std::size_t align = 16; align <= 4096; align *= 2)
+    {
+        for (std::size_t bytes : {1, 24, 100, 5000})
+        {
+            void * block = mallocAlloc::allocate(bytes, align);
+
+            CHECK(isAligned(block, align));
+            std::memset(block, 0x7F, bytes);
+            mallocAlloc::deallocate(block, bytes, align);
+        }
+
+        /*空指针的 reallocate 等同于 allocate*/
+        void * block = mallocAlloc::reallocate(nullptr, 0, 100, align);
+
+        CHECK(block != nullptr && isAligned(block, align));
+        mallocAlloc::deallocate(block, 100, align);
+    }
+}
+
+template <typename Alloc>
+void checkDefaultAlloc(void)
+{
+    /*不超过 __ALIGN 的对齐要求与普通分配一样走内存池*/
+    SGIAllocator::__MallocAllocStats before = mallocAlloc::getStats();
+
+    std::vector<void *> small;
+    for (int index = 0; index < 100; ++index) { small.push_back(Alloc::allocate(24, 8)); }
+    for (void * block : small) { CHECK(isAligned(block, 8)); Alloc::deallocate(block, 24, 8); }
+
+    CHECK(mallocAlloc::getStats().allocations == before.allocations);
+
+    /*更严格的对齐转交第一级配置器*/
+    for (std::size_t align : {16, 32, 64, 128})
+    {
+        std::vector<void *> blocks;
+
+        for (int index = 0; index < 100; ++index)
+        {
+            blocks.push_back(Alloc::allocate(align, align));
+            CHECK(isAligned(blocks.back(), align));
+        }
+
+        for (void * block : blocks) { Alloc::deallocate(block, align, align); }
+    }
+}
+
+/**
+ * @brief 总是失败的 chunk 来源，内存池只能退而向第一级配置器申请 chunk。
+*/
+struct FailingChunkSource
+{
+    static std::size_t granularity(void) { return 16; }
+    static void * allocate(std::size_t) { return nullptr; }
+    static void release(void *, std::size_t) {}
+    static std::size_t decommit(char *, std::size_t) { return 0; }
+};
+
+/*64 字节的尺寸分级，而 malloc 得到的 chunk 只保证 16 字节对齐*/
+using poolSizeClass         = SGIAllocator::__LinearSizeClass<64, 512>;
+using mallocPoolAlloc       = SGIAllocator::__DefaultAllocTemplate<false, 52, poolSizeClass, SGIAllocator::__MallocChunkSource>;
+using mallocPoolThreadAlloc = SGIAllocator::__DefaultAllocTemplate<true, 53, poolSizeClass, SGIAllocator::__MallocChunkSource>;
+using fallbackPoolAlloc     = SGIAllocator::__DefaultAllocTemplate<false, 54, poolSizeClass, FailingChunkSource>;
+
+/**
+ * @brief 尺寸分级的对齐边界大于 malloc 的对齐保证时，内存池切出的每个区块仍然按 align 对齐。
+*/
+template <typename Alloc>
+void checkPoolAlignment(void)
+{
+    std::vector<void *> blocks;
+    std::vector<std::size_t> sizes;
+
+    for (int index = 0; index < 200; ++index)
+    {
+        const std::size_t bytes = 64 * std::size_t(1 + index % 8);
+
+        blocks.push_back((index % 2 == 0) ? Alloc::allocate(bytes, 64) : Alloc::allocate(bytes));
+        sizes.push_back(bytes);
+    }
+
+    bool allAligned = true;
+    for (void * block : blocks) { allAligned = allAligned && isAligned(block, 64); }
+    CHECK(allAligned);
+
+    for (std::size_t index = 0; index < blocks.size(); ++index)
+    {
+        std::memset(blocks[index], 0x5A, sizes[index]);
+        Alloc::deallocate(blocks[index], sizes[index]);
+    }
+}
+
+template <typename Vector>
+void checkAlignedVector(Vector & __vec)
+{
+    for (long index = 0; index < 1000; ++index)
+    {
+        __vec.push_back(PaddedCounter(index));
+        CHECK(isAligned(__vec.data(), 64));
+    }
+
+    bool allAligned = true;
+    for (const PaddedCounter & counter : __vec) { allAligned = allAligned && isAligned(&counter, 64); }
+
+    CHECK(allAligned);
+    CHECK(__vec[999].value == 999);
+}
+
+template <typename Deque>
+void checkAlignedDeque(Deque & __deque)
+{
+    for (long index = 0; index < 1000; ++index)
+    {
+        __deque.push_back(PaddedCounter(index));
+        __deque.push_front(PaddedCounter(-index));
+    }
+
+    bool allAligned = true;
+    for (std::size_t index = 0; index < __deque.size(); ++index) { allAligned = allAligned && isAligned(&__deque[index], 64); }
+
+    CHECK(allAligned);
+    CHECK(__deque[0].value == -999 && __deque[1999].value == 999);
+}
+
+void checkContainers(void)
+{
+    {
+        My_Vector<PaddedCounter, sgiAlloc> vec;
+        checkAlignedVector(vec);
+
+        My_Deque<PaddedCounter, 0, sgiAlloc> deque;
+        checkAlignedDeque(deque);
+    }
+
+    {
+        monotonicArena arena;
+
+        My_Vector<PaddedCounter, arenaAlloc<PaddedCounter>> vec{arenaAlloc<PaddedCounter>(arena)};
+        checkAlignedVector(vec);
+
+        My_Deque<PaddedCounter, 0, arenaAlloc<PaddedCounter>> deque{arenaAlloc<PaddedCounter>(arena)};
+        checkAlignedDeque(deque);
+    }
+
+    {
+        My_Vector<PaddedCounter> vec;
+        checkAlignedVector(vec);
+    }
+
+    /*STL 风格的封装同样把对齐要求交给配置器*/
+    PaddedCounter * counters = SimpleAllocate::SimpleAllocator<PaddedCounter, sgiAlloc>::allocate(10);
+    CHECK(isAligned(counters, 64));
+    SimpleAllocate::SimpleAllocator<PaddedCounter, sgiAlloc>::deallocate(counters, 10);
+}
+
+void checkCppAlloc(void)
+{
+    PaddedCounter * counters = CPP_ALLOC::__allocate(16, (PaddedCounter *)nullptr);
+    CHECK(isAligned(counters, 64));
+    CPP_ALLOC::__deallocate(counters, 16);
+
+    counters = CPP_ALLOC::__allocate(3, (PaddedCounter *)nullptr);
+    CHECK(isAligned(counters, 64));
+    CPP_ALLOC::__deallocate(counters);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkMallocAlloc();
+    checkDefaultAlloc<singleAlloc>();
+    checkDefaultAlloc<threadAlloc>();
+    checkPoolAlignment<mallocPoolAlloc>();
+    checkPoolAlignment<mallocPoolThreadAlloc>();
+    checkPoolAlignment<fallbackPoolAlloc>();
+    checkContainers();
+    checkCppAlloc();
+
+    return testResult();
+}
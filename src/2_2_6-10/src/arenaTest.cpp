@@ -0,0 +1,173 @@
+#include "./include/monotonicArena.h"
+#include "../../4_2/vector/include/myVector.h"
+#include "../../4_2/list/include/list.h"
+#include "../../4_2/dequeue/include/deque.h"
+#include "../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <cstring>
+#include <string>
+
+/*
+    单调 arena 测试：
+    1. 分配满足对齐要求，连续的小分配落在同一块 chunk 上，放不下时换更大的 chunk；
+    2. Scope 回退之后再分配，得到的是同样的地址，嵌套的 Scope 只回退自己的部分；
+    3. reset() 之后只留下最大的一块 chunk，反复的 “请求” 不会让占用的内存增长；
+    4. My_Vector、MyList、My_Deque 都能以 arenaAlloc 作为分配器，在 Scope 内构建、使用、随 Scope 一起作废；
+    5. 最后比较一下在 std::allocator 和 arena 上反复构建、销毁链表的耗时。
+*/
+
+bool isAligned(const void * __ptr, std::size_t __align) { return ((std::uintptr_t)__ptr & (__align - 1)) == 0; }
+
+void checkBumpAllocation(void)
+{
+    monotonicArena arena(4096);
+
+    char * first  = (char *)arena.allocate(10, 1);
+    char * second = (char *)arena.allocate(10, 1);
+    CHECK(second == first + 10);
+
+    void * aligned = arena.allocate(8, 64);
+    CHECK(isAligned(aligned, 64));
+    CHECK(isAligned(arena.allocate(1), alignof(std::max_align_t)));
+
+    std::size_t footprint = arena.footprint();
+    CHECK(footprint == 4096);
+
+    /*放不下时换一块更大的 chunk，大于 chunk 的请求也能满足*/
+    void * large = arena.allocate(100000);
+    std::memset(large, 0x5A, 100000);
+    CHECK(arena.footprint() > footprint + 100000);
+
+    arena.release();
+    CHECK(arena.footprint() == 0);
+}
+
+void checkScope(void)
+{
+    monotonicArena arena(4096);
+
+    void * before = arena.allocate(16);
+    void * inside = nullptr;
+
+    {
+        monotonicArena::Scope scope(arena);
+
+        inside = arena.allocate(64);
+
+        {
+            monotonicArena::Scope innerScope(arena);
+            for (int index = 0; index < 1000; ++index) { arena.allocate(64); }     // 需要好几块新的 chunk
+        }
+
+        /*内层回退之后，紧接着 inside 继续分配*/
+        CHECK(arena.allocate(16) == (char *)inside + 64);
+    }
+
+    /*外层回退之后，再分配得到同样的地址，before 仍然有效*/
+    CHECK(arena.allocate(64) == inside);
+    CHECK(before != inside);
+
+    /*反复的请求不会让占用的内存增长*/
+    arena.reset();
+    for (int index = 0; index < 1000; ++index) { arena.allocate(64); }
+    std::size_t footprint = arena.footprint();
+
+    for (int request = 0; request < 100; ++request)
+    {
+        arena.reset();
+        for (int index = 0; index < 1000; ++index) { arena.allocate(64); }
+    }
+
+    CHECK(arena.footprint() == footprint);
+}
+
+void checkContainers(void)
+{
+    monotonicArena arena;
+
+    for (int request = 0; request < 10; ++request)
+    {
+        monotonicArena::Scope scope(arena);
+
+        My_Vector<int, arenaAlloc<int>> vec{arenaAlloc<int>(arena)};
+        MyList<std::string, arenaAlloc<std::string>> list{arenaAlloc<std::string>(arena)};
+        My_Deque<long, 0, arenaAlloc<long>> deque{arenaAlloc<long>(arena)};
+
+        for (int index = 0; index < 1000; ++index)
+        {
+            vec.push_back(index);
+            list.push_back(std::to_string(index));
+            deque.push_front(index);
+        }
+
+        list.sort();
+
+        CHECK(vec.size() == 1000 && vec[999] == 999);
+        CHECK(list.size() == 1000 && list.front() == "0" && list.back() == "999");
+        CHECK(deque.size() == 1000 && deque[0] == 999 && deque[999] == 0);
+        CHECK(&list.get_allocator().getArena() == &arena);
+
+        /*不同 arena 之间的移动赋值逐个移动元素，数据留在目标 arena 上*/
+        monotonicArena otherArena;
+        My_Vector<int, arenaAlloc<int>> other{arenaAlloc<int>(otherArena)};
+        other = std::move(vec);
+
+        CHECK(other.size() == 1000 && other[500] == 500);
+        CHECK(otherArena.footprint() > 0);
+    }
+}
+
+template <typename Alloc>
+double buildLists(Alloc __alloc, int __requests, int __nodes)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int request = 0; request < __requests; ++request)
+    {
+        MyList<int, Alloc> list(__alloc);
+
+        for (int index = 0; index < __nodes; ++index) { list.push_back(index); }
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    return elapsed.count() / (double(__requests) * __nodes);
+}
+
+void compareSpeed(void)
+{
+    constexpr int REQUESTS = 200;
+    constexpr int NODES    = 10000;
+
+    monotonicArena arena;
+
+    double stdLatency = buildLists(std::allocator<ListNode<int>>(), REQUESTS, NODES);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int request = 0; request < REQUESTS; ++request)
+    {
+        monotonicArena::Scope scope(arena);
+        MyList<int, arenaAlloc<int>> list{arenaAlloc<int>(arena)};
+
+        for (int index = 0; index < NODES; ++index) { list.push_back(index); }
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    printf("list build + destroy  std::allocator : %.2f ns/node, arena : %.2f ns/node\n",
+           stdLatency, elapsed.count() / (double(REQUESTS) * NODES));
+}
+
+int main(int argc, char const *argv[])
+{
+    checkBumpAllocation();
+    checkScope();
+    checkContainers();
+    compareSpeed();
+
+    return testResult();
+}
@@ -0,0 +1,159 @@
+#ifndef __CHUNK_SOURCE_H_
+#define __CHUNK_SOURCE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/*第二级配置器的 chunk 来源策略（chunk source policy）*/
+
+/*
+    内存池每次补充时要向系统要一整块 chunk，这块内存从哪里来由一个编译期策略决定，一个策略需要提供：
+
+        granularity()               chunk 大小的上调边界（2 的幂），内存池会把申请量凑足到它的倍数
+        allocate(bytes)             申请一块 chunk，失败时返回空指针（内存池随后会尝试 free-list 和第一级配置器）
+        release(ptr, bytes)         把 allocate() 得到的 chunk 整块还给系统
+        decommit(ptr, bytes)        保留地址空间，但让其中的整页不再占用物理内存，返回交还的字节数（做不到时返回 0）
+
+    这里提供三种实现：
+
+        __MallocChunkSource         SGI 原版的做法，直接 malloc / free
+        __MmapChunkSource           匿名映射（mmap / VirtualAlloc），释放时 munmap，默认使用
+        __HugePageChunkSource       按 2 MiB 对齐的大块匿名映射，并用 madvise(MADV_HUGEPAGE) 请求透明大页，
+                                    节点密集的容器（list、RB-Tree）遍历时 TLB 未命中会少得多
+*/
+
+namespace SGIAllocator
+{
+    /**
+     * @brief 系统的页大小。
+    */
+    inline std::size_t __systemPageSize(void)
+    {
+#if defined(_WIN32)
+        static const std::size_t size = []() { SYSTEM_INFO info; GetSystemInfo(&info); return (std::size_t)info.dwPageSize; }();
+#else
+        static const std::size_t size = (std::size_t)sysconf(_SC_PAGESIZE);
+#endif
+        return size;
+    }
+
+    /**
+     * @brief 保留地址空间，但让 [__ptr, __ptr + __bytes) 中的整页不再占用物理内存，下次访问时重新得到零页。
+     *
+     * @return 交还的字节数
+    */
+    inline std::size_t __decommitPages(char * __ptr, std::size_t __bytes)
+    {
+        const std::uintptr_t pageMask = (std::uintptr_t)(__systemPageSize() - 1);
+
+        char * first = (char *)(((std::uintptr_t)__ptr + pageMask) & ~pageMask);
+        char * last  = (char *)(((std::uintptr_t)__ptr + __bytes) & ~pageMask);
+
+        if (first >= last) { return 0; }
+
+#if defined(_WIN32)
+        VirtualAlloc(first, last - first, MEM_RESET, PAGE_READWRITE);
+#else
+        madvise(first, last - first, MADV_DONTNEED);
+#endif
+        return last - first;
+    }
+
+    /**
+     * @brief SGI 原版的 chunk 来源：malloc / free，不做任何页级别的处理。
+    */
+    struct __MallocChunkSource
+    {
+        static std::size_t granularity(void) { return 16; }
+
+        static void * allocate(std::size_t __bytes) { return std::malloc(__bytes); }
+
+        static void release(void * __ptr, std::size_t) { std::free(__ptr); }
+
+        /*malloc 得到的内存可能与别的分配共用页，不做归还*/
+        static std::size_t decommit(char *, std::size_t) { return 0; }
+    };
+
+    /**
+     * @brief 直接向系统匿名映射 chunk，释放时解除映射，真正把内存还给系统。
+    */
+    struct __MmapChunkSource
+    {
+        static std::size_t granularity(void) { return __systemPageSize(); }
+
+        static void * allocate(std::size_t __bytes)
+        {
+#if defined(_WIN32)
+            return VirtualAlloc(nullptr, __bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+            void * result = mmap(nullptr, __bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            return (result == MAP_FAILED) ? nullptr : result;
+#endif
+        }
+
+        static void release(void * __ptr, std::size_t __bytes)
+        {
+#if defined(_WIN32)
+            (void)__bytes;
+            VirtualFree(__ptr, 0, MEM_RELEASE);
+#else
+            munmap(__ptr, __bytes);
+#endif
+        }
+
+        static std::size_t decommit(char * __ptr, std::size_t __bytes) { return __decommitPages(__ptr, __bytes); }
+    };
+
+    /**
+     * @brief 按 2 MiB 对齐、以 2 MiB 为单位映射 chunk，并请求透明大页（Linux 的 MADV_HUGEPAGE）。
+     *
+     * @brief - 一个 2 MiB 的大页只占一个 TLB 表项，同样的 TLB 能覆盖的节点数是 4 KiB 页的 512 倍。
+     *          映射本身是惰性的，没有被切分出去的部分并不会立即占用物理内存。
+     *
+     * @brief - 没有 MADV_HUGEPAGE 的平台上退化为对齐的普通映射；Windows 的大页需要额外的权限，这里也退化为普通映射。
+    */
+    struct __HugePageChunkSource
+    {
+        enum {__HUGE_PAGE_SIZE = 2 * 1024 * 1024};
+
+        static std::size_t granularity(void) { return __HUGE_PAGE_SIZE; }
+
+        static void * allocate(std::size_t __bytes)
+        {
+#if defined(_WIN32)
+            return VirtualAlloc(nullptr, __bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+            /*多映射一个大页的长度，再把首尾不对齐的部分解除映射，剩下的就是对齐的区域*/
+            const std::size_t mappedBytes = __bytes + __HUGE_PAGE_SIZE;
+            char * mapped = (char *)mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if ((void *)mapped == MAP_FAILED) { return nullptr; }
+
+            char * aligned = (char *)(((std::uintptr_t)mapped + __HUGE_PAGE_SIZE - 1) & ~(std::uintptr_t)(__HUGE_PAGE_SIZE - 1));
+
+            if (aligned != mapped) { munmap(mapped, aligned - mapped); }
+            if (aligned + __bytes != mapped + mappedBytes) { munmap(aligned + __bytes, (mapped + mappedBytes) - (aligned + __bytes)); }
+
+#if defined(MADV_HUGEPAGE)
+            madvise(aligned, __bytes, MADV_HUGEPAGE);
+#endif
+            return aligned;
+#endif
+        }
+
+        static void release(void * __ptr, std::size_t __bytes) { __MmapChunkSource::release(__ptr, __bytes); }
+
+        static std::size_t decommit(char * __ptr, std::size_t __bytes) { return __decommitPages(__ptr, __bytes); }
+    };
+}
+
+#endif // __CHUNK_SOURCE_H_
@@ -1,9 +1,20 @@
 #ifndef __DEFAULT_ALLOC_TEMPLATE_H_
 #define __DEFAULT_ALLOC_TEMPLATE_H_
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <type_traits>
+#include <mutex>
+#include <thread>
 #include "./mallocAllocTemplate.h"
+#include "./sizeClassPolicy.h"
+#include "./chunkSource.h"
 
 #define SGI_METHODS true
 #define MY_METHODS false
@@ -19,6 +30,27 @@
     并维护 16 个 free-list，分别对应 8，16，24，32，40，48，56，64，72，80，88，96，104，112，120，128 字节的小额区块。
 
     由于使用联合体（union）的原因，维护链表不会因为需要额外的指针而浪费内存。
+
+    上面的 8 和 128 只是默认的尺寸分级策略 __SGISizeClass，对齐边界、小型区块上限和 free-list 的间距
+    都可以通过模板参数 SizeClass 在编译期替换（见 `./sizeClassPolicy.h`），比如 16 字节对齐、几何分级到 4 KiB。
+
+    多线程模式（Threads = true）下，每个线程持有一份自己的 16 条 free-list 缓存（thread_local），
+    分配与回收都只操作本线程的缓存，无需加锁；缓存耗尽时才持有中央锁，从共享的 free-list 和内存池中成批取出节点，
+    缓存过长时也成批归还给中央，这样中央的开销被摊薄到每 __THREAD_BATCH_NODES 次操作一次。
+
+    中央的 16 条 free-list 在多线程模式下是无锁的带标签指针（tagged pointer）栈，栈中的每个元素是一整串节点：
+    归还时整串节点一次 CAS 压栈，取用时一次 CAS 摘下一整串，只有从内存池切新节点（chunkAlloc()）时才需要加锁。
+    串首节点要同时记下串内的后继和栈中的下一串，因此多线程模式下最小的区块是 16 字节（两个指针）。
+
+    SGI 原版从不把内存池的内存还给系统，heapSize 只增不减，峰值过后常驻内存也一直停留在峰值。
+    这里内存池的每一块 chunk 都直接向系统映射（mmap / VirtualAlloc，可以通过模板参数 ChunkSource 替换，
+    见 `./chunkSource.h`，比如改用透明大页），并记录在 chunkTable 中，
+    trim() / releaseUnused() 会清点 free-list，把所有区块都空闲的 chunk 整块归还给系统（munmap / VirtualFree），
+    并用 madvise(MADV_DONTNEED) 让内存池剩余空间中的整页不再占用物理内存；
+    多线程模式下还可以启动一个后台线程（startDecay()），定期归还持续空闲了若干轮的 chunk。
+
+    getStats() / printStats() 报告每条 free-list 的申请、释放、补充次数和存活区块数，以及内存池的整体占用，
+    用来判断内存池对某种负载究竟是帮了忙还是帮了倒忙；计数可以用 __ALLOC_STATS_ 宏在编译期关掉。
 */
 
 namespace SGIAllocator
@@ -28,25 +60,74 @@ enum {__ALIGN = 8};                             // 小型区块的上调边界
 enum {__MAX_BYTES = 128};                       // 小型区块的上限
 enum {__NFPREELISTS = __MAX_BYTES / __ALIGN};   // free-list 数量
 
+typedef __LinearSizeClass<__ALIGN, __MAX_BYTES> __SGISizeClass;     // SGI 原版的尺寸分级
+
+enum {__THREAD_BATCH_NODES = 32};                           // 线程缓存与中央 free-list 之间一次搬运的节点数
+enum {__THREAD_CACHE_LIMIT = 2 * __THREAD_BATCH_NODES};     // 线程缓存单条 free-list 的节点上限
+
+/**
+ * @brief 第二级配置器中一条 free-list（一个尺寸级别）的统计信息。
+*/
+struct __SizeClassStats
+{
+    std::size_t blockSize;          // 区块大小
+    std::size_t allocations;        // 申请次数
+    std::size_t deallocations;      // 释放次数
+    std::size_t refills;            // free-list 为空、需要补充的次数
+    std::size_t liveBlocks;         // 仍在客端手中的区块数
+    std::size_t freeBlocks;         // 空闲的区块数（free-list 中的，以及多线程模式下各线程缓存中的）
+    std::size_t freeListBytes;      // 空闲区块占用的字节数
+};
+
 /**
- * @tparam Threads  用于多线程，当前不讨论这种情况
- * @tparam Inst     用于后面的具体化
+ * @brief 第二级配置器的统计信息（见 __DefaultAllocTemplate::getStats()）。
+ *
+ * @tparam ClassCount   free-list 的数量
 */
-template <bool Threads, int Inst>
+template <std::size_t ClassCount>
+struct __DefaultAllocStats
+{
+    std::array<__SizeClassStats, ClassCount> sizeClasses;
+
+    std::size_t freeListBytes;      // 所有 free-list 中空闲区块的字节数
+    std::size_t poolRemainder;      // 内存池剩余空间（endFreeList - startFreeList）
+    std::size_t heapSize;           // 内存池向系统申请的总字节数
+    std::size_t chunkCount;         // 内存池持有的 chunk 数
+    std::size_t largeAllocations;   // 超过小型区块上限、转交第一级配置器的次数
+};
+
+/**
+ * @tparam Threads      是否启用多线程模式（每个线程持有自己的 free-list 缓存，批量向中央 free-list 和内存池取还节点）
+ * @tparam Inst         用于后面的具体化
+ * @tparam SizeClass    尺寸分级策略，默认为 SGI 原版的 8 字节对齐、16 条 free-list、上限 128 字节
+ * @tparam ChunkSource  内存池 chunk 的来源，默认为匿名映射（__MmapChunkSource）
+*/
+template <bool Threads, int Inst, typename SizeClass = __SGISizeClass, typename ChunkSource = __MmapChunkSource>
 class __DefaultAllocTemplate
 {
+    static_assert(__isValidSizeClass<SizeClass>(), "invalid size class policy");
+
     private:
+        /*类内的这三个常量遮蔽了命名空间里的同名枚举，改由尺寸分级策略决定*/
+        static constexpr std::size_t __ALIGN       = SizeClass::align;          // 小型区块的上调边界
+        static constexpr std::size_t __MAX_BYTES   = SizeClass::maxBytes;       // 小型区块的上限
+        static constexpr std::size_t __NFPREELISTS = SizeClass::classCount;     // free-list 数量
+
+        /*编译期生成的两张表：每条 free-list 的区块大小，以及 “字节数 / __ALIGN” 到 free-list 下标的映射*/
+        static constexpr std::array<std::size_t, __NFPREELISTS> classSizeTable = __makeClassSizeTable<SizeClass>();
+        static constexpr auto classIndexTable = __makeClassIndexTable<SizeClass>();
+
         /**
-         * @brief           该函数将内存对齐至 8 的倍数
+         * @brief           该函数将内存对齐至 __ALIGN 的倍数
          * 
          * @param __bytes   传入的字节数
          * 
          * @return          对齐后的字节数
         */
-        static std::size_t roundUp(std::size_t __bytes) 
+        static std::size_t alignUp(std::size_t __bytes) 
         { 
             /*
-                这条语句拆解分析如下:
+                这条语句拆解分析如下（以 __ALIGN = 8 为例）:
                 1. ((__bytes) + __ALIGN - 1)    在原始字节数的基础上加上 7，目的是为了离对齐边界更近一些
                 2. ~(__ALIGN - 1)               取反 0x00000007 的所有位 为 0xFFFFFFF8
                 3. 最后将 （1）的值和（2）的值进行与运算，得到比这个数对齐后的字节数（如 119 对齐到 120，98 对齐到 104）
@@ -54,16 +135,145 @@ class __DefaultAllocTemplate
             return ((__bytes) + __ALIGN - 1) & ~(__ALIGN - 1); 
         }
 
+        /**
+         * @brief           该函数将小型区块的字节数上调至所属 free-list 的区块大小（查表），
+         *                  在 SGI 原版的线性分级下与 alignUp() 的结果相同。
+         * 
+         * @param __bytes   传入的字节数，不得大于 __MAX_BYTES
+         * 
+         * @return          上调后的字节数
+        */
+        static std::size_t roundUp(std::size_t __bytes) { return classSizeTable[freeListIndex(__bytes)]; }
+
     private:
+        /**
+         * @brief 一次 allocate(__bytes)（__bytes 不大于 __MAX_BYTES）实际拿到的区块大小，
+         *        多线程模式下小于 BatchHead 的请求会被抬高到 BatchHead 的大小。
+        */
+        static std::size_t blockSize(std::size_t __bytes)
+        {
+            if constexpr (Threads) { if (__bytes < sizeof(BatchHead)) { __bytes = sizeof(BatchHead); } }
+
+            return roundUp(__bytes);
+        }
+
         union Obj           // free-list 节点的构成
         {
             union Obj * freeListLink;       // 指向下一个节点的指针
             char clientData[1];             // 指向一个实际区块的指针
         };
-    
+
+        /*
+            内存池的锁（仿照 SGI 的 _Lock），
+            构造时加锁，析构时解锁，单线程模式下什么也不做。
+        */
+        class Lock
+        {
+            public:
+                Lock()  { if constexpr (Threads) { centralMutex.lock(); } }
+                ~Lock() { if constexpr (Threads) { centralMutex.unlock(); } }
+
+                Lock(const Lock &) = delete;
+                Lock & operator=(const Lock &) = delete;
+        };
+
+        /*
+            多线程模式下每个线程私有的 free-list 缓存，
+            nodeCount 记录每条链表当前缓存的节点数，用于判断何时成批归还给中央。
+        */
+        struct ThreadCache
+        {
+            Obj * freeList[__NFPREELISTS];
+            std::size_t nodeCount[__NFPREELISTS];
+
+            /*
+                尚未汇总到全局计数的释放次数，与中央交换节点时才汇总，避免每次操作都去写共享的计数。
+                申请次数不单独计数，而是由上次汇总时的节点数 syncedCount 推算：
+                申请次数 = syncedCount + 释放次数 - 当前节点数。
+            */
+            std::size_t pendingFrees[__NFPREELISTS];
+            std::size_t syncedCount[__NFPREELISTS];
+        };
+
+        /*
+            多线程模式下中央无锁栈中的一个元素（一串节点）的串首：
+            第一个字与 Obj 相同，是串内的后继；第二个字指向栈中的下一串。
+        */
+        struct BatchHead
+        {
+            Obj * freeListLink;
+            BatchHead * nextBatch;
+        };
+
+        /*
+            线程退出时把该线程缓存的节点全部归还给中央 free-list，避免节点随线程一起丢失。
+        */
+        struct ThreadCacheReaper
+        {
+            ~ThreadCacheReaper() { flushThreadCache(); }
+        };
+
+        /*
+            内存池向系统申请的一块 chunk 的记录，chunkTable 按 address 升序排列，便于二分查找某个节点属于哪一块 chunk。
+        */
+        struct ChunkRecord
+        {
+            char * address;             // chunk 的起始地址
+            std::size_t bytes;          // chunk 的大小
+            std::size_t wastedBytes;    // 无法编入 free-list、被舍弃的零头
+            std::size_t freeBytes;      // 清点时统计出的空闲字节数（free-list 中的节点 + 内存池剩余空间 + 零头）
+            std::size_t idleScans;      // 连续多少次清点都是完全空闲的
+            bool fromMalloc;            // ChunkSource 失败时退而向第一级配置器申请的 chunk，要还给第一级配置器
+        };
+
+        /*
+            多线程模式下的后台衰减线程：每隔 interval 清点一次 free-list，
+            把连续 idleScans 次清点都完全空闲的 chunk 还给系统，避免刚空闲下来就归还、马上又要重新映射的抖动。
+        */
+        class DecayWorker
+        {
+            public:
+                void start(std::chrono::milliseconds __interval, std::size_t __idleScans)
+                {
+                    stop();
+
+                    stopping = false;
+                    worker = std::thread([this, __interval, __idleScans]()
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+
+                        while (!wakeUp.wait_for(guard, __interval, [this]() { return stopping; }))
+                        {
+                            Lock poolLock;
+                            releaseFreeChunks(__idleScans);
+                        }
+                    });
+                }
+
+                void stop(void)
+                {
+                    if (!worker.joinable()) { return; }
+
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        stopping = true;
+                    }
+                    wakeUp.notify_all();
+                    worker.join();
+                }
+
+                ~DecayWorker() { stop(); }
+
+            private:
+                std::mutex lock;
+                std::condition_variable wakeUp;
+                std::thread worker;
+                bool stopping = false;
+        };
+
     private:
         /*
-            16 个持有不同大小内存的自由链表，
+            __NFPREELISTS 个（默认 16 个）持有不同大小内存的自由链表，
             考虑到多线程环境，使用 volatile 关键字避免编译器做出不正确的优化。
         */
         static Obj * volatile freeList[__NFPREELISTS];
@@ -77,22 +287,27 @@ class __DefaultAllocTemplate
         */
         static std::size_t freeListIndex(std::size_t __bytes) 
         { 
-#if SGI_METHODS
             /*
-                这条语句分析拆解如下：
+                SGI 原版的线性分级可以直接算出下标：
                 1. (((__bytes) + __ALIGN - 1)       将传入的字节数和 7 相加，使其更接近对齐后的内存
                 2. ... / __ALIGN                    计算（1）得出的数据是 8 的 n 倍（小数点会被截断）
                 3. ... - 1                          由于下标从 0 开始，因此需要 - 1
-            */
-            return (((__bytes) + __ALIGN - 1) / __ALIGN - 1); 
-#elif MY_METHODS    
 
-            /**
-             * 而我的实现会直截了当一些，
-             * 直接调用 roundUp() 对齐内存，然后除以 8 再 - 1 得到下标（显然，在频繁调用下，没有 SGI 实现的有效率）
+                分级策略可替换之后，（2）得到的 “第几个对齐单位” 改为去查编译期生成的 classIndexTable，
+                __ALIGN 是 2 的幂，除法会被编译成移位，查表本身只是一次访存。
             */
-            return roundUp(__bytes) / __ALIGN - 1;
-#endif
+            return classIndexTable[((__bytes) + __ALIGN - 1) / __ALIGN];
+        }
+
+        /**
+         * @brief           找到区块大小不超过 __bytes 的最大一条 free-list，
+         *                  用于把内存池中的零头编入 free-list（零头不一定恰好是某一级的大小）。
+        */
+        static std::size_t fragmentListIndex(std::size_t __bytes)
+        {
+            std::size_t listIndex = freeListIndex(__bytes);
+
+            return (classSizeTable[listIndex] > __bytes) ? listIndex - 1 : listIndex;
         }
 
         /**
@@ -116,6 +331,9 @@ class __DefaultAllocTemplate
             */
             char * chunk = (char *)chunkAlloc(__n, defaultNodeCount);
 
+            addCount(refillCount[freeListIndex(__n)], 1);
+            addCount(carvedCount[freeListIndex(__n)], defaultNodeCount);
+
             /*填充空间前的目标链表地址*/
             Obj * volatile *myFreeList;
             Obj * result;
@@ -217,36 +435,77 @@ class __DefaultAllocTemplate
             // 内存池的剩余空间连一个区块的大小都无法提供
             else
             {
-                // 需要往内存池中填充的字节数 = 2 * 需要为 free-list 分配的总字节数 + (堆空间大小 / 2 ^ 4 再对齐至 8 的倍数)
-                std::size_t bytesToGet = 2 * totalBytes + roundUp(heapSize >> 4);
+                // 需要往内存池中填充的字节数 = 2 * 需要为 free-list 分配的总字节数 + (堆空间大小 / 2 ^ 4 再对齐至 __ALIGN 的倍数)
+                std::size_t bytesToGet = 2 * totalBytes + alignUp(heapSize >> 4);
 
                 // 让内存池中的零头空间还有利用价值
                 if (remainingBytes > 0)
                 {
-                    // 寻找合适的 free-list
-                    Obj * volatile * myFreeList = freeList + freeListIndex(remainingBytes);
+                    // 多线程模式下编入无锁的中央 free-list（放不下串首的零头直接舍弃）
+                    if constexpr (Threads)
+                    {
+                        if (remainingBytes >= sizeof(BatchHead))
+                        {
+                            addCount(carvedCount[fragmentListIndex(remainingBytes)], 1);
+                            pushCentralChain(fragmentListIndex(remainingBytes), (Obj *)startFreeList, (Obj *)startFreeList);
+                        }
+                        else if (ChunkRecord * chunk = findChunk(startFreeList))
+                        {
+                            chunk->wastedBytes += remainingBytes;
+                        }
+                    }
+                    else
+                    {
+                        // 寻找合适的 free-list
+                        Obj * volatile * myFreeList = freeList + fragmentListIndex(remainingBytes);
 
-                    // 调整 free-list 将内存池中残存的空间编入
-                    ((Obj *)startFreeList)->freeListLink = *myFreeList;
-                    *myFreeList = (Obj *)startFreeList;
+                        // 调整 free-list 将内存池中残存的空间编入
+                        ((Obj *)startFreeList)->freeListLink = *myFreeList;
+                        *myFreeList = (Obj *)startFreeList;
+
+                        addCount(carvedCount[fragmentListIndex(remainingBytes)], 1);
+                    }
                 }
 
-                // 配置 heap 空间，来补充内存池
-                startFreeList = (char *)malloc(bytesToGet);
+                // 从 ChunkSource 取一块新的 chunk 来补充内存池（凑足它的粒度，多出来的空间也归内存池使用）
+                bytesToGet = (bytesToGet + ChunkSource::granularity() - 1) & ~(ChunkSource::granularity() - 1);
+                startFreeList = (char *)ChunkSource::allocate(bytesToGet);
+
+                bool fromMalloc = false;
 
                 if (startFreeList == nullptr)
                 {
-                    int i;
+                    std::size_t i;
                     Obj * volatile * myFreeList, * ptr;
 
-                    for (i = __size; i <= __MAX_BYTES; i += __ALIGN)
+                    // 从 __size 所属的那一级开始，逐级向上寻找还有空闲区块的 free-list
+                    for (std::size_t listIndex = freeListIndex(__size); listIndex < __NFPREELISTS; ++listIndex)
                     {
-                        myFreeList = freeList + freeListIndex(i);
-                        ptr = *myFreeList;
+                        i = classSizeTable[listIndex];
+
+                        if constexpr (Threads)
+                        {
+                            int popCount;
+                            ptr = popCentralChain(listIndex, popCount);
+
+                            // 只拿走串首一个节点，其余的节点压回去
+                            if (ptr != nullptr && ptr->freeListLink != nullptr)
+                            {
+                                Obj * tail = ptr->freeListLink;
+                                while (tail->freeListLink != nullptr) { tail = tail->freeListLink; }
+                                pushCentralChain(listIndex, ptr->freeListLink, tail);
+                            }
+                        }
+                        else
+                        {
+                            myFreeList = freeList + listIndex;
+                            ptr = *myFreeList;
+                        }
 
                         if (ptr != nullptr)
                         {
-                            *myFreeList = ptr->freeListLink;
+                            if constexpr (!Threads) { *myFreeList = ptr->freeListLink; }
+                            addCount(carvedCount[listIndex], std::size_t(-1));     // 这个区块退回了内存池
                             startFreeList = (char *)ptr;
                             endFreeList = startFreeList + i;
 
@@ -255,9 +514,19 @@ class __DefaultAllocTemplate
                     }
                     endFreeList = nullptr;
                     startFreeList = (char *)mallocAlloc::allocate(bytesToGet);
+                    fromMalloc = true;
                 }
+                /**
+                 * 区块的对齐全靠 chunk 的起始地址：__MallocChunkSource 与第一级配置器给出的 chunk 只保证 malloc 的对齐，
+                 * 对齐边界更大的尺寸分级（如 __LinearSizeClass<64, 512>）要跳过开头不满 __ALIGN 对齐的部分，
+                 * 结尾凑不满 __ALIGN 的部分同样不用，两者都作为零头记在这块 chunk 上。
+                */
+                char * chunkAddress = startFreeList;
+                startFreeList = (char *)(((std::uintptr_t)chunkAddress + __ALIGN - 1) & ~(std::uintptr_t)(__ALIGN - 1));
+                endFreeList   = startFreeList + ((chunkAddress + bytesToGet - startFreeList) & ~(__ALIGN - 1));
+
+                recordChunk(chunkAddress, bytesToGet, fromMalloc, bytesToGet - std::size_t(endFreeList - startFreeList));
                 heapSize += bytesToGet;
-                endFreeList = startFreeList + bytesToGet;
 
                 return chunkAlloc(__size, __nodeCount);
             }
@@ -267,7 +536,525 @@ class __DefaultAllocTemplate
         static char * endFreeList;
         static std::size_t heapSize;
 
+        static ChunkRecord * chunkTable;        // 内存池向系统申请的所有 chunk（按地址升序）
+        static std::size_t chunkCount;
+        static std::size_t chunkCapacity;
+
+        /*
+            统计计数，多线程模式下是原子变量（但只在与中央交换节点时才写入）。
+            carvedCount 是每一级已经切出、尚未还给系统的区块总数，空闲区块数 = carvedCount - 存活区块数。
+        */
+        using Counter = typename std::conditional<Threads, std::atomic<std::size_t>, std::size_t>::type;
+
+        static Counter allocCount[__NFPREELISTS];
+        static Counter freeCount[__NFPREELISTS];
+        static Counter refillCount[__NFPREELISTS];
+        static Counter carvedCount[__NFPREELISTS];
+        static Counter largeAllocCount;
+
+        /**
+         * @brief 计数器加上 __n（__n 可以是 “负数” 的补码），关闭 __ALLOC_STATS_ 时什么也不做。
+        */
+        static void addCount(Counter & __counter, std::size_t __n)
+        {
+            if constexpr (__ALLOC_STATS_)
+            {
+                if constexpr (Threads) { __counter.fetch_add(__n, std::memory_order_relaxed); }
+                else { __counter += __n; }
+            }
+        }
+
+        static std::size_t loadCount(const Counter & __counter)
+        {
+            if constexpr (Threads) { return __counter.load(std::memory_order_relaxed); }
+            else { return __counter; }
+        }
+
+        /**
+         * @brief 多线程模式下，把本线程第 __listIndex 级尚未汇总的申请、释放次数写入全局计数，
+         *        必须在线程缓存与中央交换节点（改变 nodeCount）之前调用，交换之后再用 syncPendingCounts() 记下新的节点数。
+        */
+        static void flushPendingCounts(std::size_t __listIndex)
+        {
+            if constexpr (Threads && __ALLOC_STATS_)
+            {
+                const std::size_t frees  = threadCache.pendingFrees[__listIndex];
+                const std::size_t allocs = threadCache.syncedCount[__listIndex] + frees - threadCache.nodeCount[__listIndex];
+
+                addCount(allocCount[__listIndex], allocs);
+                addCount(freeCount[__listIndex], frees);
+
+                threadCache.pendingFrees[__listIndex] = 0;
+                threadCache.syncedCount[__listIndex]  = threadCache.nodeCount[__listIndex];
+            }
+        }
+
+        /**
+         * @brief 线程缓存与中央交换节点之后，记下第 __listIndex 级新的节点数（另有 __handedOut 个节点已直接交给客端）。
+        */
+        static void syncPendingCounts(std::size_t __listIndex, std::size_t __handedOut = 0)
+        {
+            if constexpr (Threads && __ALLOC_STATS_)
+            {
+                threadCache.syncedCount[__listIndex] = threadCache.nodeCount[__listIndex] + __handedOut;
+            }
+        }
+
+        /**
+         * @brief 在 chunkTable 中登记一块新的 chunk（保持按地址升序），__wastedBytes 是为了对齐而舍弃的首尾零头。
+        */
+        static void recordChunk(char * __address, std::size_t __bytes, bool __fromMalloc, std::size_t __wastedBytes)
+        {
+            if (chunkCount == chunkCapacity)
+            {
+                std::size_t newCapacity = (chunkCapacity == 0) ? 16 : 2 * chunkCapacity;
+
+                chunkTable = (ChunkRecord *)mallocAlloc::reallocate(chunkTable, chunkCapacity * sizeof(ChunkRecord),
+                                                                    newCapacity * sizeof(ChunkRecord));
+                chunkCapacity = newCapacity;
+            }
+
+            std::size_t position = chunkCount;
+            while (position > 0 && chunkTable[position - 1].address > __address)
+            {
+                chunkTable[position] = chunkTable[position - 1];
+                --position;
+            }
+
+            chunkTable[position] = ChunkRecord{__address, __bytes, __wastedBytes, 0, 0, __fromMalloc};
+            ++chunkCount;
+        }
+
+        /**
+         * @brief 二分查找地址 __ptr 所在的 chunk，找不到时返回空指针。
+        */
+        static ChunkRecord * findChunk(const char * __ptr)
+        {
+            std::size_t low = 0, high = chunkCount;
+
+            // 找到第一个起始地址大于 __ptr 的 chunk，它的前一个就是候选
+            while (low < high)
+            {
+                std::size_t middle = low + (high - low) / 2;
+
+                if (chunkTable[middle].address <= __ptr) { low = middle + 1; }
+                else { high = middle; }
+            }
+
+            if (low == 0) { return nullptr; }
+
+            ChunkRecord * chunk = chunkTable + (low - 1);
+
+            return (__ptr < chunk->address + chunk->bytes) ? chunk : nullptr;
+        }
+
+        static std::mutex centralMutex;                         // 保护内存池（startFreeList，endFreeList，heapSize）
+        static thread_local ThreadCache threadCache;            // 本线程的 free-list 缓存
+        static thread_local ThreadCacheReaper threadCacheReaper;
+
+        /*
+            带标签的指针：一个 64 位字，低位存放栈顶节点的地址，高位存放一个每次成功 CAS 都会自增的标签。
+
+            只比较指针的 CAS 会遇到 ABA 问题：线程 A 读到栈顶 X 和它的后继 Y 之后被挂起，
+            其他线程弹出 X、Y，又把 X 压了回来，此时 A 的 CAS 仍然成功，却把早已被别人拿走的 Y 设成了栈顶。
+            加上标签之后，栈顶只要被修改过，哪怕指针相同，标签也已经不同，A 的 CAS 必然失败并重试。
+
+            64 位平台上用户空间地址只占低 48 位，剩下的 16 位用作标签；32 位平台上指针和标签各占 32 位。
+        */
+        using TaggedPointer = std::uint64_t;
+
+        static constexpr unsigned int  TAG_SHIFT    = (sizeof(void *) == 8) ? 48U : 32U;
+        static constexpr TaggedPointer POINTER_MASK = (TaggedPointer(1) << TAG_SHIFT) - 1;
+
+        static Obj * pointerOf(TaggedPointer __word) { return (Obj *)(std::uintptr_t)(__word & POINTER_MASK); }
+
+        /**
+         * @brief 生成以 __ptr 为栈顶、标签比 __oldWord 大 1 的新字。
+        */
+        static TaggedPointer makeTagged(Obj * __ptr, TaggedPointer __oldWord)
+        {
+            return (((__oldWord >> TAG_SHIFT) + 1) << TAG_SHIFT) | (TaggedPointer)(std::uintptr_t)__ptr;
+        }
+
+        /*多线程模式下的 16 条中央 free-list（无锁栈的栈顶）*/
+        static std::atomic<TaggedPointer> centralFreeList[__NFPREELISTS];
+
+        /*
+            正在执行 popCentralChain() 的线程数。
+            弹栈时会读取栈顶串首的 nextBatch，releaseFreeChunks() 摘走所有中央 free-list 之后，
+            要等这个计数归零才能把 chunk 还给系统，否则迟到的弹栈线程可能去读一块已经解除映射的内存。
+        */
+        static std::atomic<std::size_t> activePoppers;
+
+        /**
+         * @brief 把以 __head 开头、__tail 结尾的一整串节点作为一个元素压入第 __listIndex 号中央 free-list。
+        */
+        static void pushCentralChain(std::size_t __listIndex, Obj * __head, Obj * __tail)
+        {
+            std::atomic<TaggedPointer> & top = centralFreeList[__listIndex];
+            BatchHead * batch = (BatchHead *)__head;
+            TaggedPointer oldTop = top.load(std::memory_order_relaxed);
+
+            __tail->freeListLink = nullptr;
+
+            do
+            {
+                /*popCentralChain() 可能同时在原子地读这个字段，写入也必须是原子的，否则就是数据竞争*/
+                std::atomic_ref<BatchHead *>(batch->nextBatch).store((BatchHead *)pointerOf(oldTop), std::memory_order_relaxed);
+            } 
+            while (!top.compare_exchange_weak(oldTop, makeTagged(__head, oldTop), 
+                                              std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /**
+         * @brief 读取栈顶串首的 nextBatch，供 popCentralChain() 的 CAS 使用。
+         * 
+         * @brief - 串首可能已经被别的线程弹出并写入了用户数据，读到的值此时已经过时，
+         *          但随后的 CAS 会因为标签不符而失败并丢弃它。这是无锁栈固有的推测性读取，
+         *          因此只有这一处读取不接受 ThreadSanitizer 的检测（不内联，免得把检测范围扩大到调用者）。
+        */
+        __attribute__((no_sanitize("thread"), noinline))
+        static BatchHead * speculativeNextBatch(BatchHead * __batch)
+        {
+            /*直接用内建的原子读：std::atomic_ref::load 是另一个函数，仍然会被检测*/
+            return __atomic_load_n(&__batch->nextBatch, __ATOMIC_RELAXED);
+        }
+
+        /**
+         * @brief 从第 __listIndex 号中央 free-list 摘下栈顶的一整串节点。
+         * 
+         * @brief - 弹栈时读到的串首可能正被别的线程拿去使用，nextBatch 可能已是用户数据，
+         *          因此用原子读避免读出撕裂的值；读到的值若已过时，随后的 CAS 会因为标签不符而失败。
+         *          串首一定位于内存池之内，读它总是安全的；串内的其余节点只在 CAS 成功、归自己所有之后才会访问。
+         * 
+         * @param __nodeCount   摘下的节点数
+         * 
+         * @return              以空指针结尾的一串节点，中央 free-list 为空时返回空指针
+        */
+        static Obj * popCentralChain(std::size_t __listIndex, int & __nodeCount)
+        {
+            std::atomic<TaggedPointer> & top = centralFreeList[__listIndex];
+            BatchHead * batch;
+
+            activePoppers.fetch_add(1);
+
+            TaggedPointer oldTop = top.load();
+
+            do
+            {
+                batch = (BatchHead *)pointerOf(oldTop);
+
+                if (batch == nullptr) { break; }
+            }
+            while (!top.compare_exchange_weak(oldTop,
+                                              makeTagged((Obj *)speculativeNextBatch(batch), oldTop),
+                                              std::memory_order_acquire, std::memory_order_acquire));
+
+            activePoppers.fetch_sub(1, std::memory_order_release);
+
+            if (batch == nullptr) { __nodeCount = 0; return nullptr; }
+
+            __nodeCount = 1;
+            for (Obj * node = batch->freeListLink; node != nullptr; node = node->freeListLink) { ++__nodeCount; }
+
+            return (Obj *)batch;
+        }
+
+        /**
+         * @brief               将 chunkAlloc() 返回的一片连续内存切成 __nodeCount 个大小为 __n 的节点，
+         *                      串成一张以空指针结尾的单向链表。
+         * 
+         * @return              链表的头节点
+        */
+        static Obj * linkChunk(char * __chunk, std::size_t __n, int __nodeCount)
+        {
+            Obj * currentObj = (Obj *)__chunk;
+
+            for (int listIndex = 1; listIndex < __nodeCount; ++listIndex)
+            {
+                currentObj->freeListLink = (Obj *)((char *)currentObj + __n);
+                currentObj = currentObj->freeListLink;
+            }
+            currentObj->freeListLink = nullptr;
+
+            return (Obj *)__chunk;
+        }
+
+        /**
+         * @brief 多线程模式下，线程缓存中的某条 free-list 耗尽时调用。
+         * 
+         * @brief - 先以无锁的方式从中央 free-list 摘下至多 __THREAD_BATCH_NODES 个节点，
+         *          中央 free-list 也为空时才持有内存池的锁，向 chunkAlloc() 要一整批新节点。
+         * 
+         * @param __n   要分配的单个节点的大小，默认 __n 已经经过对齐。
+         * 
+         * @return 一个指向了大小为 __n 的内存的指针，其余节点挂入本线程的缓存。
+        */
+        static void * reFillThreadCache(std::size_t __n)
+        {
+            const std::size_t listIndex = freeListIndex(__n);
+            int nodeCount = 0;
+
+            /*从中央 free-list 摘下一串节点*/
+            Obj * chain = popCentralChain(listIndex, nodeCount);
+
+            /*中央 free-list 也空了，向内存池要一整批*/
+            if (chain == nullptr)
+            {
+                Lock poolLock;
+
+                /*chunkAlloc() 可能会减少 nodeCount，因此必须先取回内存再串链*/
+                nodeCount = __THREAD_BATCH_NODES;
+                char * chunk = (char *)chunkAlloc(__n, nodeCount);
+                chain = linkChunk(chunk, __n, nodeCount);
+
+                addCount(carvedCount[listIndex], nodeCount);
+            }
+
+            addCount(refillCount[listIndex], 1);
+            flushPendingCounts(listIndex);
+
+            /*确保线程退出时缓存能被归还*/
+            (void)&threadCacheReaper;
+
+            threadCache.freeList[listIndex]  = chain->freeListLink;
+            threadCache.nodeCount[listIndex] = nodeCount - 1;
+
+            syncPendingCounts(listIndex, 1);
+
+            return chain;
+        }
+
+        /**
+         * @brief 从本线程缓存的第 __listIndex 号 free-list 中摘下 __nodeCount 个节点，
+         *        一次 CAS 整串压回中央 free-list。
+        */
+        static void releaseThreadCache(std::size_t __listIndex, std::size_t __nodeCount)
+        {
+            Obj * chain = threadCache.freeList[__listIndex];
+
+            flushPendingCounts(__listIndex);
+
+            if (chain == nullptr || __nodeCount == 0) { return; }
+
+            Obj * tail = chain;
+            std::size_t released = 1;
+            for (; released < __nodeCount && tail->freeListLink != nullptr; ++released)
+            {
+                tail = tail->freeListLink;
+            }
+
+            threadCache.freeList[__listIndex]   = tail->freeListLink;
+            threadCache.nodeCount[__listIndex] -= released;
+
+            syncPendingCounts(__listIndex);
+
+            pushCentralChain(__listIndex, chain, tail);
+        }
+
+        /**
+         * @brief 摘下第 __listIndex 号 free-list（多线程模式下是中央 free-list）上的全部节点，
+         *        串成一张以空指针结尾的单向链表返回。
+        */
+        static Obj * detachFreeList(std::size_t __listIndex)
+        {
+            if constexpr (!Threads)
+            {
+                Obj * chain = freeList[__listIndex];
+                freeList[__listIndex] = nullptr;
+
+                return chain;
+            }
+            else
+            {
+                std::atomic<TaggedPointer> & top = centralFreeList[__listIndex];
+                TaggedPointer oldTop = top.load();
+
+                while (!top.compare_exchange_weak(oldTop, makeTagged(nullptr, oldTop))) {}
+
+                /*把栈中的一串串节点首尾相接*/
+                Obj * chain = nullptr;
+                BatchHead * batch = (BatchHead *)pointerOf(oldTop);
+
+                while (batch != nullptr)
+                {
+                    BatchHead * nextBatch = batch->nextBatch;
+                    Obj * tail = (Obj *)batch;
+
+                    while (tail->freeListLink != nullptr) { tail = tail->freeListLink; }
+
+                    tail->freeListLink = chain;
+                    chain = (Obj *)batch;
+                    batch = nextBatch;
+                }
+
+                return chain;
+            }
+        }
+
+        /**
+         * @brief 把一串节点挂回第 __listIndex 号 free-list，多线程模式下每 __THREAD_BATCH_NODES 个节点压一串。
+        */
+        static void attachFreeList(std::size_t __listIndex, Obj * __chain)
+        {
+            while (__chain != nullptr)
+            {
+                Obj * tail = __chain;
+
+                if constexpr (Threads)
+                {
+                    for (int count = 1; count < __THREAD_BATCH_NODES && tail->freeListLink != nullptr; ++count)
+                    {
+                        tail = tail->freeListLink;
+                    }
+                }
+                else
+                {
+                    while (tail->freeListLink != nullptr) { tail = tail->freeListLink; }
+                }
+
+                Obj * rest = tail->freeListLink;
+
+                if constexpr (Threads)
+                {
+                    pushCentralChain(__listIndex, __chain, tail);
+                }
+                else
+                {
+                    tail->freeListLink = freeList[__listIndex];
+                    freeList[__listIndex] = __chain;
+                }
+
+                __chain = rest;
+            }
+        }
+
+        /**
+         * @brief 清点 free-list 与内存池剩余空间，把连续 __idleScans 次清点都完全空闲的 chunk 还给系统，
+         *        调用者必须持有内存池的锁。
+         *
+         * @brief - 一块 chunk 的空闲字节数 = 落在其中的 free-list 节点 + 内存池剩余空间 + 被舍弃的零头，
+         *          等于 chunk 大小时说明没有任何区块还在客端手中（也不在任何线程的缓存里），可以整块归还。
+         *
+         * @brief - 多线程模式下先摘走所有中央 free-list，其他线程此时只会看到空的 free-list 转而等待内存池的锁，
+         *          或者把新的节点压进来（这些节点没有被清点，所在的 chunk 只会被保守地认为仍在使用）。
+         *
+         * @return 还给系统的字节数
+        */
+        static std::size_t releaseFreeChunks(std::size_t __idleScans)
+        {
+            Obj * chains[__NFPREELISTS];
+
+            for (std::size_t listIndex = 0; listIndex < __NFPREELISTS; ++listIndex)
+            {
+                chains[listIndex] = detachFreeList(listIndex);
+            }
+
+            /*等待仍持有旧栈顶的弹栈线程退出*/
+            if constexpr (Threads)
+            {
+                while (activePoppers.load() != 0) { std::this_thread::yield(); }
+            }
+
+            /*统计每块 chunk 的空闲字节数*/
+            for (std::size_t index = 0; index < chunkCount; ++index)
+            {
+                chunkTable[index].freeBytes = chunkTable[index].wastedBytes;
+            }
+
+            for (std::size_t listIndex = 0; listIndex < __NFPREELISTS; ++listIndex)
+            {
+                for (Obj * node = chains[listIndex]; node != nullptr; node = node->freeListLink)
+                {
+                    if (ChunkRecord * chunk = findChunk((char *)node)) { chunk->freeBytes += classSizeTable[listIndex]; }
+                }
+            }
+
+            ChunkRecord * poolChunk = (startFreeList != endFreeList) ? findChunk(startFreeList) : nullptr;
+
+            if (poolChunk != nullptr) { poolChunk->freeBytes += endFreeList - startFreeList; }
+
+            for (std::size_t index = 0; index < chunkCount; ++index)
+            {
+                ChunkRecord & chunk = chunkTable[index];
+
+                chunk.idleScans = (chunk.freeBytes == chunk.bytes) ? chunk.idleScans + 1 : 0;
+            }
+
+            /*把不在待归还 chunk 中的节点挂回 free-list*/
+            auto releasing = [__idleScans](const ChunkRecord * __chunk)
+            {
+                return __chunk != nullptr && __chunk->idleScans >= __idleScans;
+            };
+
+            for (std::size_t listIndex = 0; listIndex < __NFPREELISTS; ++listIndex)
+            {
+                Obj * kept = nullptr;
+
+                for (Obj * node = chains[listIndex], * nextNode; node != nullptr; node = nextNode)
+                {
+                    nextNode = node->freeListLink;
+
+                    if (!releasing(findChunk((char *)node)))
+                    {
+                        node->freeListLink = kept;
+                        kept = node;
+                    }
+                    else
+                    {
+                        addCount(carvedCount[listIndex], std::size_t(-1));
+                    }
+                }
+
+                attachFreeList(listIndex, kept);
+            }
+
+            if (releasing(poolChunk)) { startFreeList = endFreeList = nullptr; }
+
+            /*归还 chunk，并从 chunkTable 中删去*/
+            std::size_t releasedBytes = 0, keptCount = 0;
+
+            for (std::size_t index = 0; index < chunkCount; ++index)
+            {
+                ChunkRecord & chunk = chunkTable[index];
+
+                if (!releasing(&chunk))
+                {
+                    chunkTable[keptCount++] = chunk;
+                    continue;
+                }
+
+                if (chunk.fromMalloc) { mallocAlloc::deallocate(chunk.address, chunk.bytes); }
+                else { ChunkSource::release(chunk.address, chunk.bytes); }
+
+                releasedBytes += chunk.bytes;
+            }
+
+            chunkCount = keptCount;
+            heapSize  -= releasedBytes;
+
+            return releasedBytes;
+        }
+
+        /**
+         * @brief 后台衰减线程（多线程模式下由 startDecay() / stopDecay() 控制）。
+        */
+        static DecayWorker & decayWorker(void)
+        {
+            static DecayWorker worker;
+
+            return worker;
+        }
+
     public:
+        /**
+         * @brief 申请 __n 字节时实际交出的字节数：小型区块为所属 free-list 的区块大小，其余由第一级配置器估算。
+        */
+        static std::size_t goodSize(std::size_t __n)
+        {
+            return (__n > __MAX_BYTES) ? mallocAlloc::goodSize(__n) : blockSize(__n);
+        }
+
         /**
          * @brief 空间配置函数 allcate，传入需要配置的空间大小，
          * 根据是否大于 128 bytes 来决定分配器的使用。
@@ -288,11 +1075,34 @@ class __DefaultAllocTemplate
             Obj * result;
 
             /*若分配的内存大于 128 bytes，就直接调用第一级分配器*/
-            if (__n > (std::size_t)__MAX_BYTES) { return (mallocAlloc::allocate(__n)); }
+            if (__n > (std::size_t)__MAX_BYTES)
+            {
+                addCount(largeAllocCount, 1);
+
+                return (mallocAlloc::allocate(__n));
+            }
+
+            /*多线程模式下只操作本线程的缓存，缓存耗尽时再批量向中央要节点*/
+            if constexpr (Threads)
+            {
+                if (__n < sizeof(BatchHead)) { __n = sizeof(BatchHead); }
+
+                const std::size_t listIndex = freeListIndex(__n);
+
+                result = threadCache.freeList[listIndex];
+                if (result == nullptr) { return reFillThreadCache(roundUp(__n)); }
+
+                threadCache.freeList[listIndex] = result->freeListLink;
+                --threadCache.nodeCount[listIndex];
+
+                return result;
+            }
 
             /*根据需要分配的内存大小，寻找 16 个 free-list 中合适的一个*/
             myFreeList = freeList + freeListIndex(__n);
 
+            addCount(allocCount[freeListIndex(__n)], 1);
+
             result = *myFreeList;
 
             /*若没找到可用的 free-list*/
@@ -333,6 +1143,28 @@ class __DefaultAllocTemplate
             if (__n > (std::size_t)__MAX_BYTES)
             {
                 mallocAlloc::deallocate(__ptr, __n);
+                return;
+            }
+
+            /*多线程模式下归还到本线程的缓存，缓存过长时成批归还给中央*/
+            if constexpr (Threads)
+            {
+                if (__n < sizeof(BatchHead)) { __n = sizeof(BatchHead); }
+
+                const std::size_t listIndex = freeListIndex(__n);
+
+                if (threadCache.nodeCount[listIndex] == 0) { (void)&threadCacheReaper; }
+                if constexpr (__ALLOC_STATS_) { ++threadCache.pendingFrees[listIndex]; }
+
+                tempNodePointer->freeListLink   = threadCache.freeList[listIndex];
+                threadCache.freeList[listIndex] = tempNodePointer;
+
+                if (++threadCache.nodeCount[listIndex] > __THREAD_CACHE_LIMIT)
+                {
+                    releaseThreadCache(listIndex, __THREAD_BATCH_NODES);
+                }
+
+                return;
             }
 
             /*
@@ -342,6 +1174,8 @@ class __DefaultAllocTemplate
             */
             myFreeList = freeList + freeListIndex(__n);
 
+            addCount(freeCount[freeListIndex(__n)], 1);
+
             /*
                 将客端的内存归还给这个链表
 
@@ -355,7 +1189,184 @@ class __DefaultAllocTemplate
         }
 
         /**
-         * @brief 为指定的内存块重新分配内存（这种实现或许有一定风险）
+         * @brief 按 __align（2 的幂）对齐分配内存。
+         * 
+         * @brief - 小型区块都是从 chunk 上按 __ALIGN 的倍数切下来的，只保证 __ALIGN 对齐，
+         *          对齐要求不超过 __ALIGN 时与 allocate(__n) 完全相同；
+         *          更严格的对齐（alignas(64) 的计数器、SIMD 向量等）转交第一级配置器的对齐分配。
+        */
+        static void * allocate(std::size_t __n, std::size_t __align)
+        {
+            if (__align <= __ALIGN) { return allocate(__n); }
+
+            addCount(largeAllocCount, 1);
+
+            return mallocAlloc::allocate(__n, __align);
+        }
+
+        /**
+         * @brief 释放 allocate(__n, __align) 分配的内存，__n 和 __align 必须与分配时相同。
+        */
+        static void deallocate(void * __ptr, std::size_t __n, std::size_t __align)
+        {
+            if (__align <= __ALIGN) { deallocate(__ptr, __n); return; }
+
+            mallocAlloc::deallocate(__ptr, __n, __align);
+        }
+
+        /**
+         * @brief 多线程模式下，把调用线程缓存的所有节点归还给中央 free-list（线程退出时会自动调用）。
+         *        单线程模式下什么也不做。
+        */
+        static void flushThreadCache(void)
+        {
+            if constexpr (Threads)
+            {
+                for (std::size_t listIndex = 0; listIndex < __NFPREELISTS; ++listIndex)
+                {
+                    releaseThreadCache(listIndex, threadCache.nodeCount[listIndex]);
+                }
+            }
+        }
+
+        /**
+         * @brief 把所有区块都已空闲的 chunk 整块还给系统（munmap / VirtualFree），heapSize 随之减少。
+         *
+         * @brief - 多线程模式下会先归还调用线程的缓存，其他线程缓存中的节点视为仍在使用，
+         *          需要的话由那些线程自己调用 flushThreadCache()。
+         *
+         * @return 还给系统的字节数
+        */
+        static std::size_t releaseUnused(void)
+        {
+            flushThreadCache();
+
+            Lock poolLock;
+
+            return releaseFreeChunks(1);
+        }
+
+        /**
+         * @brief 在 releaseUnused() 的基础上，再让内存池剩余空间中的整页不再占用物理内存（madvise(MADV_DONTNEED)），
+         *        这些页仍然属于内存池，下次切分时重新得到零页。
+         *
+         * @return 还给系统的字节数
+        */
+        static std::size_t trim(void)
+        {
+            std::size_t releasedBytes = releaseUnused();
+
+            Lock poolLock;
+
+            ChunkRecord * poolChunk = (startFreeList != endFreeList) ? findChunk(startFreeList) : nullptr;
+
+            if (poolChunk != nullptr && !poolChunk->fromMalloc)
+            {
+                releasedBytes += ChunkSource::decommit(startFreeList, endFreeList - startFreeList);
+            }
+
+            return releasedBytes;
+        }
+
+        /**
+         * @brief 多线程模式下启动后台衰减线程，每隔 __interval 清点一次，
+         *        把连续 __idleScans 次清点都完全空闲的 chunk 还给系统。重复调用会以新的参数重启。
+        */
+        static void startDecay(std::chrono::milliseconds __interval, std::size_t __idleScans = 2)
+        {
+            static_assert(Threads, "background decay needs the thread-safe pool (Threads = true)");
+
+            decayWorker().start(__interval, (__idleScans == 0) ? 1 : __idleScans);
+        }
+
+        /**
+         * @brief 停止后台衰减线程（程序退出时也会自动停止）。
+        */
+        static void stopDecay(void)
+        {
+            static_assert(Threads, "background decay needs the thread-safe pool (Threads = true)");
+
+            decayWorker().stop();
+        }
+
+        /**
+         * @brief 获取统计信息。
+         *
+         * @brief - 多线程模式下各线程的申请、释放次数在与中央交换节点时才汇总，
+         *          因此其他线程的计数最多滞后一批（__THREAD_BATCH_NODES 次），调用线程自己的计数是准确的。
+         *
+         * @brief - 关闭 __ALLOC_STATS_ 时只有 poolRemainder、heapSize 和 chunkCount 有意义，其余各项恒为 0。
+        */
+        static __DefaultAllocStats<__NFPREELISTS> getStats(void)
+        {
+            __DefaultAllocStats<__NFPREELISTS> stats{};
+
+            for (std::size_t listIndex = 0; listIndex < __NFPREELISTS; ++listIndex)
+            {
+                flushPendingCounts(listIndex);
+
+                __SizeClassStats & sizeClass = stats.sizeClasses[listIndex];
+
+                sizeClass.blockSize     = classSizeTable[listIndex];
+                sizeClass.allocations   = loadCount(allocCount[listIndex]);
+                sizeClass.deallocations = loadCount(freeCount[listIndex]);
+                sizeClass.refills       = loadCount(refillCount[listIndex]);
+
+                /*计数滞后时释放次数可能暂时多于申请次数，按 0 处理*/
+                std::size_t carved      = loadCount(carvedCount[listIndex]);
+                sizeClass.liveBlocks    = (sizeClass.allocations > sizeClass.deallocations) ? sizeClass.allocations - sizeClass.deallocations : 0;
+                sizeClass.freeBlocks    = (carved > sizeClass.liveBlocks) ? carved - sizeClass.liveBlocks : 0;
+                sizeClass.freeListBytes = sizeClass.freeBlocks * sizeClass.blockSize;
+
+                stats.freeListBytes += sizeClass.freeListBytes;
+            }
+
+            stats.largeAllocations = loadCount(largeAllocCount);
+
+            Lock poolLock;
+
+            stats.poolRemainder = endFreeList - startFreeList;
+            stats.heapSize      = heapSize;
+            stats.chunkCount    = chunkCount;
+
+            return stats;
+        }
+
+        /**
+         * @brief 以表格的形式把 getStats() 的结果打印到 __stream。
+        */
+        static void printStats(std::FILE * __stream = stdout)
+        {
+            const __DefaultAllocStats<__NFPREELISTS> stats = getStats();
+
+            std::fprintf(__stream, "%-8s %-12s %-12s %-10s %-10s %-10s %-12s\n",
+                         "size", "allocs", "frees", "refills", "live", "free", "free bytes");
+
+            for (const __SizeClassStats & sizeClass : stats.sizeClasses)
+            {
+                if (sizeClass.allocations == 0 && sizeClass.freeBlocks == 0) { continue; }
+
+                std::fprintf(__stream, "%-8zu %-12zu %-12zu %-10zu %-10zu %-10zu %-12zu\n",
+                             sizeClass.blockSize, sizeClass.allocations, sizeClass.deallocations, sizeClass.refills,
+                             sizeClass.liveBlocks, sizeClass.freeBlocks, sizeClass.freeListBytes);
+            }
+
+            std::fprintf(__stream, "free-list bytes : %zu\n", stats.freeListBytes);
+            std::fprintf(__stream, "pool remainder  : %zu\n", stats.poolRemainder);
+            std::fprintf(__stream, "heap size       : %zu (%zu chunks)\n", stats.heapSize, stats.chunkCount);
+            std::fprintf(__stream, "large fallbacks : %zu\n", stats.largeAllocations);
+        }
+
+        /**
+         * @brief 为指定的内存块重新分配内存
+         * 
+         * @brief - 新旧大小都超过 __MAX_BYTES 时，内存块本来就属于第一级配置器，直接交给 realloc，
+         *          libc 可以原地扩展，大块内存还可以用 mremap 搬移而不必拷贝。
+         * 
+         * @brief - 新旧大小落在同一条 free-list 上时，原来的区块已经够用，直接返回。
+         * 
+         * @brief - 其余情况（包括在内存池和第一级配置器之间跨越）都是申请、拷贝、归还：
+         *          区块来自哪一级配置器由它的大小决定，归还时也必须交给同一级。
          * 
          * @param __ptr         目标内存块地址
          * @param __oldSize     旧内存块大小
@@ -365,39 +1376,109 @@ class __DefaultAllocTemplate
         */
         static void * reallocate(void * __ptr, std::size_t __oldSize, std::size_t __newSize)
         {
-            /*若新扩展的内存大于 128 字节，直接调用第一级分配器在堆上分配内存，而不去直接操作链表*/
-            if (__newSize > __MAX_BYTES) { return mallocAlloc::reallocate(__ptr, __oldSize, __newSize); }
+            if (__ptr == nullptr) { return allocate(__newSize); }
+
+            /*新旧内存块都在第一级分配器上，直接调用 realloc，而不去操作链表*/
+            if (__oldSize > __MAX_BYTES && __newSize > __MAX_BYTES)
+            {
+                return mallocAlloc::reallocate(__ptr, __oldSize, __newSize);
+            }
 
-            /*根据新的内存重新选择链表并划出内存交由 newNodePointer 管理*/
+            /*新旧内存块是同一个尺寸级别的区块，不需要搬移*/
+            if (__oldSize <= __MAX_BYTES && __newSize <= __MAX_BYTES && blockSize(__oldSize) == blockSize(__newSize))
+            {
+                return __ptr;
+            }
+
+            /*根据新的内存重新选择链表（或第一级分配器）并划出内存交由 newNodePointer 管理*/
             void * newNodePointer = allocate(__newSize);
 
             /*根据新旧内存的大小确定要拷贝内存的大小*/
             std::size_t copySize = (__oldSize < __newSize) ? __oldSize : __newSize;
 
-            /*直接拷贝内存到新分配的链表中（这个操作或许相当危险，回产生内存碎片）*/
             std::memcpy(newNodePointer, __ptr, copySize);
 
-            /*归还旧数据*/
+            /*归还旧数据（按旧的大小交还给它原本所在的那一级）*/
             deallocate(__ptr, __oldSize);
 
             return newNodePointer;
         }
+
+        /**
+         * @brief 为 allocate(__oldSize, __align) 分配的内存块重新分配内存，
+         *        对齐要求不超过 __ALIGN 时与 reallocate(__ptr, __oldSize, __newSize) 相同，否则交给第一级配置器的对齐版本。
+        */
+        static void * reallocate(void * __ptr, std::size_t __oldSize, std::size_t __newSize, std::size_t __align)
+        {
+            if (__align <= __ALIGN) { return reallocate(__ptr, __oldSize, __newSize); }
+
+            return mallocAlloc::reallocate(__ptr, __oldSize, __newSize, __align);
+        }
 };
 
-template <bool Threads, int Inst>
-char * __DefaultAllocTemplate<Threads, Inst>::startFreeList = nullptr;
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+char * __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::startFreeList = nullptr;
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+char * __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::endFreeList = nullptr;
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+std::size_t __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::heapSize = 0;
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::Obj * volatile
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::freeList[__NFPREELISTS] = {nullptr};
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::ChunkRecord *
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::chunkTable = nullptr;
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+std::size_t __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::chunkCount = 0;
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+std::size_t __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::chunkCapacity = 0;
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::Counter
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::allocCount[__NFPREELISTS];
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::Counter
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::freeCount[__NFPREELISTS];
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::Counter
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::refillCount[__NFPREELISTS];
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::Counter
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::carvedCount[__NFPREELISTS];
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::Counter
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::largeAllocCount;
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+std::mutex __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::centralMutex;
+
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+std::atomic<typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::TaggedPointer>
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::centralFreeList[__NFPREELISTS];
 
-template <bool Threads, int Inst>
-char * __DefaultAllocTemplate<Threads, Inst>::endFreeList = nullptr;
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+std::atomic<std::size_t> __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::activePoppers{0};
 
-template <bool Threads, int Inst>
-std::size_t __DefaultAllocTemplate<Threads, Inst>::heapSize = 0;
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+thread_local typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::ThreadCache
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::threadCache = {};
 
-template <bool Threads, int Inst>
-typename __DefaultAllocTemplate<Threads, Inst>::Obj * volatile
-__DefaultAllocTemplate<Threads, Inst>::freeList[__NFPREELISTS] = {nullptr};
+template <bool Threads, int Inst, typename SizeClass, typename ChunkSource>
+thread_local typename __DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::ThreadCacheReaper
+__DefaultAllocTemplate<Threads, Inst, SizeClass, ChunkSource>::threadCacheReaper;
 }
 
 typedef SGIAllocator::__DefaultAllocTemplate<false, 0> sgiAlloc;
+typedef SGIAllocator::__DefaultAllocTemplate<true, 0>  sgiThreadAlloc;
 
 #endif // __DEFAULT_ALLOC_TEMPLATE_H_
\ No newline at end of file
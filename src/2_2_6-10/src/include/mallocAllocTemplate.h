@@ -1,8 +1,16 @@
 #ifndef __MALLOC_ALLOC_TEMPLATE_H_
 #define __MALLOC_ALLOC_TEMPLATE_H_
 
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include "./mallocAllocOomHandler.h"
 
+#if defined(_WIN32)
+#include <malloc.h>     // _aligned_malloc 和 _aligned_free 位于此处
+#endif
+
 // 第一级配置器 __MALLOC_ALLOC_TEMPLATE_H_
 
 // 第一级配置器不抛 bad_alloc 异常
@@ -19,8 +27,28 @@
 #define __THROW_BAD_ALLOC_ std::cerr << "Out of Memory." << '\n'; exit(EXIT_FAILURE);
 #endif
 
+/*
+    分配器统计信息的编译期开关（两级配置器共用），默认打开。
+    编译时定义 __ALLOC_STATS_ 为 0 即可关闭，所有计数代码都会在编译期消失，getStats() 中的计数项恒为 0。
+*/
+#ifndef __ALLOC_STATS_
+#define __ALLOC_STATS_ 1
+#endif
+
 namespace SGIAllocator
 {
+    /**
+     * @brief 第一级配置器的统计信息（见 __Malloc_Alloc_Template::getStats()）。
+    */
+    struct __MallocAllocStats
+    {
+        std::size_t allocations;        // allocate() 的调用次数
+        std::size_t deallocations;      // deallocate() 的调用次数
+        std::size_t reallocations;      // reallocate() 的调用次数
+        std::size_t oomMallocCalls;     // malloc 失败、转而调用 oomMalloc() 的次数
+        std::size_t oomReallocCalls;    // realloc 失败、转而调用 oomRealloc() 的次数
+    };
+
     /**
      * @tparam Inst 用于后面的实例化
     */
@@ -40,14 +68,58 @@ namespace SGIAllocator
             */
             static void *oomRealloc(void *, std::size_t);
 
+            /**
+             * @brief 在内存不足时用于按指定边界对齐分配内存的函数
+            */
+            static void *oomAlignedMalloc(std::size_t, std::size_t);
+
+            /**
+             * @brief 按 __align 对齐分配 __n 字节，失败时返回空指针（__align 为 2 的幂）。
+            */
+            static void * alignedMalloc(std::size_t __n, std::size_t __align)
+            {
+                if (__align < sizeof(void *)) { __align = sizeof(void *); }
+                if (__n == 0) { __n = __align; }
+
+#if defined(_WIN32)
+                return _aligned_malloc(__n, __align);
+#else
+                /*aligned_alloc 要求字节数是对齐边界的倍数*/
+                return std::aligned_alloc(__align, (__n + __align - 1) & ~(__align - 1));
+#endif
+            }
+
             /**
              * @brief 一个函数指针，指向了一个无参且无返回值的函数，
              *        一般用来保存默认内存耗尽函数的地址，这个函数会在内存不足时试图向系统请求更多的内存。
             */
             static void (* __mallocAllocOomHandler) ();
 
+            /*统计计数，第二级配置器在多线程模式下也会调用到这里，因此使用原子变量*/
+            static std::atomic<std::size_t> allocCount;
+            static std::atomic<std::size_t> freeCount;
+            static std::atomic<std::size_t> reallocCount;
+            static std::atomic<std::size_t> oomMallocCount;
+            static std::atomic<std::size_t> oomReallocCount;
+
+            static void countEvent(std::atomic<std::size_t> & __counter)
+            {
+                if constexpr (__ALLOC_STATS_) { __counter.fetch_add(1, std::memory_order_relaxed); }
+            }
+
         public:
 
+            /**
+             * @brief       申请 __n 字节时 malloc 实际交出的字节数（按 glibc 估算，只作为容器取整容量的参考）：
+             *              小块以 16 字节为粒度（扣除 8 字节的头部），超过 mmap 阈值（默认 128 KiB）的按整页映射（扣除 16 字节的头部）。
+            */
+            static std::size_t goodSize(std::size_t __n)
+            {
+                if (__n < 128 * 1024) { return ((__n + 8 + 15) & ~(std::size_t)15) - 8; }
+
+                return ((__n + 16 + 4095) & ~(std::size_t)4095) - 16;
+            }
+
             /**
              * @brief       第一级配置器 allocate 针对内存块较大的情况，直接调用 malloc 去分配内存
              * 
@@ -57,6 +129,8 @@ namespace SGIAllocator
             */
             static void * allocate(std::size_t __n) 
             {
+                countEvent(allocCount);
+
                 void * result = std::malloc(__n);
 
                 /*若 malloc 返回空指针，意味着内存耗尽，转而使用在内存耗尽时分配内存的策略。*/
@@ -73,7 +147,64 @@ namespace SGIAllocator
              * 
              * @return non-return
             */
-            static void deallocate(void * __ptr, std::size_t __n = 0) { free(__ptr); }
+            static void deallocate(void * __ptr, std::size_t __n = 0) { countEvent(freeCount); free(__ptr); }
+
+            /**
+             * @brief       按 __align（2 的幂）对齐分配内存，
+             *              供 malloc 本身的对齐保证不够用的类型（alignas(64) 的计数器、AVX-512 向量等）使用。
+             * 
+             * @param __n       要分配内存的大小
+             * @param __align   对齐边界
+             * 
+             * @return      返回分配完成后内存块的首地址
+            */
+            static void * allocate(std::size_t __n, std::size_t __align)
+            {
+                countEvent(allocCount);
+
+                void * result = alignedMalloc(__n, __align);
+
+                if (result == nullptr) { result = oomAlignedMalloc(__n, __align); }
+
+                return result;
+            }
+
+            /**
+             * @brief           释放 allocate(__n, __align) 分配的内存（Windows 上必须与 _aligned_malloc 配对）。
+             *                  对齐分配的内存不能交给 reallocate()，realloc 不保证新内存的对齐。
+            */
+            static void deallocate(void * __ptr, std::size_t __n, std::size_t __align)
+            {
+                countEvent(freeCount);
+
+#if defined(_WIN32)
+                _aligned_free(__ptr);
+#else
+                free(__ptr);
+#endif
+            }
+
+            /**
+             * @brief           为 allocate(__oldSz, __align) 分配的内存块重新分配内存。
+             * 
+             * @brief - 对齐要求不超过 malloc 本身的保证时就是普通的 realloc（POSIX 下 aligned_alloc 的内存可以交给 realloc），
+             *          否则 realloc 不保证新内存的对齐，只能申请、拷贝、释放。
+            */
+            static void * reallocate(void * __ptr, std::size_t __oldSz, std::size_t __newSz, std::size_t __align)
+            {
+#if !defined(_WIN32)
+                if (__align <= alignof(std::max_align_t)) { return reallocate(__ptr, __oldSz, __newSz); }
+#endif
+                /*与 realloc 一致，空指针等同于 allocate，也免得把空指针交给 memcpy*/
+                if (__ptr == nullptr) { return allocate(__newSz, __align); }
+
+                void * result = allocate(__newSz, __align);
+
+                std::memcpy(result, __ptr, (__oldSz < __newSz) ? __oldSz : __newSz);
+                deallocate(__ptr, __oldSz, __align);
+
+                return result;
+            }
 
             /**
              * @brief           第一级配置器 reallocate 针对内存块较大的情况，直接调用 realloc 去重新分配内存
@@ -86,6 +217,8 @@ namespace SGIAllocator
             */
             static void * reallocate(void * __ptr, std::size_t __oldSz, std::size_t __newSz)
             {
+                countEvent(reallocCount);
+
                 void * result = realloc(__ptr, __newSz);
 
                 /*若 realloc 返回空指针，意味着内存耗尽，转而使用在内存耗尽时分配内存的策略。*/
@@ -114,8 +247,26 @@ namespace SGIAllocator
                 /*返回默认 oomHandler 函数的地址，用于还原*/
                 return defaultHandler;
             }
+
+            /**
+             * @brief 获取第一级配置器的统计信息（关闭 __ALLOC_STATS_ 时各项恒为 0）。
+            */
+            static __MallocAllocStats getStats(void)
+            {
+                return __MallocAllocStats{
+                    allocCount.load(std::memory_order_relaxed), freeCount.load(std::memory_order_relaxed),
+                    reallocCount.load(std::memory_order_relaxed), oomMallocCount.load(std::memory_order_relaxed),
+                    oomReallocCount.load(std::memory_order_relaxed)
+                };
+            }
     };
 
+    template <int Inst> std::atomic<std::size_t> __Malloc_Alloc_Template<Inst>::allocCount{0};
+    template <int Inst> std::atomic<std::size_t> __Malloc_Alloc_Template<Inst>::freeCount{0};
+    template <int Inst> std::atomic<std::size_t> __Malloc_Alloc_Template<Inst>::reallocCount{0};
+    template <int Inst> std::atomic<std::size_t> __Malloc_Alloc_Template<Inst>::oomMallocCount{0};
+    template <int Inst> std::atomic<std::size_t> __Malloc_Alloc_Template<Inst>::oomReallocCount{0};
+
     /*
         初始化 oomHandler 为自己设计的在 Windows 平台下内部不足的一个简单处理例程。
     */
@@ -142,6 +293,8 @@ namespace SGIAllocator
         void (* myAllocHandler) ();
         void * result;
 
+        countEvent(oomMallocCount);
+
         while (true)
         {
             /*拿到用户或系统定义的内存不足处理函数的指针*/
@@ -171,6 +324,8 @@ namespace SGIAllocator
         void (* myAllocHandler) ();
         void * result;
 
+        countEvent(oomReallocCount);
+
         while (true)
         {
             myAllocHandler = __mallocAllocOomHandler;
@@ -183,6 +338,30 @@ namespace SGIAllocator
             if (result) return (result);
         }
     }
+
+    /**
+     * @brief 和 oomMalloc 函数类似，只是用于对齐分配内存
+    */
+    template <int Inst>
+    void * __Malloc_Alloc_Template<Inst>::oomAlignedMalloc(std::size_t __n, std::size_t __align)
+    {
+        void (* myAllocHandler) ();
+        void * result;
+
+        countEvent(oomMallocCount);
+
+        while (true)
+        {
+            myAllocHandler = __mallocAllocOomHandler;
+            if (myAllocHandler == nullptr) { __THROW_BAD_ALLOC_; }
+
+            (*myAllocHandler) ();
+
+            result = alignedMalloc(__n, __align);
+
+            if (result) return (result);
+        }
+    }
 }
 
 /*具体化这个模板类，使用 mallocAlloc 来代替 __Malloc_Alloc_Template<0>*/
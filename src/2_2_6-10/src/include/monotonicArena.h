@@ -0,0 +1,305 @@
+#ifndef __MONOTONIC_ARENA_H_
+#define __MONOTONIC_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "./mallocAllocTemplate.h"
+#include "./chunkSource.h"
+
+/*单调（monotonic）arena 分配器*/
+
+/*
+    为一次请求（或一帧、一轮计算）服务的容器，往往在请求结束时一起销毁，
+    逐个节点地 deallocate 再放回 free-list 纯属多余的工作。arena 的做法是：
+
+        allocate()      在当前 chunk 上移动指针（bump pointer），不够时向 ChunkSource 要一块更大的 chunk
+        deallocate()    什么也不做
+        reset()         一次性丢弃所有分配，只留下最大的一块 chunk 给下一次请求复用
+        Scope           作用域守卫，析构时把 arena 回退到构造时的位置，可以嵌套
+
+    容器通过 __ArenaAllocator<Type> 使用 arena，它只是一个指向 arena 的指针，
+    可以作为 My_Vector、MyList、My_Deque、RB_Tree 的 Alloc 参数（由 Simple_Alloc 保存在容器里）。
+
+    注意：arena 本身不是线程安全的，回退或 reset() 之前，在其上分配的容器必须已经销毁（或不再使用）。
+*/
+
+namespace SGIAllocator
+{
+    template <typename ChunkSource = __MmapChunkSource>
+    class __MonotonicArena
+    {
+        private:
+            enum {__DEFAULT_CHUNK_BYTES = 64 * 1024};           // 第一块 chunk 的默认大小
+            enum {__MAX_CHUNK_BYTES     = 16 * 1024 * 1024};    // chunk 按两倍增长，但不超过这个大小
+
+            /**
+             * @brief 每块 chunk 开头的头部信息，chunk 之间从新到旧串成单向链表。
+            */
+            struct alignas(std::max_align_t) ChunkHeader
+            {
+                ChunkHeader * prev;         // 上一块（更早申请的）chunk
+                std::size_t   bytes;        // 整块 chunk 的字节数（包括头部）
+                bool          fromMalloc;   // ChunkSource 失败时退而向第一级配置器申请的 chunk，要还给第一级配置器
+            };
+
+            ChunkHeader * chunks = nullptr;     // 当前使用中的 chunk（链表头是最新的一块）
+            ChunkHeader * spare  = nullptr;     // 回退时留下来的一块 chunk，下次需要新 chunk 时优先复用
+
+            char * current = nullptr;           // 当前 chunk 中下一次分配的位置
+            char * limit   = nullptr;           // 当前 chunk 的末尾
+
+            std::size_t nextChunkBytes;         // 下一次向 ChunkSource 申请的 chunk 大小
+            std::size_t heldBytes = 0;          // 从系统拿到、尚未归还的字节数（包括 spare）
+
+            static char * chunkBegin(ChunkHeader * __chunk) { return (char *)(__chunk + 1); }
+            static char * chunkEnd(ChunkHeader * __chunk)   { return (char *)__chunk + __chunk->bytes; }
+
+            void releaseChunk(ChunkHeader * __chunk)
+            {
+                heldBytes -= __chunk->bytes;
+
+                if (__chunk->fromMalloc) { mallocAlloc::deallocate(__chunk, __chunk->bytes); }
+                else { ChunkSource::release(__chunk, __chunk->bytes); }
+            }
+
+            /**
+             * @brief 回退时不再使用的 chunk：只留下最大的一块作为 spare，其余的还给系统。
+            */
+            void retireChunk(ChunkHeader * __chunk)
+            {
+                if (spare == nullptr) { spare = __chunk; }
+                else if (__chunk->bytes > spare->bytes) { this->releaseChunk(spare); spare = __chunk; }
+                else { this->releaseChunk(__chunk); }
+            }
+
+            /**
+             * @brief 当前 chunk 放不下时，换一块新的 chunk 再分配（优先复用 spare）。
+            */
+            void * allocateSlow(std::size_t __bytes, std::size_t __align)
+            {
+                const std::size_t neededBytes = sizeof(ChunkHeader) + __bytes + __align;
+
+                ChunkHeader * chunk = nullptr;
+
+                if (spare != nullptr && spare->bytes >= neededBytes)
+                {
+                    chunk = spare;
+                    spare = nullptr;
+                }
+                else
+                {
+                    std::size_t chunkBytes = (neededBytes > nextChunkBytes) ? neededBytes : nextChunkBytes;
+                    chunkBytes = (chunkBytes + ChunkSource::granularity() - 1) & ~(ChunkSource::granularity() - 1);
+
+                    bool fromMalloc = false;
+                    void * memory   = ChunkSource::allocate(chunkBytes);
+
+                    if (memory == nullptr)
+                    {
+                        memory     = mallocAlloc::allocate(chunkBytes);
+                        fromMalloc = true;
+                    }
+
+                    chunk = (ChunkHeader *)memory;
+                    chunk->bytes      = chunkBytes;
+                    chunk->fromMalloc = fromMalloc;
+                    heldBytes += chunkBytes;
+
+                    if (nextChunkBytes < __MAX_CHUNK_BYTES) { nextChunkBytes *= 2; }
+                }
+
+                chunk->prev = chunks;
+                chunks      = chunk;
+                current     = chunkBegin(chunk);
+                limit       = chunkEnd(chunk);
+
+                return this->allocate(__bytes, __align);
+            }
+
+        public:
+            /**
+             * @brief 回退点，由 mark() 得到，交给 rewind() 使用。
+            */
+            struct Mark
+            {
+                ChunkHeader * chunk;
+                char *        current;
+            };
+
+            /**
+             * @brief 作用域守卫：构造时记下 arena 的位置，析构时回退到这个位置，
+             *        作用域内的所有分配一次性作废。在守卫之后声明的容器会先于守卫析构。
+            */
+            class Scope
+            {
+                private:
+                    __MonotonicArena & arena;
+                    Mark               mark;
+
+                public:
+                    explicit Scope(__MonotonicArena & __arena) : arena(__arena), mark(__arena.mark()) {}
+
+                    ~Scope() { arena.rewind(mark); }
+
+                    Scope(const Scope &) = delete;
+                    Scope & operator=(const Scope &) = delete;
+            };
+
+            /**
+             * @param __initialChunkBytes 第一块 chunk 的大小，之后每块翻倍
+            */
+            explicit __MonotonicArena(std::size_t __initialChunkBytes = __DEFAULT_CHUNK_BYTES)
+                : nextChunkBytes(__initialChunkBytes < 4096 ? 4096 : __initialChunkBytes) {}
+
+            __MonotonicArena(const __MonotonicArena &) = delete;
+            __MonotonicArena & operator=(const __MonotonicArena &) = delete;
+
+            ~__MonotonicArena() { this->release(); }
+
+            /**
+             * @brief 分配 __bytes 字节、按 __align（2 的幂）对齐的内存。
+            */
+            void * allocate(std::size_t __bytes, std::size_t __align = alignof(std::max_align_t))
+            {
+                const std::uintptr_t address = ((std::uintptr_t)current + __align - 1) & ~(std::uintptr_t)(__align - 1);
+
+                if (current == nullptr || address + __bytes > (std::uintptr_t)limit)
+                {
+                    return this->allocateSlow(__bytes, __align);
+                }
+
+                current = (char *)(address + __bytes);
+
+                return (void *)address;
+            }
+
+            /**
+             * @brief 单个区块不做释放，内存在 reset()、rewind() 或 arena 析构时一起回收。
+            */
+            void deallocate(void *, std::size_t) noexcept {}
+            void deallocate(void *, std::size_t, std::size_t) noexcept {}
+
+            /**
+             * @brief 重新分配内存：__ptr 恰好是最近一次分配、并且当前 chunk 还放得下时原地伸缩，否则申请、拷贝。
+            */
+            void * reallocate(void * __ptr, std::size_t __oldBytes, std::size_t __newBytes, 
+                              std::size_t __align = alignof(std::max_align_t))
+            {
+                char * block = (char *)__ptr;
+
+                if (block != nullptr && block + __oldBytes == current && (std::uintptr_t)block + __newBytes <= (std::uintptr_t)limit)
+                {
+                    current = block + __newBytes;
+                    return __ptr;
+                }
+
+                void * result = this->allocate(__newBytes, __align);
+
+                if (block != nullptr) { std::memcpy(result, block, (__oldBytes < __newBytes) ? __oldBytes : __newBytes); }
+
+                return result;
+            }
+
+            /**
+             * @brief 记下当前的位置。
+            */
+            Mark mark(void) const noexcept { return Mark{chunks, current}; }
+
+            /**
+             * @brief 回退到 __mark 的位置，之后的分配全部作废，
+             *        期间申请的 chunk 只留下最大的一块备用，其余的还给系统。
+            */
+            void rewind(const Mark & __mark)
+            {
+                while (chunks != __mark.chunk)
+                {
+                    ChunkHeader * chunk = chunks;
+                    chunks = chunk->prev;
+                    this->retireChunk(chunk);
+                }
+
+                current = __mark.current;
+                limit   = (chunks != nullptr) ? chunkEnd(chunks) : nullptr;
+            }
+
+            /**
+             * @brief 丢弃所有分配，只保留最大的一块 chunk 给下一次使用。
+            */
+            void reset(void) { this->rewind(Mark{nullptr, nullptr}); }
+
+            /**
+             * @brief 丢弃所有分配，并把所有 chunk（包括备用的那块）都还给系统。
+            */
+            void release(void)
+            {
+                this->reset();
+
+                if (spare != nullptr) { this->releaseChunk(spare); spare = nullptr; }
+            }
+
+            /**
+             * @brief 从系统拿到、尚未归还的字节数。
+            */
+            std::size_t footprint(void) const noexcept { return heldBytes; }
+    };
+
+    /**
+     * @brief 在 __MonotonicArena 上分配的标准风格分配器，只保存 arena 的指针。
+     *
+     * @brief - 与 std::pmr 的分配器一样不随容器的赋值、交换而传播，
+     *          在不同 arena 之间移动赋值时，容器会逐个移动元素，而不是把另一个 arena 的内存接管过来。
+    */
+    template <typename Type, typename Arena = __MonotonicArena<>>
+    class __ArenaAllocator
+    {
+        private:
+            template <typename, typename> friend class __ArenaAllocator;
+
+            Arena * arena;
+
+        public:
+            typedef Type            value_type;
+            typedef std::size_t     size_type;
+            typedef std::ptrdiff_t  difference_type;
+
+            typedef std::false_type propagate_on_container_copy_assignment;
+            typedef std::false_type propagate_on_container_move_assignment;
+            typedef std::false_type propagate_on_container_swap;
+            typedef std::false_type is_always_equal;
+
+            template <typename Other>
+            struct rebind { typedef __ArenaAllocator<Other, Arena> other; };
+
+            explicit __ArenaAllocator(Arena & __arena) noexcept : arena(&__arena) {}
+
+            template <typename Other>
+            __ArenaAllocator(const __ArenaAllocator<Other, Arena> & __other) noexcept : arena(__other.arena) {}
+
+            Type * allocate(std::size_t __n) { return (Type *)arena->allocate(__n * sizeof(Type), alignof(Type)); }
+
+            void deallocate(Type *, std::size_t) noexcept {}
+
+            Type * reallocate(Type * __ptr, std::size_t __oldN, std::size_t __newN)
+            {
+                return (Type *)arena->reallocate(__ptr, __oldN * sizeof(Type), __newN * sizeof(Type), alignof(Type));
+            }
+
+            Arena & getArena(void) const noexcept { return *arena; }
+
+            template <typename Other>
+            bool operator==(const __ArenaAllocator<Other, Arena> & __other) const noexcept { return arena == __other.arena; }
+
+            template <typename Other>
+            bool operator!=(const __ArenaAllocator<Other, Arena> & __other) const noexcept { return arena != __other.arena; }
+    };
+}
+
+typedef SGIAllocator::__MonotonicArena<> monotonicArena;
+
+template <typename Type>
+using arenaAlloc = SGIAllocator::__ArenaAllocator<Type>;
+
+#endif // __MONOTONIC_ARENA_H_
@@ -12,6 +12,7 @@ namespace SimpleAllocate
      * @brief - 类内这四个成员方法都是单纯的转调用
      * @brief - 调用传递给配置器（可能是第一级也可能是第二级）的成员函数
      * @brief - 该接口使配置器的配置单位从 bytes 转化为各别元素的大小
+     * @brief - 同时把元素类型的对齐要求 alignof(__Type) 一并交给配置器
      * 
      * @tparam  __Type  要进行分配的内存类型
      * @tparam  __Alloc 要使用的分配器类型
@@ -20,13 +21,19 @@ namespace SimpleAllocate
     class SimpleAllocator
     {
         public:
-            static __Type *allocate(std::size_t __n) { return (__n == 0) ? nullptr : (__Type *)__Alloc::allocate(__n); }
+            static __Type *allocate(std::size_t __n) 
+            { 
+                return (__n == 0) ? nullptr : (__Type *)__Alloc::allocate(__n * sizeof(__Type), alignof(__Type)); 
+            }
 
-            static __Type *allocate(void) { return (__Type *)__Alloc::allocate(sizeof(__Type)); }
+            static __Type *allocate(void) { return (__Type *)__Alloc::allocate(sizeof(__Type), alignof(__Type)); }
 
-            static void deallocate(__Type *__buffer, std::size_t __n) { if (__n != 0) { __Alloc::deallocate(__buffer, __n); } }
+            static void deallocate(__Type *__buffer, std::size_t __n) 
+            { 
+                if (__n != 0) { __Alloc::deallocate(__buffer, __n * sizeof(__Type), alignof(__Type)); } 
+            }
 
-            static void deallocate(__Type *__buffer) { __Alloc::deallocate(__buffer, sizeof(__Type)); }
+            static void deallocate(__Type *__buffer) { __Alloc::deallocate(__buffer, sizeof(__Type), alignof(__Type)); }
     };
 
 } // end SimpleAllocator
@@ -0,0 +1,134 @@
+#ifndef __SIZE_CLASS_POLICY_H_
+#define __SIZE_CLASS_POLICY_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/*第二级配置器的尺寸分级策略（size class policy）*/
+
+/*
+    SGI 的第二级配置器把对齐边界（8）、小型区块上限（128）和 free-list 的间距（每隔 8 字节一条）都写死了，
+    超过 128 字节的 RB-Tree 节点、list 节点就只能统统交给第一级配置器。
+
+    这里把这三件事抽成一个编译期策略，一个策略需要提供：
+
+        align           小型区块的上调边界，同时也是每个区块的对齐，必须是 2 的幂且不小于一个指针
+        maxBytes        小型区块的上限
+        classCount      free-list 的数量
+        classSize(i)    第 i 号 free-list 的区块大小（constexpr，严格递增，都是 align 的倍数，最后一个等于 maxBytes）
+
+    第二级配置器在编译期据此生成两张表：每条 free-list 的区块大小，以及 “字节数 / align” 到 free-list 下标的映射，
+    这样 freeListIndex() 和 roundUp() 都只是一次查表。
+*/
+
+namespace SGIAllocator
+{
+    /**
+     * @brief 线性分级：align，2 * align，3 * align，... ，maxBytes（SGI 原版就是 __LinearSizeClass<8, 128>）
+     *
+     * @tparam Align      小型区块的上调边界
+     * @tparam MaxBytes   小型区块的上限
+    */
+    template <std::size_t Align, std::size_t MaxBytes>
+    struct __LinearSizeClass
+    {
+        static constexpr std::size_t align      = Align;
+        static constexpr std::size_t maxBytes   = MaxBytes;
+        static constexpr std::size_t classCount = MaxBytes / Align;
+
+        static constexpr std::size_t classSize(std::size_t __index) { return (__index + 1) * Align; }
+    };
+
+    /**
+     * @brief 求 2 的幂 __n 的对数。
+    */
+    constexpr std::size_t __log2(std::size_t __n) { return (__n <= 1) ? 0 : 1 + __log2(__n >> 1); }
+
+    /**
+     * @brief 几何分级（类似 jemalloc）：前 Steps 个区块按 align 线性增长，
+     *        之后每翻一倍的区间 [2^k, 2^(k+1)) 再均分成 Steps 级，相邻两级的比例始终不超过 (1 + 1 / Steps)。
+     *
+     * @brief - 例如 __GeometricSizeClass<16, 4096>：
+     *          16，32，48，64，80，96，112，128，160，192，224，256，320，... ，3584，4096，共 28 条 free-list。
+     *
+     * @tparam Align      小型区块的上调边界
+     * @tparam MaxBytes   小型区块的上限，必须是 Align * Steps 的 2 的幂倍
+     * @tparam Steps      每翻一倍的区间内的级数，必须是 2 的幂
+    */
+    template <std::size_t Align, std::size_t MaxBytes, std::size_t Steps = 4>
+    struct __GeometricSizeClass
+    {
+        static constexpr std::size_t align      = Align;
+        static constexpr std::size_t maxBytes   = MaxBytes;
+        static constexpr std::size_t classCount = Steps + Steps * __log2(MaxBytes / (Align * Steps));
+
+        static constexpr std::size_t classSize(std::size_t __index)
+        {
+            if (__index < Steps) { return (__index + 1) * Align; }
+
+            const std::size_t group = (__index - Steps) / Steps;    // 位于第几个翻倍区间
+            const std::size_t step  = (__index - Steps) % Steps;    // 区间内的第几级
+            const std::size_t base  = (Align * Steps) << group;     // 区间的起点
+
+            return base + (step + 1) * (base / Steps);
+        }
+    };
+
+    /**
+     * @brief 编译期检查一个尺寸分级策略是否合法。
+    */
+    template <typename SizeClass>
+    constexpr bool __isValidSizeClass()
+    {
+        if (SizeClass::align < sizeof(void *) || (SizeClass::align & (SizeClass::align - 1)) != 0) { return false; }
+        if (SizeClass::classCount == 0) { return false; }
+        if (SizeClass::classSize(SizeClass::classCount - 1) != SizeClass::maxBytes) { return false; }
+
+        for (std::size_t index = 0; index < SizeClass::classCount; ++index)
+        {
+            if (SizeClass::classSize(index) % SizeClass::align != 0) { return false; }
+            if (index > 0 && SizeClass::classSize(index) <= SizeClass::classSize(index - 1)) { return false; }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief 生成每条 free-list 的区块大小表。
+    */
+    template <typename SizeClass>
+    constexpr std::array<std::size_t, SizeClass::classCount> __makeClassSizeTable()
+    {
+        std::array<std::size_t, SizeClass::classCount> table{};
+
+        for (std::size_t index = 0; index < SizeClass::classCount; ++index)
+        {
+            table[index] = SizeClass::classSize(index);
+        }
+
+        return table;
+    }
+
+    /**
+     * @brief 生成 “上调到 align 之后的字节数 / align” 到 free-list 下标的映射表，
+     *        第 i 项是区块大小不小于 i * align 的第一条 free-list（第 0 项与第 1 项相同）。
+    */
+    template <typename SizeClass>
+    constexpr std::array<std::uint16_t, SizeClass::maxBytes / SizeClass::align + 1> __makeClassIndexTable()
+    {
+        std::array<std::uint16_t, SizeClass::maxBytes / SizeClass::align + 1> table{};
+        std::size_t listIndex = 0;
+
+        for (std::size_t slot = 1; slot < table.size(); ++slot)
+        {
+            while (SizeClass::classSize(listIndex) < slot * SizeClass::align) { ++listIndex; }
+            table[slot] = (std::uint16_t)listIndex;
+        }
+        table[0] = table[1];
+
+        return table;
+    }
+}
+
+#endif // __SIZE_CLASS_POLICY_H_
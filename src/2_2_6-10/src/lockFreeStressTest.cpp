@@ -0,0 +1,164 @@
+#include "./include/defaultAllocTemplate.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    中央无锁 free-list 的压力测试（检测 ABA 问题）：
+
+    - 生产者线程不断申请小区块，在区块里写入 “线程号 + 序号” 的印记后交给消费者；
+    - 消费者线程校验印记完好后释放区块，区块进入消费者的线程缓存，再成批流回中央 free-list，
+      生产者的缓存耗尽时又从中央成批取回，这样两边会不断地释放对方申请的节点；
+    - 另有几个 “搅拌” 线程反复地小批量申请、释放并清空线程缓存，让中央栈顶被高频修改。
+
+    如果中央栈发生了 ABA，同一个区块会被同时交给两个持有者，
+    后写入的印记会覆盖先写入的印记，消费者或搅拌线程在校验时就会发现印记被篡改。
+*/
+
+using threadAlloc = SGIAllocator::__DefaultAllocTemplate<true, 2>;
+
+constexpr std::size_t BLOCK_SIZE      = 16;         // 区块大小，恰好放下两个印记字段
+std::size_t blocksEach                = 200000;     // 每个生产者产出的区块数（可由命令行参数指定）
+constexpr unsigned int PAIRS          = 4;          // 生产者 / 消费者对数
+constexpr unsigned int CHURNERS       = 2;          // 搅拌线程数
+
+struct Stamp
+{
+    std::size_t owner;      // 线程号
+    std::size_t sequence;   // 序号
+};
+
+/**
+ * @brief 生产者和消费者之间的简单队列。
+*/
+struct Channel
+{
+    std::mutex        lock;
+    std::deque<void *> blocks;
+    bool              closed = false;
+};
+
+std::atomic<std::size_t> corruptedCount{0};
+std::atomic<std::size_t> checkedCount{0};
+
+void producer(Channel & __channel, std::size_t __owner)
+{
+    for (std::size_t sequence = 0; sequence < blocksEach; ++sequence)
+    {
+        Stamp * block = (Stamp *)threadAlloc::allocate(BLOCK_SIZE);
+        *block = Stamp{__owner, sequence};
+
+        std::lock_guard<std::mutex> guard(__channel.lock);
+        __channel.blocks.push_back(block);
+    }
+
+    std::lock_guard<std::mutex> guard(__channel.lock);
+    __channel.closed = true;
+}
+
+void consumer(Channel & __channel, std::size_t __owner)
+{
+    std::size_t expected = 0;
+
+    while (true)
+    {
+        Stamp * block = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(__channel.lock);
+
+            if (!__channel.blocks.empty())
+            {
+                block = (Stamp *)__channel.blocks.front();
+                __channel.blocks.pop_front();
+            }
+            else if (__channel.closed) { break; }
+        }
+
+        if (block == nullptr) { std::this_thread::yield(); continue; }
+
+        /*印记必须正是生产者按顺序写入的那一个*/
+        if (block->owner != __owner || block->sequence != expected) { ++corruptedCount; }
+
+        ++expected;
+        ++checkedCount;
+
+        threadAlloc::deallocate(block, BLOCK_SIZE);
+    }
+
+    threadAlloc::flushThreadCache();
+}
+
+void churner(std::atomic<bool> & __stop, std::size_t __owner)
+{
+    Stamp * blocks[SGIAllocator::__THREAD_BATCH_NODES * 3];
+    std::size_t sequence = 0;
+
+    while (!__stop.load(std::memory_order_relaxed))
+    {
+        const std::size_t count = sizeof(blocks) / sizeof(blocks[0]);
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            blocks[index] = (Stamp *)threadAlloc::allocate(BLOCK_SIZE);
+            *blocks[index] = Stamp{__owner, sequence + index};
+        }
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            if (blocks[index]->owner != __owner || blocks[index]->sequence != sequence + index) { ++corruptedCount; }
+            ++checkedCount;
+
+            threadAlloc::deallocate(blocks[index], BLOCK_SIZE);
+        }
+
+        sequence += count;
+
+        /*把缓存全部推回中央，下一轮又要从中央摘取*/
+        threadAlloc::flushThreadCache();
+    }
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc > 1) { blocksEach = std::strtoull(argv[1], nullptr, 10); }
+
+    std::vector<Channel>     channels(PAIRS);
+    std::vector<std::thread> threads;
+    std::atomic<bool>        stopChurn{false};
+
+    for (unsigned int index = 0; index < CHURNERS; ++index)
+    {
+        threads.emplace_back(churner, std::ref(stopChurn), 1000 + index);
+    }
+
+    std::vector<std::thread> pairs;
+
+    for (unsigned int index = 0; index < PAIRS; ++index)
+    {
+        pairs.emplace_back(producer, std::ref(channels[index]), index);
+        pairs.emplace_back(consumer, std::ref(channels[index]), index);
+    }
+
+    for (std::thread & thread : pairs) { thread.join(); }
+
+    stopChurn = true;
+    for (std::thread & thread : threads) { thread.join(); }
+
+    printf("checked blocks   : %zu\n", checkedCount.load());
+    printf("corrupted blocks : %zu\n", corruptedCount.load());
+
+    if (corruptedCount != 0)
+    {
+        printf("FAILED: the same block was handed out twice (ABA on a central free-list).\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("PASSED\n");
+
+    return EXIT_SUCCESS;
+}
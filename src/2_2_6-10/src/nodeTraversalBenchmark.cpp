@@ -0,0 +1,85 @@
+#include "./include/defaultAllocTemplate.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+/*
+    不同 chunk 来源下的节点遍历延迟测试：
+    从内存池中申请大量 list / RB-Tree 大小的节点，按随机顺序把它们串成一张单向链表，然后反复沿链表遍历。
+    每一步都是一次无法预取的指针追逐，节点分散在几十 MiB 的内存中，
+    4 KiB 页下几乎每一步都会 TLB 未命中，2 MiB 透明大页能明显降低这部分延迟。
+*/
+
+using SGIAllocator::__MallocChunkSource;
+using SGIAllocator::__MmapChunkSource;
+using SGIAllocator::__HugePageChunkSource;
+
+/*与 MyList<int> / RB_Tree 的节点差不多大，并且落在默认的小型区块范围内*/
+struct Node
+{
+    Node * next;
+    long payload[7];
+};
+
+std::size_t nodeCount = 1 << 20;        // 节点数（可由命令行参数指定），默认共 64 MiB
+constexpr int PASSES  = 5;              // 遍历次数
+
+/**
+ * @brief 用 Alloc 申请 nodeCount 个节点，随机串链后遍历 PASSES 次，返回每个节点的平均访问延迟（纳秒）。
+*/
+template <typename Alloc>
+double traverseWith(void)
+{
+    std::vector<Node *> nodes(nodeCount);
+
+    for (Node * & node : nodes)
+    {
+        node = (Node *)Alloc::allocate(sizeof(Node));
+        node->payload[0] = 1;
+    }
+
+    std::vector<Node *> order(nodes);
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(2024));
+
+    for (std::size_t index = 0; index + 1 < order.size(); ++index) { order[index]->next = order[index + 1]; }
+    order.back()->next = nullptr;
+
+    long checksum = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int pass = 0; pass < PASSES; ++pass)
+    {
+        for (Node * node = order.front(); node != nullptr; node = node->next) { checksum += node->payload[0]; }
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    if (checksum != (long)nodeCount * PASSES) { printf("unexpected checksum %ld\n", checksum); }
+
+    for (Node * node : nodes) { Alloc::deallocate(node, sizeof(Node)); }
+    Alloc::releaseUnused();
+
+    return elapsed.count() / (double(nodeCount) * PASSES);
+}
+
+int main(int argc, char const *argv[])
+{
+    if (argc > 1) { nodeCount = std::strtoull(argv[1], nullptr, 10); }
+    if (nodeCount < 2) { nodeCount = 2; }
+
+    double mallocLatency   = traverseWith<SGIAllocator::__DefaultAllocTemplate<false, 40, SGIAllocator::__SGISizeClass, __MallocChunkSource>>();
+    double mmapLatency     = traverseWith<SGIAllocator::__DefaultAllocTemplate<false, 41, SGIAllocator::__SGISizeClass, __MmapChunkSource>>();
+    double hugePageLatency = traverseWith<SGIAllocator::__DefaultAllocTemplate<false, 42, SGIAllocator::__SGISizeClass, __HugePageChunkSource>>();
+
+    printf("%zu nodes of %zu bytes, %d passes\n", nodeCount, sizeof(Node), PASSES);
+    printf("chunk source   ns/node\n");
+    printf("%-14s %.2f\n", "malloc",    mallocLatency);
+    printf("%-14s %.2f\n", "mmap",      mmapLatency);
+    printf("%-14s %.2f\n", "huge page", hugePageLatency);
+
+    return EXIT_SUCCESS;
+}
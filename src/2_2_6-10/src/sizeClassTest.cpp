@@ -0,0 +1,74 @@
+#include "./include/defaultAllocTemplate.h"
+#include "../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/*
+    尺寸分级策略的测试：
+    对几种分级策略，逐字节地申请 1 ~ maxBytes 字节的区块，检查
+    - 区块按策略的 align 对齐；
+    - 写满整个区块不会越界（配合 -fsanitize=address 使用）；
+    - 释放后再次申请同样大小的区块，拿回的是刚刚释放的那一块（说明进出的是同一条 free-list）。
+*/
+
+using SGIAllocator::__LinearSizeClass;
+using SGIAllocator::__GeometricSizeClass;
+
+/*16 字节对齐，供 SSE 类型使用*/
+using sseSizeClass       = __LinearSizeClass<16, 256>;
+
+/*几何分级到 4 KiB，大一些的 RB-Tree、list 节点也能留在内存池里*/
+using geometricSizeClass = __GeometricSizeClass<16, 4096>;
+
+static_assert(geometricSizeClass::classCount == 28, "16, 32, ... , 3584, 4096");
+static_assert(geometricSizeClass::classSize(8) == 160 && geometricSizeClass::classSize(27) == 4096, "");
+
+/**
+ * @brief 用分级策略 SizeClass 具体化出的第二级配置器跑一遍上面的检查。
+*/
+template <bool Threads, int Inst, typename SizeClass>
+void checkSizeClass(const char * __name)
+{
+    using alloc = SGIAllocator::__DefaultAllocTemplate<Threads, Inst, SizeClass>;
+
+    std::vector<void *> blocks;
+
+    for (std::size_t bytes = 1; bytes <= SizeClass::maxBytes; ++bytes)
+    {
+        void * block = alloc::allocate(bytes);
+
+        CHECK((std::uintptr_t)block % SizeClass::align == 0);
+        std::memset(block, 0x5A, bytes);
+
+        alloc::deallocate(block, bytes);
+        CHECK(alloc::allocate(bytes) == block);
+
+        blocks.push_back(block);
+    }
+
+    for (std::size_t bytes = 1; bytes <= SizeClass::maxBytes; ++bytes)
+    {
+        alloc::deallocate(blocks[bytes - 1], bytes);
+    }
+
+    /*超过上限的区块交给第一级配置器*/
+    void * largeBlock = alloc::allocate(SizeClass::maxBytes + 1);
+    std::memset(largeBlock, 0x5A, SizeClass::maxBytes + 1);
+    alloc::deallocate(largeBlock, SizeClass::maxBytes + 1);
+
+    printf("%-24s %2zu free-lists, up to %4zu bytes: done\n", __name, SizeClass::classCount, SizeClass::maxBytes);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkSizeClass<false, 10, SGIAllocator::__SGISizeClass>("sgi (8, 128)");
+    checkSizeClass<false, 11, sseSizeClass>("linear (16, 256)");
+    checkSizeClass<false, 12, geometricSizeClass>("geometric (16, 4096)");
+    checkSizeClass<true,  13, geometricSizeClass>("geometric, threaded");
+
+    return testResult();
+}
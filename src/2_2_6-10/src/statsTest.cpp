@@ -0,0 +1,123 @@
+#include "./include/defaultAllocTemplate.h"
+#include "../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/*
+    统计信息测试：
+    在单线程和多线程模式下各跑一段已知的申请、释放序列，检查每一级的计数、存活区块数、
+    空闲区块字节数、内存池剩余空间与 heapSize 之间的关系，以及大区块转交第一级配置器的次数，
+    最后把统计表打印出来。编译时加上 -D__ALLOC_STATS_=0 可以看到计数全部关闭后的输出。
+*/
+
+using singleAlloc = SGIAllocator::__DefaultAllocTemplate<false, 30>;
+using threadAlloc = SGIAllocator::__DefaultAllocTemplate<true, 31>;
+
+/**
+ * @brief 每一级的空闲区块、存活区块与内存池剩余空间加起来，应当正好是内存池向系统申请的全部字节
+ *        （多线程模式下被舍弃的零头除外，这里只检查不超过）。
+*/
+template <typename Stats>
+std::size_t accountedBytes(const Stats & __stats)
+{
+    std::size_t bytes = __stats.poolRemainder;
+
+    for (const SGIAllocator::__SizeClassStats & sizeClass : __stats.sizeClasses)
+    {
+        bytes += (sizeClass.liveBlocks + sizeClass.freeBlocks) * sizeClass.blockSize;
+    }
+
+    return bytes;
+}
+
+void checkSingleThread(void)
+{
+    std::vector<void *> blocks;
+
+    for (int index = 0; index < 100; ++index) { blocks.push_back(singleAlloc::allocate(24)); }
+    for (int index = 0; index < 30; ++index) { singleAlloc::deallocate(blocks[index], 24); }
+
+    void * largeBlock = singleAlloc::allocate(1000);
+
+    auto stats = singleAlloc::getStats();
+    const SGIAllocator::__SizeClassStats & sizeClass = stats.sizeClasses[2];
+
+    CHECK(sizeClass.blockSize == 24);
+    CHECK(sizeClass.allocations == 100);
+    CHECK(sizeClass.deallocations == 30);
+    CHECK(sizeClass.liveBlocks == 70);
+    CHECK(sizeClass.refills == 5);                  // 每次补充 20 个
+    CHECK(sizeClass.freeBlocks == 30);
+    CHECK(stats.freeListBytes == 30 * 24);
+    CHECK(stats.largeAllocations == 1);
+    CHECK(accountedBytes(stats) == stats.heapSize);
+
+    singleAlloc::printStats();
+
+    singleAlloc::deallocate(largeBlock, 1000);
+    for (int index = 30; index < 100; ++index) { singleAlloc::deallocate(blocks[index], 24); }
+
+    stats = singleAlloc::getStats();
+    CHECK(stats.sizeClasses[2].liveBlocks == 0);
+    CHECK(stats.freeListBytes + stats.poolRemainder == stats.heapSize);
+
+    /*归还给系统之后，空闲区块随之减少*/
+    singleAlloc::releaseUnused();
+
+    stats = singleAlloc::getStats();
+    CHECK(stats.heapSize == 0 && stats.freeListBytes == 0 && stats.chunkCount == 0);
+}
+
+void checkThreaded(void)
+{
+    std::vector<std::thread> threads;
+
+    for (int index = 0; index < 4; ++index)
+    {
+        threads.emplace_back([]()
+        {
+            std::vector<void *> blocks;
+
+            for (int round = 0; round < 1000; ++round) { blocks.push_back(threadAlloc::allocate(48)); }
+            for (void * block : blocks) { threadAlloc::deallocate(block, 48); }
+        });     // 线程退出时缓存归还，计数也随之汇总
+    }
+
+    for (std::thread & thread : threads) { thread.join(); }
+
+    void * block = threadAlloc::allocate(48);
+
+    auto stats = threadAlloc::getStats();
+    const SGIAllocator::__SizeClassStats & sizeClass = stats.sizeClasses[5];
+
+    CHECK(sizeClass.blockSize == 48);
+    CHECK(sizeClass.allocations == 4001);
+    CHECK(sizeClass.deallocations == 4000);
+    CHECK(sizeClass.liveBlocks == 1);
+    CHECK(sizeClass.refills > 0);
+    CHECK(accountedBytes(stats) <= stats.heapSize);
+
+    threadAlloc::printStats();
+
+    threadAlloc::deallocate(block, 48);
+}
+
+int main(int argc, char const *argv[])
+{
+#if __ALLOC_STATS_
+    checkSingleThread();
+    checkThreaded();
+#else
+    singleAlloc::deallocate(singleAlloc::allocate(24), 24);
+    singleAlloc::printStats();
+#endif
+
+    SGIAllocator::__MallocAllocStats mallocStats = mallocAlloc::getStats();
+    printf("malloc allocs : %zu, frees : %zu, oomMalloc calls : %zu\n",
+           mallocStats.allocations, mallocStats.deallocations, mallocStats.oomMallocCalls);
+
+    return testResult();
+}
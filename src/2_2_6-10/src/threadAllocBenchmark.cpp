@@ -0,0 +1,90 @@
+#include "./include/defaultAllocTemplate.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/*
+    多线程模式下第二级配置器的吞吐量测试：
+    每个线程反复成批申请、释放 8 ~ 128 字节的小区块，统计不同线程数下每秒完成的 allocate/deallocate 次数，
+    线程缓存使得各线程几乎不竞争中央锁，吞吐量应随线程数（核心数）近似线性增长。
+*/
+
+using threadAlloc = SGIAllocator::__DefaultAllocTemplate<true, 1>;
+
+constexpr std::size_t ROUNDS       = 20000;    // 每个线程的轮数
+constexpr std::size_t BLOCKS_EACH  = 64;       // 每轮申请的区块数
+
+/**
+ * @brief 单个线程的工作：每轮申请 BLOCKS_EACH 个大小不一的小区块，然后全部释放。
+*/
+void worker(std::size_t __seed)
+{
+    void * blocks[BLOCKS_EACH];
+    std::size_t sizes[BLOCKS_EACH];
+
+    for (std::size_t index = 0; index < BLOCKS_EACH; ++index)
+    {
+        sizes[index] = ((__seed + index * 7) % SGIAllocator::__NFPREELISTS + 1) * SGIAllocator::__ALIGN;
+    }
+
+    for (std::size_t round = 0; round < ROUNDS; ++round)
+    {
+        for (std::size_t index = 0; index < BLOCKS_EACH; ++index)
+        {
+            blocks[index] = threadAlloc::allocate(sizes[index]);
+            *(char *)blocks[index] = (char)index;
+        }
+
+        for (std::size_t index = 0; index < BLOCKS_EACH; ++index)
+        {
+            threadAlloc::deallocate(blocks[index], sizes[index]);
+        }
+    }
+}
+
+/**
+ * @brief 用 __threadCount 个线程跑完 worker()，返回每秒操作数（一次 allocate 加一次 deallocate 记为 1 次）。
+*/
+double runWith(unsigned int __threadCount)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(__threadCount);
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (unsigned int index = 0; index < __threadCount; ++index)
+    {
+        threads.emplace_back(worker, index);
+    }
+
+    for (std::thread & thread : threads) { thread.join(); }
+
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - startTime;
+
+    return double(__threadCount) * ROUNDS * BLOCKS_EACH / seconds.count();
+}
+
+int main(int argc, char const *argv[])
+{
+    /*可以通过命令行参数指定最大线程数，默认为核心数*/
+    unsigned int maxThreads = (argc > 1) ? (unsigned int)std::atoi(argv[1]) : std::thread::hardware_concurrency();
+
+    if (maxThreads == 0) { maxThreads = 1; }
+
+    double singleThread = runWith(1);
+
+    printf("threads    ops/sec          speedup\n");
+    printf("%-10u %-16.0f %.2fx\n", 1u, singleThread, 1.0);
+
+    for (unsigned int threadCount = 2; threadCount <= maxThreads; threadCount *= 2)
+    {
+        double throughput = runWith(threadCount);
+
+        printf("%-10u %-16.0f %.2fx\n", threadCount, throughput, throughput / singleThread);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+#include "./include/defaultAllocTemplate.h"
+#include "../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/*
+    内存池归还测试：
+    1. 单线程模式下申请一大批小区块再全部释放，trim() 应当把这些 chunk 还给系统，之后还能照常申请；
+    2. 只释放一半区块时，仍有区块在使用的 chunk 不能被归还，留下的区块内容必须完好；
+    3. 多线程模式下几个线程各自申请、释放后退出，releaseUnused() 应当归还它们用过的 chunk；
+    4. 后台衰减线程应当在若干轮清点之后自动归还空闲的 chunk。
+*/
+
+using singleAlloc = SGIAllocator::__DefaultAllocTemplate<false, 20>;
+using threadAlloc = SGIAllocator::__DefaultAllocTemplate<true, 21>;
+using decayAlloc  = SGIAllocator::__DefaultAllocTemplate<true, 22>;
+
+constexpr std::size_t BLOCK_SIZE  = 64;
+constexpr std::size_t BLOCK_COUNT = 1 << 16;   // 共 4 MiB
+
+template <typename Alloc>
+std::vector<void *> allocateMany(std::size_t __count, char __fill)
+{
+    std::vector<void *> blocks(__count);
+
+    for (void * & block : blocks)
+    {
+        block = Alloc::allocate(BLOCK_SIZE);
+        std::memset(block, __fill, BLOCK_SIZE);
+    }
+
+    return blocks;
+}
+
+template <typename Alloc>
+void deallocateAll(const std::vector<void *> & __blocks)
+{
+    for (void * block : __blocks) { Alloc::deallocate(block, BLOCK_SIZE); }
+}
+
+void checkSingleThread(void)
+{
+    std::vector<void *> blocks = allocateMany<singleAlloc>(BLOCK_COUNT, 0x11);
+
+    CHECK(singleAlloc::trim() < BLOCK_SIZE * BLOCK_COUNT / 2);     // 全部在使用，没有 chunk 可以归还
+
+    deallocateAll<singleAlloc>(blocks);
+
+    std::size_t releasedBytes = singleAlloc::trim();
+    printf("single thread : released %zu bytes after freeing everything\n", releasedBytes);
+    CHECK(releasedBytes >= BLOCK_SIZE * BLOCK_COUNT);
+
+    /*归还之后照常申请*/
+    blocks = allocateMany<singleAlloc>(BLOCK_COUNT, 0x22);
+
+    /*只释放奇数号区块，每块 chunk 中都还有区块在使用*/
+    for (std::size_t index = 1; index < blocks.size(); index += 2) { singleAlloc::deallocate(blocks[index], BLOCK_SIZE); }
+
+    releasedBytes = singleAlloc::trim();
+    printf("single thread : released %zu bytes with every other block alive\n", releasedBytes);
+    CHECK(releasedBytes < BLOCK_SIZE * BLOCK_COUNT / 2);
+
+    for (std::size_t index = 0; index < blocks.size(); index += 2)
+    {
+        const char * bytes = (const char *)blocks[index];
+
+        CHECK(bytes[0] == 0x22 && bytes[BLOCK_SIZE - 1] == 0x22);
+        singleAlloc::deallocate(blocks[index], BLOCK_SIZE);
+    }
+
+    CHECK(singleAlloc::trim() >= BLOCK_SIZE * BLOCK_COUNT);
+}
+
+void checkThreaded(void)
+{
+    std::vector<std::thread> threads;
+
+    for (int index = 0; index < 4; ++index)
+    {
+        threads.emplace_back([]()
+        {
+            std::vector<void *> blocks = allocateMany<threadAlloc>(BLOCK_COUNT / 4, 0x33);
+            deallocateAll<threadAlloc>(blocks);
+        });     // 线程退出时缓存会自动归还给中央
+    }
+
+    for (std::thread & thread : threads) { thread.join(); }
+
+    std::size_t releasedBytes = threadAlloc::releaseUnused();
+    printf("threaded      : released %zu bytes after the workers exited\n", releasedBytes);
+    CHECK(releasedBytes >= BLOCK_SIZE * BLOCK_COUNT / 4);     // 线程可能先后运行、复用彼此归还的节点，至少是一个线程的用量
+    CHECK(threadAlloc::releaseUnused() == 0);
+
+    deallocateAll<threadAlloc>(allocateMany<threadAlloc>(1000, 0x44));
+}
+
+void checkDecay(void)
+{
+    deallocateAll<decayAlloc>(allocateMany<decayAlloc>(BLOCK_COUNT, 0x55));
+    decayAlloc::flushThreadCache();
+
+    decayAlloc::startDecay(std::chrono::milliseconds(10), 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    decayAlloc::stopDecay();
+
+    /*衰减线程已经把空闲的 chunk 都还掉了*/
+    std::size_t releasedBytes = decayAlloc::releaseUnused();
+    printf("decay         : %zu bytes left for releaseUnused()\n", releasedBytes);
+    CHECK(releasedBytes == 0);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkSingleThread();
+    checkThreaded();
+    checkDecay();
+
+    return testResult();
+}
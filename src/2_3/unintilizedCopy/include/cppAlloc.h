@@ -31,7 +31,20 @@ namespace CPP_ALLOC
             使用 ::operator new 能够在内存分配失败时抛出异常。这可以使函数获得异常安全的特性，如果分配失败，调用栈会被正确释放和回滚。
             此外 ::operator new 是 C++ 中的一个全局函数，它利用当前平台的内存分配机制来分配内存，使用它可以使代码在不同平台上都能正常工作。
         */
-        __Type *temp = (__Type *)(::operator new((std::size_t)(__size * sizeof(__Type))));
+        __Type *temp = nullptr;
+
+        /*
+            对齐要求超过 __STDCPP_DEFAULT_NEW_ALIGNMENT__ 的类型（alignas(64) 的计数器、AVX-512 向量等），
+            普通的 ::operator new 不保证对齐，要改用带 std::align_val_t 参数的版本。
+        */
+        if constexpr (alignof(__Type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            temp = (__Type *)(::operator new((std::size_t)(__size * sizeof(__Type)), std::align_val_t(alignof(__Type))));
+        }
+        else
+        {
+            temp = (__Type *)(::operator new((std::size_t)(__size * sizeof(__Type))));
+        }
 
         /*若 temp 为空指针，意味着当前的内存已经分无可分，就需要越过缓冲区往标准错误输出内存耗尽的消息，而后退出程序。*/
         if (temp == nullptr)
@@ -54,7 +67,34 @@ namespace CPP_ALLOC
      * @return non-return
      */
     template <typename __Type>
-    inline void __deallocate(__Type *__buffer) { ::operator delete(__buffer); }
+    inline void __deallocate(__Type *__buffer) 
+    { 
+        if constexpr (alignof(__Type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            ::operator delete(__buffer, std::align_val_t(alignof(__Type)));
+        }
+        else { ::operator delete(__buffer); }
+    }
+
+    /**
+     * @brief               释放 __allocate(__size, ...) 分配的内存，把大小一并交给 sized delete
+     *
+     * @tparam __Type       要释放的内存类型
+     *
+     * @param  __buffer     要释放的内存起始地址
+     * @param  __size       分配时的元素数量
+     *
+     * @return non-return
+     */
+    template <typename __Type>
+    inline void __deallocate(__Type *__buffer, std::ptrdiff_t __size)
+    {
+        if constexpr (alignof(__Type) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        {
+            ::operator delete(__buffer, (std::size_t)(__size * sizeof(__Type)), std::align_val_t(alignof(__Type)));
+        }
+        else { ::operator delete(__buffer, (std::size_t)(__size * sizeof(__Type))); }
+    }
 
     /**
      * @brief               利用 placement new 实现初始化（构建）已分配内存的功能
@@ -3,11 +3,28 @@
 
 #include "../../simple_allocator/simpleAlloc.h"
 #include "./deque_iterator.h"
+#include "./deque_algorithm.h"
+#include "./deque_policy.h"
 
+#include <array>
 #include <memory>
 #include <exception>
+#include <iterator>
+#include <type_traits>
 #include <initializer_list>
 
+/**
+ * @brief 只有（至少是）输入迭代器才参与区间版本的重载。
+*/
+template <typename Iterator>
+using __dequeRequireInputIterator = std::enable_if_t<
+    std::is_convertible<typename std::iterator_traits<Iterator>::iterator_category, std::input_iterator_tag>::value
+>;
+
+template <typename Iterator>
+struct __dequeIsForwardIterator
+    : std::is_convertible<typename std::iterator_traits<Iterator>::iterator_category, std::forward_iterator_tag> {};
+
 /**
  * @brief STL 双端队列的实现，
  *        双端队列（deque）是可以在容器的头尾以常数级复杂度 O(1) 进行出队和入队的容器。
@@ -16,15 +33,22 @@
  *          数组中的每一个元素都是指向了堆上一片连续内存空间（称作缓冲区）的指针。
  * 
  * @brief - SGI STL 的实现允许用户指定缓冲区大小（但是在现代 STL 版本中，这个模板参数被屏蔽），
- *          默认值为 0 意味着使用 512 个 Type 类型大小的缓冲区。
+ *          默认值为 0 意味着缓冲区的大小由 Policy 决定（默认一页，见 deque_policy.h）。
  * 
  * @tparam Type         双端队列内数据类型
- * @tparam BufferSize   缓冲区大小
+ * @tparam BufferSize   每个缓冲区的元素个数，0 表示由 Policy 决定
  * @tparam Alloc        分配器类型，默认为 `std::allocator<Type>`
+ * @tparam Policy       节点策略，决定缓冲区的字节数和 map 的扩张方式，默认为 `pageDequePolicy`
 */
-template <typename Type, std::size_t BufferSize = 0, typename Alloc = std::allocator<Type>>
-class My_Deque
+template <typename Type, std::size_t BufferSize = 0, typename Alloc = std::allocator<Type>, typename Policy = pageDequePolicy>
+class My_Deque : protected Simple_Alloc<Type, Alloc>
 {
+    public:
+        /**
+         * 每个缓冲区的元素个数。
+        */
+        static constexpr std::size_t node_elements = (BufferSize != 0) ? BufferSize : Policy::nodeElements(sizeof(Type));
+
     public:
         typedef Type                    value_type;
         typedef value_type *            pointer;
@@ -33,21 +57,23 @@ class My_Deque
 
         typedef std::size_t             size_type;
         typedef std::ptrdiff_t          difference_type;
+        typedef Alloc                   allocator_type;
     
     public:
-        typedef Deque_Iterator<Type, Type &, Type *, BufferSize>        iterator;
-        typedef const Deque_Iterator<Type, Type &, Type *, BufferSize>  const_iterator;
+        typedef Deque_Iterator<Type, Type &, Type *, node_elements>        iterator;
+        typedef const Deque_Iterator<Type, Type &, Type *, node_elements>  const_iterator;
 
     protected:
         typedef pointer *       map_pointer;
 
         /**
-         * deque 专属的空间配置器，每次配置一个 Type 类型的数据。
+         * deque 专属的空间配置器，每次配置一个 Type 类型的数据（分配器对象就保存在基类中）。
         */
         typedef Simple_Alloc<value_type, Alloc>  data_allocator;
 
         /**
-         * deque 专属的空间配置器，每次配置一个 Type * 类型的指针。
+         * deque 专属的空间配置器，每次配置一个 Type * 类型的指针，
+         * 用到时从 data_allocator 保存的分配器重绑定得到。
         */
         typedef Simple_Alloc<pointer, Alloc>      map_allocator;
 
@@ -62,6 +88,17 @@ class My_Deque
 
         size_type   map_size{0ULL};  // map 数组内可以容纳多少指针。
 
+        /**
+         * 空闲缓冲区的缓存（最多 Policy::spareNodes 个）。
+         * 
+         * deque 当作 FIFO 使用时（queue 就是这样使用底层容器的），pop_front() 每腾出一个缓冲区，
+         * 不久之后 push_back() 就要再申请一个，缓存让腾出的缓冲区直接被重用，不经过分配器。
+         * 同时 map 装满一端时，只要已用的节点不超过 map 的一半，reallocate_map() 只把节点指针挪回中间，
+         * 不重新分配 map，所以稳定状态下的生产者 / 消费者队列完全不申请内存。
+        */
+        std::array<pointer, Policy::spareNodes> spare_nodes{};
+        size_type                               spare_count{0ULL};
+
         enum { MININUM_NODES = 8 };
 
         /**
@@ -70,19 +107,50 @@ class My_Deque
         size_type initial_map_size() { return MININUM_NODES; }
 
         /**
-         * @brief 为 `map` 内的单个现用节点配置缓冲区。
+         * @brief 为 `map` 内的单个现用节点配置缓冲区，缓存中有空闲的缓冲区时直接取用。
         */
         pointer allocate_node() 
         {  
+            if (this->spare_count != 0) { return this->spare_nodes[--this->spare_count]; }
+
             return data_allocator::allocate(iterator::getBufferSize());
         }
 
         /**
-         * @brief 销毁单个 `map` 内节点所指的缓冲区。
+         * @brief 交还单个 `map` 内节点所指的缓冲区（其中的元素必须已经析构），
+         *        缓存未满时放进缓存，否则释放。
         */
         void deallocate_node(pointer __node) 
         {
-            data_allocator::deallocate(__node, iterator::getBufferSize());
+            if (this->spare_count < this->spare_nodes.size()) { this->spare_nodes[this->spare_count++] = __node; }
+            else { data_allocator::deallocate(__node, iterator::getBufferSize()); }
+        }
+
+        /**
+         * @brief 释放缓存中所有空闲的缓冲区。
+        */
+        void release_spare_nodes()
+        {
+            while (this->spare_count != 0)
+            {
+                data_allocator::deallocate(this->spare_nodes[--this->spare_count], iterator::getBufferSize());
+            }
+        }
+
+        /**
+         * @brief 配置一个可以容纳 `__n` 个节点的 `map`。
+        */
+        map_pointer allocate_map(size_type __n)
+        {
+            return map_allocator(this->getAllocator()).allocate(__n);
+        }
+
+        /**
+         * @brief 释放 `allocate_map()` 配置的 `map`。
+        */
+        void deallocate_map(map_pointer __map, size_type __n)
+        {
+            map_allocator(this->getAllocator()).deallocate(__map, __n);
         }
 
         /**
@@ -92,6 +160,21 @@ class My_Deque
         */
         void create_map_and_nodes(size_type __numElements);
 
+        /**
+         * @brief 辅助函数，析构所有元素，释放所有缓冲区和 `map`，
+         *        只在析构或者更换分配器之前调用。
+        */
+        void destroy_map_and_nodes(void)
+        {
+            this->clear();
+            this->deallocate_node(this->start.first);
+            this->release_spare_nodes();
+            this->deallocate_map(this->map, this->map_size);
+
+            this->map      = nullptr;
+            this->map_size = 0ULL;
+        }
+
         /**
          * @brief 辅助函数，负责产生和安排好 `deque` 的结构，并将元素的初值设定妥当。
          * 
@@ -109,17 +192,19 @@ class My_Deque
 
         /**
          * @brief 辅助函数，
-         *        在 `push_back()` 操作遭遇当前缓冲区容量不足的情况时，
-         *        需要移动到下一个缓冲区甚至重新分配一个 `map`，再将值构建到缓冲区中。
+         *        在 `emplace_back()` 操作遭遇当前缓冲区容量不足的情况时，
+         *        需要移动到下一个缓冲区甚至重新分配一个 `map`，再用 __args 将元素构建到缓冲区中。
         */
-        void push_back_aux(const value_type & __value);
-        
+        template <typename... Args>
+        void push_back_aux(Args &&... __args);
+
         /**
          * @brief 辅助函数，
-         *        在 `push_front()` 操作遭遇当前缓冲区容量不足的情况时，
-         *        需要移动到下一个缓冲区甚至重新分配一个 `map`，再将值构建到缓冲区中。
+         *        在 `emplace_front()` 操作遭遇当前缓冲区容量不足的情况时，
+         *        需要移动到下一个缓冲区甚至重新分配一个 `map`，再用 __args 将元素构建到缓冲区中。
         */
-        void push_front_aux(const value_type & __value);
+        template <typename... Args>
+        void push_front_aux(Args &&... __args);
 
         /**
          * @brief 辅助函数，
@@ -137,9 +222,10 @@ class My_Deque
 
         /**
          * @brief 辅助函数，
-         *        处理 `insert()` 函数指向非头尾插入的情况。
+         *        处理 `emplace()`、`insert()` 函数指向非头尾插入的情况。
         */
-        iterator insert_aux(iterator __pos, const value_type & __value);
+        template <typename... Args>
+        iterator insert_aux(iterator __pos, Args &&... __args);
 
         /**
          * @brief 辅助函数，
@@ -172,6 +258,95 @@ class My_Deque
             }
         }
 
+        /**
+         * @brief 辅助函数，在尾部一次性备好 `__newElements` 个元素所需的缓冲区（map 最多重新配置一次）。
+        */
+        void new_elements_at_back(size_type __newElements);
+
+        /**
+         * @brief 辅助函数，在头部一次性备好 `__newElements` 个元素所需的缓冲区（map 最多重新配置一次）。
+        */
+        void new_elements_at_front(size_type __newElements);
+
+        /**
+         * @brief 辅助函数，保证 `finish` 之后还能放下 `__n` 个元素。
+         * 
+         * @return 放下 `__n` 个元素之后新的 `finish`（此时尚未构造任何元素）
+        */
+        iterator reserve_elements_at_back(size_type __n)
+        {
+            size_type vacancies = (this->finish.last - this->finish.current) - 1;
+
+            if (__n > vacancies) { this->new_elements_at_back(__n - vacancies); }
+
+            return this->finish + difference_type(__n);
+        }
+
+        /**
+         * @brief 辅助函数，保证 `start` 之前还能放下 `__n` 个元素。
+         * 
+         * @return 放下 `__n` 个元素之后新的 `start`（此时尚未构造任何元素）
+        */
+        iterator reserve_elements_at_front(size_type __n)
+        {
+            size_type vacancies = this->start.current - this->start.first;
+
+            if (__n > vacancies) { this->new_elements_at_front(__n - vacancies); }
+
+            return this->start - difference_type(__n);
+        }
+
+        /**
+         * @brief 辅助函数，交还 `reserve_elements_at_back()` 备好但没有用上的缓冲区。
+        */
+        void destroy_nodes_at_back(iterator __newFinish)
+        {
+            for (map_pointer node = this->finish.node + 1; node <= __newFinish.node; ++node)
+            {
+                this->deallocate_node(*node);
+            }
+        }
+
+        /**
+         * @brief 辅助函数，交还 `reserve_elements_at_front()` 备好但没有用上的缓冲区。
+        */
+        void destroy_nodes_at_front(iterator __newStart)
+        {
+            for (map_pointer node = __newStart.node; node < this->start.node; ++node)
+            {
+                this->deallocate_node(*node);
+            }
+        }
+
+        /**
+         * @brief 辅助函数，逐个缓冲区析构 [__first, __last) 内的元素（不释放缓冲区）。
+        */
+        static void destroy_range(iterator __first, iterator __last)
+        {
+            if constexpr (!std::is_trivially_destructible<value_type>::value)
+            {
+                __dequeForEachSegment(__first, __last, [](pointer __begin, pointer __end) {
+                    std::destroy(__begin, __end);
+                    return true;
+                });
+            }
+        }
+
+        /**
+         * @brief 辅助函数，从 __first 开始取 __n 个元素，构造到 __result 开始的未初始化空间，
+         *        每个缓冲区只调用一次 `std::uninitialized_copy_n`。
+         *        构造途中抛出异常时，已经构造的元素全部析构。
+        */
+        template <typename ForwardIterator>
+        static void uninitialized_copy_n(ForwardIterator __first, size_type __n, iterator __result);
+
+        /**
+         * @brief 辅助函数，处理 `insert(__pos, __first, __last)` 在中间插入 __n 个元素的情况，
+         *        与单个元素的 `insert_aux()` 一样，只移动插入点前后较少的一边。
+        */
+        template <typename ForwardIterator>
+        iterator insert_aux(iterator __pos, ForwardIterator __first, ForwardIterator __last, size_type __n);
+
         /**
          * @brief 辅助函数，供 at() 进行边界检查。
         */
@@ -194,6 +369,8 @@ class My_Deque
             swap(__a.finish, __b.finish);
             swap(__a.map, __b.map);
             swap(__a.map_size, __b.map_size);
+            swap(__a.spare_nodes, __b.spare_nodes);
+            swap(__a.spare_count, __b.spare_count);
         }
     
     public:
@@ -201,13 +378,22 @@ class My_Deque
          * @brief 默认构造函数，在 map 中间处分配 1 个缓冲区，
          *        并使用容器类型的默认构造函数来填充缓冲区的值。
         */
-        My_Deque() { this->fill_initialize(0, Type()); }
+        My_Deque() { this->create_map_and_nodes(0); }
+
+        /**
+         * @brief 使用指定的分配器对象（比如一块 arena）构造空的 deque。
+        */
+        explicit My_Deque(const Alloc & __alloc) : data_allocator(__alloc) 
+        { 
+            this->create_map_and_nodes(0); 
+        }
 
         /**
          * @brief 构造函数，在 map 中间分配 n 个元素的内存，
          *        并全部构造值为 __value。
         */
-        My_Deque(size_type __n, const value_type & __value) : My_Deque()
+        My_Deque(size_type __n, const value_type & __value, const Alloc & __alloc = Alloc()) 
+            : data_allocator(__alloc)
         {
             this->fill_initialize(__n, __value);
         }
@@ -216,37 +402,102 @@ class My_Deque
          * @brief 构造函数，在 map 中间分配 __initList.size() 个元素的内存，
          *        并把初始化列表内的数据构造进容器。
         */
-        My_Deque(const std::initializer_list<value_type> __initList) : My_Deque()
+        My_Deque(const std::initializer_list<value_type> __initList, const Alloc & __alloc = Alloc()) 
+            : My_Deque(__alloc)
         {
             this->range_initialize(__initList.begin(), __initList.end());
         }
 
-        My_Deque(const My_Deque & __deque) : My_Deque()
+        /**
+         * @brief 拷贝构造函数，新 deque 的分配器由 select_on_container_copy_construction 决定。
+        */
+        My_Deque(const My_Deque & __deque) : My_Deque(allocator_type(__deque.selectOnCopy()))
+        {
+            this->range_initialize(__deque.begin(), __deque.end());
+        }
+
+        /**
+         * @brief 拷贝构造函数，使用指定的分配器。
+        */
+        My_Deque(const My_Deque & __deque, const Alloc & __alloc) : My_Deque(__alloc)
         {
             this->range_initialize(__deque.begin(), __deque.end());
         }
 
-        My_Deque(My_Deque && __deque) : My_Deque()
+        /**
+         * @brief 移动构造函数，分配器随缓冲区一起移动过来，`__deque` 留下一个空的 deque。
+        */
+        My_Deque(My_Deque && __deque) : My_Deque(allocator_type(__deque.getAllocator()))
         {
             this->swap(*this, __deque);
         }
 
+        /**
+         * @brief 移动构造函数，使用指定的分配器，与 `__deque` 的分配器不相等时只能逐个移动元素。
+        */
+        My_Deque(My_Deque && __deque, const Alloc & __alloc) : My_Deque(__alloc)
+        {
+            if (this->equalAllocator(__deque)) { this->swap(*this, __deque); }
+            else
+            {
+                this->range_initialize(std::make_move_iterator(__deque.begin()), std::make_move_iterator(__deque.end()));
+            }
+        }
+
+        /**
+         * @brief 拷贝赋值，分配器是否随之拷贝由 propagate_on_container_copy_assignment 决定。
+        */
         My_Deque & operator=(const My_Deque & __deque)
         {
             if (this != &__deque)
             {
-                this->fill_initialize(0, Type());
+                if (data_allocator::propagateOnCopyAssignment::value && !this->equalAllocator(__deque))
+                {
+                    /*旧的缓冲区和 map 只能由旧分配器释放*/
+                    this->destroy_map_and_nodes();
+                    this->copyAssignAllocator(__deque);
+                    this->create_map_and_nodes(0);
+                }
+                else
+                {
+                    this->clear();
+                    this->copyAssignAllocator(__deque);
+                }
+
                 this->range_initialize(__deque.begin(), __deque.end());
             }
 
             return *this;
         }
 
+        /**
+         * @brief 移动赋值。
+         * 
+         * @brief - 两个分配器相等时，直接交换双方的 map；
+         *          分配器会随之移动时，先用旧分配器释放自己的内存，再接管 `__deque` 的 map；
+         *          否则本容器的分配器无法释放 `__deque` 的内存，只能逐个移动元素。
+        */
         My_Deque & operator=(My_Deque && __deque)
         {
             if (this != &__deque)
             {
-                this->swap(*this, __deque);
+                if (this->equalAllocator(__deque))
+                {
+                    this->moveAssignAllocator(__deque);
+                    this->swap(*this, __deque);
+                }
+                else if (data_allocator::propagateOnMoveAssignment::value)
+                {
+                    this->destroy_map_and_nodes();
+                    this->moveAssignAllocator(__deque);
+                    this->create_map_and_nodes(0);
+                    this->swap(*this, __deque);
+                }
+                else
+                {
+                    this->clear();
+                    this->range_initialize(std::make_move_iterator(__deque.begin()), std::make_move_iterator(__deque.end()));
+                }
             }
 
             return *this;
@@ -258,13 +509,22 @@ class My_Deque
         */
         ~My_Deque() 
         {
-            if (!this->empty())
-            {
-                this->clear();
-                this->deallocate_node(this->start.first);
+            if (this->map != nullptr) { this->destroy_map_and_nodes(); }
+        }
 
-                delete[] this->map;
-            }
+        /**
+         * @brief 获取 deque 使用的分配器对象的副本。
+        */
+        allocator_type get_allocator() const { return allocator_type(this->getAllocator()); }
+
+        /**
+         * @brief 交换两个 deque 的内容，
+         *        分配器是否随之交换由 propagate_on_container_swap 决定（不交换时两个分配器必须相等）。
+        */
+        void swap(My_Deque & __deque) noexcept
+        {
+            this->swapAllocator(__deque);
+            this->swap(*this, __deque);
         }
 
         /**
@@ -360,9 +620,12 @@ class My_Deque
         bool empty() const { return (this->finish == this->start); }
 
         /**
-         * @brief 往容器末尾添加元素。
+         * @brief 用 __args 在容器末尾直接构造一个元素。
+         *
+         * @return 新元素的引用。
         */
-        void push_back(const value_type & __value)
+        template <typename... Args>
+        reference emplace_back(Args &&... __args)
         {
             /**
              * 当 finish 迭代器所指缓冲区还有空位之时，
@@ -370,23 +633,28 @@ class My_Deque
             */
             if (this->finish.current != this->finish.last - 1)
             {
-                std::_Construct(this->finish.current, __value);
+                std::_Construct(this->finish.current, std::forward<Args>(__args)...);
                 ++this->finish.current;
             }
             else
-            { 
+            {
                 /**
-                 * 否则就要调用 push_back_aux() 重新在 
+                 * 否则就要调用 push_back_aux() 重新在
                  * *(finish.node + 1) 处配置一个新的缓冲区来存放新数据。
                 */
-                this->push_back_aux(__value); 
+                this->push_back_aux(std::forward<Args>(__args)...);
             }
+
+            return this->back();
         }
 
         /**
-         * @brief 往容器开头添加元素
+         * @brief 用 __args 在容器开头直接构造一个元素。
+         *
+         * @return 新元素的引用。
         */
-        void push_front(const value_type & __value)
+        template <typename... Args>
+        reference emplace_front(Args &&... __args)
         {
             /**
              * 当 start 迭代器所指缓冲区还有空位之时，
@@ -394,19 +662,33 @@ class My_Deque
             */
             if (this->start.current != this->start.first)
             {
-                std::_Construct(this->start.current - 1, __value);
+                std::_Construct(this->start.current - 1, std::forward<Args>(__args)...);
                 --this->start.current;
             }
-            else 
-            { 
+            else
+            {
                 /**
-                 * 否则就要调用 push_back_aux() 重新在 
+                 * 否则就要调用 push_front_aux() 重新在
                  * *(start.node - 1) 处配置一个新的缓冲区来存放新数据。
                 */
-                this->push_front_aux(__value); 
+                this->push_front_aux(std::forward<Args>(__args)...);
             }
+
+            return this->front();
         }
 
+        /**
+         * @brief 往容器末尾添加元素。
+        */
+        void push_back(const value_type & __value) { this->emplace_back(__value); }
+        void push_back(value_type && __value) { this->emplace_back(std::move(__value)); }
+
+        /**
+         * @brief 往容器开头添加元素
+        */
+        void push_front(const value_type & __value) { this->emplace_front(__value); }
+        void push_front(value_type && __value) { this->emplace_front(std::move(__value)); }
+
         /**
          * @brief 删除容器开头的第一个元素。
         */
@@ -441,6 +723,65 @@ class My_Deque
             }
         }
 
+        /**
+         * @brief 删除容器开头的 __n 个元素（不足 __n 个时清空容器），
+         *        腾出的缓冲区整个交还，不再逐个元素判断是否到了缓冲区末尾。
+        */
+        void pop_front(size_type __n)
+        {
+            if (__n >= this->size()) { this->clear(); return; }
+
+            iterator newStart = this->start + difference_type(__n);
+            this->destroy_range(this->start, newStart);
+
+            for (map_pointer node = this->start.node; node < newStart.node; ++node)
+            {
+                this->deallocate_node(*node);
+            }
+
+            this->start = newStart;
+        }
+
+        /**
+         * @brief 删除容器末尾的 __n 个元素（不足 __n 个时清空容器），
+         *        腾出的缓冲区整个交还。
+        */
+        void pop_back(size_type __n)
+        {
+            if (__n >= this->size()) { this->clear(); return; }
+
+            iterator newFinish = this->finish - difference_type(__n);
+            this->destroy_range(newFinish, this->finish);
+
+            for (map_pointer node = newFinish.node + 1; node <= this->finish.node; ++node)
+            {
+                this->deallocate_node(*node);
+            }
+
+            this->finish = newFinish;
+        }
+
+        /**
+         * @brief 把 [__first, __last) 内的元素依次追加到容器末尾。
+         * 
+         * @brief - 前向迭代器先算出元素个数，一次备好所有缓冲区（map 最多重新配置一次），
+         *          再逐个缓冲区地调用 `std::uninitialized_copy_n`；构造途中抛出异常时容器保持原样。
+         *          单趟的输入迭代器只能逐个 push_back()。
+        */
+        template <typename InputIterator, typename = __dequeRequireInputIterator<InputIterator>>
+        void append(InputIterator __first, InputIterator __last);
+
+        /**
+         * @brief 把 [__first, __last) 内的元素插入到容器开头（保持原来的顺序），做法同 `append()`。
+        */
+        template <typename InputIterator, typename = __dequeRequireInputIterator<InputIterator>>
+        void prepend(InputIterator __first, InputIterator __last);
+
+        /**
+         * @brief 释放缓存中空闲的缓冲区（元素与 map 保持不变）。
+        */
+        void shrink_to_fit() { this->release_spare_nodes(); }
+
         /**
          * @brief 清空整个 deque，但要保留 map 中的第一个节点。
         */
@@ -469,7 +810,7 @@ class My_Deque
             */
             if (index < (this->size() >> 1))
             {
-                std::copy_backward(this->start, __pos, next);
+                __dequeMoveBackward(this->start, __pos, next);
                 this->pop_front();
             }
             /**
@@ -478,7 +819,7 @@ class My_Deque
             */
             else
             {
-                std::copy(next, this->finish, __pos);
+                __dequeMove(next, this->finish, __pos);
                 this->pop_back();
             }
 
@@ -506,26 +847,26 @@ class My_Deque
                 */
                 if (element_before < (this->size() - n) >> 1)
                 {
-                    std::copy_backward(this->start, __first, __last);
+                    __dequeMoveBackward(this->start, __first, __last);
                     iterator newStart = this->start + n;
                     std::destroy(this->start, newStart);
 
                     for (map_pointer cur = this->start.node; cur < newStart.node; ++cur)
                     {
-                        data_allocator::deallocate(*cur, iterator::getBufferSize());
+                        this->deallocate_node(*cur);
                     }
 
                     this->start = newStart;
                 }
                 else // 若 清除区间后方的元素数 较少
                 {
-                    std::copy(__last, this->finish, __first);
+                    __dequeMove(__last, this->finish, __first);
                     iterator newFinish = this->finish - n;
                     std::destroy(newFinish, this->finish);
 
-                    for (map_pointer cur = this->finish.node; cur < newFinish.node; ++cur)
+                    for (map_pointer cur = newFinish.node + 1; cur <= this->finish.node; ++cur)
                     {
-                        data_allocator::deallocate(*cur, iterator::getBufferSize());
+                        this->deallocate_node(*cur);
                     }
 
                     this->finish = newFinish;
@@ -536,32 +877,79 @@ class My_Deque
         }
 
         /**
-         * @brief 往迭代器 __pos 之前插入一个元素 __value。
-         * 
-         * @return 插入完成后 __value 所在位置的迭代器。
+         * @brief 用 __args 在迭代器 __pos 之前构造一个元素。
+         *
+         * @return 新元素所在位置的迭代器。
         */
-        iterator insert(iterator __pos, const value_type & __value)
+        template <typename... Args>
+        iterator emplace(iterator __pos, Args &&... __args)
         {
-            if (this->start == __pos) 
-            {  
-                this->push_front(__value);
+            if (this->start == __pos)
+            {
+                this->emplace_front(std::forward<Args>(__args)...);
                 return this->start;
             }
             else if (this->finish == __pos)
             {
-                this->push_back(__value);
+                this->emplace_back(std::forward<Args>(__args)...);
                 iterator tempFinish = this->finish;
                 return (--tempFinish);
             }
             else
             {
-                return this->insert_aux(__pos, __value);
+                return this->insert_aux(__pos, std::forward<Args>(__args)...);
             }
         }
+
+        /**
+         * @brief 往迭代器 __pos 之前插入一个元素 __value。
+         *
+         * @return 插入完成后 __value 所在位置的迭代器。
+        */
+        iterator insert(iterator __pos, const value_type & __value) { return this->emplace(__pos, __value); }
+        iterator insert(iterator __pos, value_type && __value) { return this->emplace(__pos, std::move(__value)); }
+
+        /**
+         * @brief 往迭代器 __pos 之前插入 [__first, __last) 内的元素。
+         * 
+         * @brief - 插入点在头尾时交给 `prepend()` / `append()`；
+         *          在中间时一次备好所需的缓冲区，只移动插入点前后较少的一边。
+         * 
+         * @return 指向第一个新元素的迭代器。
+        */
+        template <typename InputIterator, typename = __dequeRequireInputIterator<InputIterator>>
+        iterator insert(iterator __pos, InputIterator __first, InputIterator __last)
+        {
+            const difference_type index = __pos - this->start;
+
+            if (__pos == this->start) { this->prepend(__first, __last); }
+            else if (__pos == this->finish) { this->append(__first, __last); }
+            else if constexpr (__dequeIsForwardIterator<InputIterator>::value)
+            {
+                const size_type n = size_type(std::distance(__first, __last));
+
+                if (n != 0) { this->insert_aux(__pos, __first, __last, n); }
+            }
+            else
+            {
+                /*单趟的输入迭代器先收集到临时的 deque 里，再按前向迭代器插入*/
+                My_Deque temp(this->getAllocator());
+                temp.append(__first, __last);
+
+                this->insert_aux(__pos, temp.begin(), temp.end(), temp.size());
+            }
+
+            return this->start + index;
+        }
+
+        iterator insert(iterator __pos, std::initializer_list<value_type> __initList)
+        {
+            return this->insert(__pos, __initList.begin(), __initList.end());
+        }
 };
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-void My_Deque<Type, BufferSize, Alloc>::create_map_and_nodes(size_type __numElements)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+void My_Deque<Type, BufferSize, Alloc, Policy>::create_map_and_nodes(size_type __numElements)
 {
     /**
      * 需要的节点数 = 需要创建的元素数 / 缓冲区可容纳的元素数 + 1
@@ -577,7 +965,7 @@ void My_Deque<Type, BufferSize, Alloc>::create_map_and_nodes(size_type __numElem
     /**
      * 在 map 上配置 map_size 个节点。
     */
-    this->map = map_allocator::allocate(this->map_size);
+    this->map = this->allocate_map(this->map_size);
 
     map_pointer nStart  = this->map + (this->map_size - nodesCount) / 2;
     map_pointer nFinish = nStart + nodesCount - 1;
@@ -594,11 +982,15 @@ void My_Deque<Type, BufferSize, Alloc>::create_map_and_nodes(size_type __numElem
     {
         map_pointer tempStart = nStart;
 
-        for (tempStart; tempStart <= nCurrent; ++tempStart)
+        for (; tempStart < nCurrent; ++tempStart)
         {
             this->deallocate_node(*tempStart);
         }
 
+        this->deallocate_map(this->map, this->map_size);
+        this->map      = nullptr;
+        this->map_size = 0ULL;
+
         throw;
     }
 
@@ -608,8 +1000,8 @@ void My_Deque<Type, BufferSize, Alloc>::create_map_and_nodes(size_type __numElem
     finish.current = finish.first + __numElements % iterator::getBufferSize();
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-void My_Deque<Type, BufferSize, Alloc>::fill_initialize(size_type __n, const value_type & __value)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+void My_Deque<Type, BufferSize, Alloc, Policy>::fill_initialize(size_type __n, const value_type & __value)
 {
     this->create_map_and_nodes(__n);
     
@@ -639,26 +1031,186 @@ void My_Deque<Type, BufferSize, Alloc>::fill_initialize(size_type __n, const val
     }
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+template <typename ForwardIterator>
+void My_Deque<Type, BufferSize, Alloc, Policy>::range_initialize(ForwardIterator __first, ForwardIterator __last)
+{
+    /**
+     * append() 对前向迭代器一次备好所有缓冲区，构造失败时容器保持原样（空的）。
+    */
+    this->append(__first, __last);
+}
+
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+void My_Deque<Type, BufferSize, Alloc, Policy>::new_elements_at_back(size_type __newElements)
+{
+    size_type newNodes = (__newElements + iterator::getBufferSize() - 1) / iterator::getBufferSize();
+
+    this->reserve_map_at_back(newNodes);
+
+    size_type index;
+
+    try
+    {
+        for (index = 1; index <= newNodes; ++index)
+        {
+            *(this->finish.node + index) = this->allocate_node();
+        }
+    }
+    catch (...)
+    {
+        for (size_type done = 1; done < index; ++done)
+        {
+            this->deallocate_node(*(this->finish.node + done));
+        }
+
+        throw;
+    }
+}
+
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+void My_Deque<Type, BufferSize, Alloc, Policy>::new_elements_at_front(size_type __newElements)
+{
+    size_type newNodes = (__newElements + iterator::getBufferSize() - 1) / iterator::getBufferSize();
+
+    this->reserve_map_at_front(newNodes);
+
+    size_type index;
+
+    try
+    {
+        for (index = 1; index <= newNodes; ++index)
+        {
+            *(this->start.node - index) = this->allocate_node();
+        }
+    }
+    catch (...)
+    {
+        for (size_type done = 1; done < index; ++done)
+        {
+            this->deallocate_node(*(this->start.node - done));
+        }
+
+        throw;
+    }
+}
+
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
 template <typename ForwardIterator>
-void My_Deque<Type, BufferSize, Alloc>::range_initialize(ForwardIterator __first, ForwardIterator __last)
+void My_Deque<Type, BufferSize, Alloc, Policy>::uninitialized_copy_n(ForwardIterator __first, size_type __n, iterator __result)
 {
+    pointer current  = __result.current;
+    map_pointer node = __result.node;
+    pointer last     = __result.last;
+
     try
     {
-        for (; __first != __last; ++__first)
+        /**
+         * 逐个缓冲区构造，每个缓冲区只调用一次 std::uninitialized_copy_n（它自己负责回滚本段）。
+        */
+        while (__n != 0)
         {
-            this->push_back(*__first);
+            size_type chunk = std::min(__n, size_type(last - current));
+
+            std::uninitialized_copy_n(__first, chunk, current);
+            std::advance(__first, chunk);
+
+            __n -= chunk;
+
+            if (__n != 0)
+            {
+                ++node;
+                current = *node;
+                last    = current + iterator::getBufferSize();
+            }
+            else { current += chunk; }
         }
     }
     catch (...)
     {
-        this->clear();
+        /*析构之前几个缓冲区里已经构造好的元素*/
+        iterator done;
+        done.setNode(node);
+        done.current = current;
+
+        destroy_range(__result, done);
+
         throw;
     }
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-void My_Deque<Type, BufferSize, Alloc>::reallocate_map(size_type __nodesToAdd, bool __addAtFront)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+template <typename InputIterator, typename>
+void My_Deque<Type, BufferSize, Alloc, Policy>::append(InputIterator __first, InputIterator __last)
+{
+    if constexpr (__dequeIsForwardIterator<InputIterator>::value)
+    {
+        const size_type n = size_type(std::distance(__first, __last));
+
+        iterator newFinish = this->reserve_elements_at_back(n);
+
+        try
+        {
+            this->uninitialized_copy_n(__first, n, this->finish);
+        }
+        catch (...)
+        {
+            this->destroy_nodes_at_back(newFinish);
+            throw;
+        }
+
+        this->finish = newFinish;
+    }
+    else
+    {
+        const size_type oldSize = this->size();
+
+        try
+        {
+            for (; __first != __last; ++__first) { this->push_back(*__first); }
+        }
+        catch (...)
+        {
+            this->pop_back(this->size() - oldSize);
+            throw;
+        }
+    }
+}
+
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+template <typename InputIterator, typename>
+void My_Deque<Type, BufferSize, Alloc, Policy>::prepend(InputIterator __first, InputIterator __last)
+{
+    if constexpr (__dequeIsForwardIterator<InputIterator>::value)
+    {
+        const size_type n = size_type(std::distance(__first, __last));
+
+        iterator newStart = this->reserve_elements_at_front(n);
+
+        try
+        {
+            this->uninitialized_copy_n(__first, n, newStart);
+        }
+        catch (...)
+        {
+            this->destroy_nodes_at_front(newStart);
+            throw;
+        }
+
+        this->start = newStart;
+    }
+    else
+    {
+        /*逐个 push_front() 会把顺序颠倒，先收集到临时的 deque 里*/
+        My_Deque temp(this->getAllocator());
+        temp.append(__first, __last);
+
+        this->prepend(temp.begin(), temp.end());
+    }
+}
+
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+void My_Deque<Type, BufferSize, Alloc, Policy>::reallocate_map(size_type __nodesToAdd, bool __addAtFront)
 {
     size_type oldNodesCount = this->finish.node - this->start.node + 1;
     size_type newNodesCount = oldNodesCount + __nodesToAdd;
@@ -681,15 +1233,15 @@ void My_Deque<Type, BufferSize, Alloc>::reallocate_map(size_type __nodesToAdd, b
     }
     else
     {
-        size_type newMapSize = this->map_size + std::max(this->map_size, __nodesToAdd) + 2;
-        map_pointer newMap = map_allocator::allocate(newMapSize);
+        size_type newMapSize = Policy::nextMapSize(this->map_size, __nodesToAdd);
+        map_pointer newMap = this->allocate_map(newMapSize);
 
         newNStart = newMap + (newMapSize - newNodesCount) / 2 +
                     (__addAtFront ? __nodesToAdd : 0);
         
         std::copy(this->start.node, this->finish.node + 1, newNStart);
 
-        delete[] this->map;
+        this->deallocate_map(this->map, this->map_size);
 
         this->map = newMap;
         this->map_size = newMapSize;
@@ -699,37 +1251,37 @@ void My_Deque<Type, BufferSize, Alloc>::reallocate_map(size_type __nodesToAdd, b
     this->finish.setNode(newNStart + oldNodesCount - 1);
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-void My_Deque<Type, BufferSize, Alloc>::push_front_aux(const value_type & __value)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+template <typename... Args>
+void My_Deque<Type, BufferSize, Alloc, Policy>::push_front_aux(Args &&... __args)
 {
-    value_type valueCopy = __value;
-
+    /**
+     * 配置新节点、重新配置 map 都只挪动缓冲区指针，不挪动元素，
+     * 所以 __args 引用容器内的元素也没关系，不必像 SGI 原版那样先拷贝一份。
+    */
     this->reserve_map_at_front();
 
     *(this->start.node - 1) = this->allocate_node();
 
     try
     {
-        this->start.setNode(this->start.node - 1);
-        this->start.current = start.last - 1;
-
-        std::_Construct(this->start.current, valueCopy);
+        std::_Construct(*(this->start.node - 1) + iterator::getBufferSize() - 1, std::forward<Args>(__args)...);
     }
     catch (...)
     {
-        this->start.setNode(this->start.node + 1);
-        this->start.current = this->start.first;
         this->deallocate_node(*(this->start.node - 1));
 
         throw;
     }
+
+    this->start.setNode(this->start.node - 1);
+    this->start.current = this->start.last - 1;
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-void My_Deque<Type, BufferSize, Alloc>::push_back_aux(const value_type & __value)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+template <typename... Args>
+void My_Deque<Type, BufferSize, Alloc, Policy>::push_back_aux(Args &&... __args)
 {
-    value_type valueCopy = __value;
-
     this->reserve_map_at_back();
 
     /**
@@ -743,11 +1295,11 @@ void My_Deque<Type, BufferSize, Alloc>::push_back_aux(const value_type & __value
     */
     try
     {
-        std::_Construct(this->finish.current, valueCopy);
+        std::_Construct(this->finish.current, std::forward<Args>(__args)...);
         this->finish.setNode(this->finish.node + 1);
         this->finish.current = this->finish.first;
     }
-    catch (...) 
+    catch (...)
     {
         this->deallocate_node(*(this->finish.node + 1));
 
@@ -755,8 +1307,8 @@ void My_Deque<Type, BufferSize, Alloc>::push_back_aux(const value_type & __value
     }
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-void My_Deque<Type, BufferSize, Alloc>::pop_back_aux(void)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+void My_Deque<Type, BufferSize, Alloc, Policy>::pop_back_aux(void)
 {
     /**
      * 1. 释放掉迭代器 finish 所指的整个缓冲区。
@@ -773,8 +1325,8 @@ void My_Deque<Type, BufferSize, Alloc>::pop_back_aux(void)
     std::destroy_at(this->finish.current);
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-void My_Deque<Type, BufferSize, Alloc>::pop_front_aux(void)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+void My_Deque<Type, BufferSize, Alloc, Policy>::pop_front_aux(void)
 {
     /**
      * 1. 析构掉迭代器 start 所指的现行元素。
@@ -791,8 +1343,8 @@ void My_Deque<Type, BufferSize, Alloc>::pop_front_aux(void)
     this->start.current = this->start.first;
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-void My_Deque<Type, BufferSize, Alloc>::clear(void)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+void My_Deque<Type, BufferSize, Alloc, Policy>::clear(void)
 {
     /**
      * 先析构和释放 map 中除头尾节点外的节点数据。
@@ -800,7 +1352,7 @@ void My_Deque<Type, BufferSize, Alloc>::clear(void)
     for (map_pointer node = this->start.node + 1; node < this->finish.node; ++node)
     {
         std::destroy(*node, *node + iterator::getBufferSize());
-        data_allocator::deallocate(*node, iterator::getBufferSize());
+        this->deallocate_node(*node);
     }
 
     /**
@@ -811,7 +1363,7 @@ void My_Deque<Type, BufferSize, Alloc>::clear(void)
     {
         std::destroy(this->start.current, this->start.last);
         std::destroy(this->finish.first, this->finish.current);
-        data_allocator::deallocate(this->finish.first, iterator::getBufferSize());
+        this->deallocate_node(this->finish.first);
     }
     else    // 处理只有一个迭代器的结果
     {
@@ -821,20 +1373,25 @@ void My_Deque<Type, BufferSize, Alloc>::clear(void)
     this->finish = this->start; // 调整首尾迭代器
 }
 
-template <typename Type, std::size_t BufferSize, typename Alloc>
-typename My_Deque<Type, BufferSize, Alloc>::iterator 
-My_Deque<Type, BufferSize, Alloc>::insert_aux(iterator __pos, const value_type & __value)
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+template <typename... Args>
+typename My_Deque<Type, BufferSize, Alloc, Policy>::iterator 
+My_Deque<Type, BufferSize, Alloc, Policy>::insert_aux(iterator __pos, Args &&... __args)
 {
     difference_type index = __pos - this->start;    // 计算插入点 __pos 之前的元素数。
-    value_type valueCopy = __value;
+
+    /**
+     * 先构造出新元素，__args 可能引用容器内即将被挪动的元素。
+    */
+    value_type valueCopy(std::forward<Args>(__args)...);
 
     if (index < (this->size() >> 1))    // 若插入点之前的元素较少
     {
         /**
-         * 调用 push_front 将当前容器内第一个元素的值插入，
+         * 调用 emplace_front 将当前容器内第一个元素移动到新位置，
          * 这通常会触发 push_front_aux() 甚至 reserve_map_at_front() 操作，往前面增加缓冲区。
         */
-        this->push_front(this->front());
+        this->emplace_front(std::move(this->front()));
 
         /**
          * 创建两个迭代器 front_1 和 front_2，用于标记。
@@ -846,16 +1403,16 @@ My_Deque<Type, BufferSize, Alloc>::insert_aux(iterator __pos, const value_type &
         __pos = this->start + index;
         iterator pos_1 = __pos; ++pos_1;
 
-        std::copy(front_2, pos_1, front_1);
+        __dequeMove(front_2, pos_1, front_1);
     }
     else
     {
         /**
-         * 调用 push_back 将当前容器内第一个元素的值插入，
+         * 调用 emplace_back 将当前容器内最后一个元素移动到新位置，
          * 这通常会触发 push_back_aux() 
          * 甚至 reserve_map_at_back() 操作，往后面增加缓冲区。
         */
-        this->push_back(this->back());
+        this->emplace_back(std::move(this->back()));
 
         /**
          * 创建两个迭代器 back_1 和 back_2，用于标记。
@@ -865,12 +1422,137 @@ My_Deque<Type, BufferSize, Alloc>::insert_aux(iterator __pos, const value_type &
 
         __pos = start + index;
         
-        //执行反向拷贝操作。
-        std::copy_backward(__pos, back_2, back_1);
+        //执行反向移动操作。
+        __dequeMoveBackward(__pos, back_2, back_1);
     }
 
-    *__pos = valueCopy;
+    *__pos = std::move(valueCopy);
     return __pos;
 }
 
+template <typename Type, std::size_t BufferSize, typename Alloc, typename Policy>
+template <typename ForwardIterator>
+typename My_Deque<Type, BufferSize, Alloc, Policy>::iterator 
+My_Deque<Type, BufferSize, Alloc, Policy>::insert_aux(iterator __pos, ForwardIterator __first, ForwardIterator __last, size_type __n)
+{
+    const difference_type elemsBefore = __pos - this->start;    // 插入点之前的元素数
+    const size_type       length      = this->size();
+
+    if (elemsBefore < difference_type(length / 2))    // 插入点之前的元素较少，往前挪
+    {
+        iterator newStart = this->reserve_elements_at_front(__n);
+        iterator oldStart = this->start;
+
+        /*备缓冲区时 map 可能重新配置过，重新定位插入点*/
+        __pos = this->start + elemsBefore;
+
+        try
+        {
+            if (elemsBefore >= difference_type(__n))
+            {
+                /**
+                 * 前 __n 个元素构造到新空间，剩下的 [startN, __pos) 整体前移 __n 个位置，
+                 * 空出来的 [__pos - __n, __pos) 赋值为新元素。
+                */
+                iterator startN = this->start + difference_type(__n);
+
+                this->uninitialized_copy_n(std::make_move_iterator(this->start), __n, newStart);
+                this->start = newStart;
+
+                __dequeMove(startN, __pos, oldStart);
+                __dequeCopy(__first, __last, __pos - difference_type(__n));
+            }
+            else
+            {
+                /**
+                 * 插入点之前的元素全部构造到新空间，紧接着构造前 (__n - elemsBefore) 个新元素，
+                 * 剩下的新元素赋值到原来的 [oldStart, __pos)。
+                */
+                ForwardIterator middle = __first;
+                std::advance(middle, difference_type(__n) - elemsBefore);
+
+                this->uninitialized_copy_n(std::make_move_iterator(this->start), size_type(elemsBefore), newStart);
+
+                try
+                {
+                    this->uninitialized_copy_n(__first, __n - size_type(elemsBefore), newStart + elemsBefore);
+                }
+                catch (...)
+                {
+                    destroy_range(newStart, newStart + elemsBefore);
+                    throw;
+                }
+
+                this->start = newStart;
+
+                __dequeCopy(middle, __last, oldStart);
+            }
+        }
+        catch (...)
+        {
+            this->destroy_nodes_at_front(newStart);
+            throw;
+        }
+    }
+    else    // 插入点之后的元素较少，往后挪
+    {
+        iterator newFinish = this->reserve_elements_at_back(__n);
+        iterator oldFinish = this->finish;
+
+        const difference_type elemsAfter = difference_type(length) - elemsBefore;
+
+        __pos = this->finish - elemsAfter;
+
+        try
+        {
+            if (elemsAfter > difference_type(__n))
+            {
+                /**
+                 * 最后 __n 个元素构造到新空间，剩下的 [__pos, finishN) 整体后移 __n 个位置，
+                 * 空出来的 [__pos, __pos + __n) 赋值为新元素。
+                */
+                iterator finishN = this->finish - difference_type(__n);
+
+                this->uninitialized_copy_n(std::make_move_iterator(finishN), __n, this->finish);
+                this->finish = newFinish;
+
+                __dequeMoveBackward(__pos, finishN, oldFinish);
+                __dequeCopy(__first, __last, __pos);
+            }
+            else
+            {
+                /**
+                 * 先构造后 (__n - elemsAfter) 个新元素，紧接着把插入点之后的元素全部构造过去，
+                 * 前 elemsAfter 个新元素赋值到原来的 [__pos, oldFinish)。
+                */
+                ForwardIterator middle = __first;
+                std::advance(middle, elemsAfter);
+
+                this->uninitialized_copy_n(middle, __n - size_type(elemsAfter), this->finish);
+
+                try
+                {
+                    this->uninitialized_copy_n(std::make_move_iterator(__pos), size_type(elemsAfter), this->finish + difference_type(__n - elemsAfter));
+                }
+                catch (...)
+                {
+                    destroy_range(this->finish, this->finish + difference_type(__n - elemsAfter));
+                    throw;
+                }
+
+                this->finish = newFinish;
+
+                __dequeCopy(__first, middle, __pos);
+            }
+        }
+        catch (...)
+        {
+            this->destroy_nodes_at_back(newFinish);
+            throw;
+        }
+    }
+
+    return this->start + elemsBefore;
+}
+
 #endif // __MY_DEQUE_H_
\ No newline at end of file
@@ -0,0 +1,445 @@
+#ifndef __DEQUE_ALGORITHM_H_
+#define __DEQUE_ALGORITHM_H_
+
+#include "./deque_iterator.h"
+
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @brief 针对 `Deque_Iterator` 的分段（segmented）算法：
+ *        __dequeCopy、__dequeCopyBackward、__dequeMove、__dequeMoveBackward、__dequeFill、__dequeFind、__dequeForEach、__dequeAccumulate。
+ *
+ * @brief - `Deque_Iterator` 的 `operator++`、`operator+=` 每走一步都要检查是否越过了缓冲区的边界，
+ *          逐个迭代器推进的循环因此无法被编译器向量化。
+ *          这里的重载把区间拆成若干个缓冲区内的片段 `[first, last)`，每个片段都是一段连续内存，
+ *          直接交给对原生指针的标准算法处理（可以向量化，平凡类型的 copy 会变成 memmove），
+ *          只在片段之间切换节点。
+ *
+ * @brief - 为了不在全局命名空间里添加 copy、move 之类的通用名字，这些函数都带 `__deque` 前缀，
+ *          My_Deque 内部直接调用它们；供用户使用的 copy(first, last, result) 等是 `Deque_Iterator` 的隐藏友元，
+ *          只能经 ADL 找到（见 deque_iterator.h），它们转发到这里。
+*/
+
+/**
+ * @brief 辅助函数，依次对 [__first, __last) 在每个缓冲区内的片段调用 __segment(begin, end)，
+ *        __segment 返回 false 时提前结束，返回结束时所在片段的节点。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename Segment>
+typename Deque_Iterator<Type, Ref, Ptr, Buffer_Size>::map_pointer
+__dequeForEachSegment(
+    const Deque_Iterator<Type, Ref, Ptr, Buffer_Size> & __first,
+    const Deque_Iterator<Type, Ref, Ptr, Buffer_Size> & __last, Segment __segment
+)
+{
+    typedef Deque_Iterator<Type, Ref, Ptr, Buffer_Size> iterator;
+
+    if (__first.node == __last.node)
+    {
+        __segment(__first.current, __last.current);
+        return __first.node;
+    }
+
+    if (!__segment(__first.current, __first.last)) { return __first.node; }
+
+    for (typename iterator::map_pointer node = __first.node + 1; node < __last.node; ++node)
+    {
+        if (!__segment(*node, *node + iterator::getBufferSize())) { return node; }
+    }
+
+    __segment(__last.first, __last.current);
+
+    return __last.node;
+}
+
+/**
+ * @brief 辅助函数，把连续的 [__first, __last) 逐个缓冲区地写到 __result 开始的位置，
+ *        __write(srcBegin, srcEnd, dest) 负责一段不跨缓冲区的写入，函数返回写完之后的 __result。
+*/
+template <typename RandomAccessIterator, typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename Write>
+Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __dequeWriteForward(
+    RandomAccessIterator __first, RandomAccessIterator __last, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __result, Write __write
+)
+{
+    typedef typename Deque_Iterator<Type, Ref, Ptr, Buffer_Size>::difference_type difference_type;
+
+    difference_type remain = __last - __first;
+
+    while (remain > 0)
+    {
+        const difference_type chunk = std::min(remain, difference_type(__result.last - __result.current));
+
+        __write(__first, __first + chunk, __result.current);
+
+        __first  += chunk;
+        __result += chunk;
+        remain   -= chunk;
+    }
+
+    return __result;
+}
+
+/**
+ * @brief 辅助函数，__dequeWriteForward() 的反向版本：把 [__first, __last) 写到 __result 之前，
+ *        __write(srcBegin, srcEnd, destEnd) 负责一段不跨缓冲区的写入。
+*/
+template <typename RandomAccessIterator, typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename Write>
+Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __dequeWriteBackward(
+    RandomAccessIterator __first, RandomAccessIterator __last, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __result, Write __write
+)
+{
+    typedef Deque_Iterator<Type, Ref, Ptr, Buffer_Size>  iterator;
+    typedef typename iterator::difference_type          difference_type;
+
+    difference_type remain = __last - __first;
+
+    while (remain > 0)
+    {
+        /*__result 位于缓冲区开头时，前一段写入的是上一个缓冲区的末尾*/
+        difference_type room = __result.current - __result.first;
+        Type * destEnd       = __result.current;
+
+        if (room == 0)
+        {
+            room    = difference_type(iterator::getBufferSize());
+            destEnd = *(__result.node - 1) + room;
+        }
+
+        const difference_type chunk = std::min(remain, room);
+
+        __write(__last - chunk, __last, destEnd);
+
+        __last   -= chunk;
+        __result -= chunk;
+        remain   -= chunk;
+    }
+
+    return __result;
+}
+
+/**
+ * @brief 把 deque 的 [__first, __last) 拷贝到 __result，逐个缓冲区调用 std::copy。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename OutputIterator>
+OutputIterator __dequeCopy(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last, OutputIterator __result
+)
+{
+    __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+        __result = std::copy(__begin, __end, __result);
+        return true;
+    });
+
+    return __result;
+}
+
+/**
+ * @brief 把 [__first, __last) 拷贝到 deque 的 __result 开始的位置，逐个缓冲区调用 std::copy
+ *        （只有随机访问迭代器才能预先算出长度并分段，其他迭代器逐个拷贝）。
+*/
+template <typename InputIterator, typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size>
+Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __dequeCopy(
+    InputIterator __first, InputIterator __last, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __result
+)
+{
+    typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+
+    if constexpr (std::is_convertible<category, std::random_access_iterator_tag>::value)
+    {
+        return __dequeWriteForward(__first, __last, __result, [](InputIterator __begin, InputIterator __end, Type * __dest) {
+            std::copy(__begin, __end, __dest);
+        });
+    }
+    else { return std::copy(__first, __last, __result); }
+}
+
+/**
+ * @brief deque 之间的拷贝，源与目的两边都分段。
+*/
+template <
+            typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size,
+            typename OutType, typename OutRef, typename OutPtr, std::size_t Out_Buffer_Size
+        >
+Deque_Iterator<OutType, OutRef, OutPtr, Out_Buffer_Size> __dequeCopy(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last,
+    Deque_Iterator<OutType, OutRef, OutPtr, Out_Buffer_Size> __result
+)
+{
+    __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+        __result = __dequeCopy(__begin, __end, __result);
+        return true;
+    });
+
+    return __result;
+}
+
+/**
+ * @brief 把 deque 的 [__first, __last) 从后往前拷贝到 __result 之前，逐个缓冲区调用 std::copy_backward。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename BidirectionalIterator>
+BidirectionalIterator __dequeCopyBackward(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last,
+    BidirectionalIterator __result
+)
+{
+    /*从最后一个片段开始，逐个片段往前*/
+    while (__first.node != __last.node)
+    {
+        __result = std::copy_backward(__last.first, __last.current, __result);
+
+        __last.setNode(__last.node - 1);
+        __last.current = __last.last;
+    }
+
+    return std::copy_backward(__first.current, __last.current, __result);
+}
+
+/**
+ * @brief 把 [__first, __last) 从后往前拷贝到 deque 的 __result 之前，逐个缓冲区调用 std::copy_backward。
+*/
+template <typename BidirectionalIterator, typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size>
+Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __dequeCopyBackward(
+    BidirectionalIterator __first, BidirectionalIterator __last, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __result
+)
+{
+    typedef typename std::iterator_traits<BidirectionalIterator>::iterator_category category;
+
+    if constexpr (std::is_convertible<category, std::random_access_iterator_tag>::value)
+    {
+        return __dequeWriteBackward(__first, __last, __result, [](BidirectionalIterator __begin, BidirectionalIterator __end, Type * __destEnd) {
+            std::copy_backward(__begin, __end, __destEnd);
+        });
+    }
+    else { return std::copy_backward(__first, __last, __result); }
+}
+
+/**
+ * @brief deque 之间的反向拷贝，源与目的两边都分段。
+*/
+template <
+            typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size,
+            typename OutType, typename OutRef, typename OutPtr, std::size_t Out_Buffer_Size
+        >
+Deque_Iterator<OutType, OutRef, OutPtr, Out_Buffer_Size> __dequeCopyBackward(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last,
+    Deque_Iterator<OutType, OutRef, OutPtr, Out_Buffer_Size> __result
+)
+{
+    while (__first.node != __last.node)
+    {
+        __result = __dequeCopyBackward(__last.first, __last.current, __result);
+
+        __last.setNode(__last.node - 1);
+        __last.current = __last.last;
+    }
+
+    return __dequeCopyBackward(__first.current, __last.current, __result);
+}
+
+/**
+ * @brief 把 deque 的 [__first, __last) 移动到 __result，逐个缓冲区调用 std::move。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename OutputIterator>
+OutputIterator __dequeMove(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last, OutputIterator __result
+)
+{
+    __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+        __result = std::move(__begin, __end, __result);
+        return true;
+    });
+
+    return __result;
+}
+
+/**
+ * @brief 把 [__first, __last) 移动到 deque 的 __result 开始的位置，逐个缓冲区调用 std::move。
+*/
+template <typename InputIterator, typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size>
+Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __dequeMove(
+    InputIterator __first, InputIterator __last, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __result
+)
+{
+    typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+
+    if constexpr (std::is_convertible<category, std::random_access_iterator_tag>::value)
+    {
+        return __dequeWriteForward(__first, __last, __result, [](InputIterator __begin, InputIterator __end, Type * __dest) {
+            std::move(__begin, __end, __dest);
+        });
+    }
+    else { return std::move(__first, __last, __result); }
+}
+
+/**
+ * @brief deque 之间的移动，源与目的两边都分段。
+*/
+template <
+            typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size,
+            typename OutType, typename OutRef, typename OutPtr, std::size_t Out_Buffer_Size
+        >
+Deque_Iterator<OutType, OutRef, OutPtr, Out_Buffer_Size> __dequeMove(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last,
+    Deque_Iterator<OutType, OutRef, OutPtr, Out_Buffer_Size> __result
+)
+{
+    __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+        __result = __dequeMove(__begin, __end, __result);
+        return true;
+    });
+
+    return __result;
+}
+
+/**
+ * @brief 把 deque 的 [__first, __last) 从后往前移动到 __result 之前，逐个缓冲区调用 std::move_backward。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename BidirectionalIterator>
+BidirectionalIterator __dequeMoveBackward(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last,
+    BidirectionalIterator __result
+)
+{
+    while (__first.node != __last.node)
+    {
+        __result = std::move_backward(__last.first, __last.current, __result);
+
+        __last.setNode(__last.node - 1);
+        __last.current = __last.last;
+    }
+
+    return std::move_backward(__first.current, __last.current, __result);
+}
+
+/**
+ * @brief 把 [__first, __last) 从后往前移动到 deque 的 __result 之前，逐个缓冲区调用 std::move_backward。
+*/
+template <typename BidirectionalIterator, typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size>
+Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __dequeMoveBackward(
+    BidirectionalIterator __first, BidirectionalIterator __last, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __result
+)
+{
+    typedef typename std::iterator_traits<BidirectionalIterator>::iterator_category category;
+
+    if constexpr (std::is_convertible<category, std::random_access_iterator_tag>::value)
+    {
+        return __dequeWriteBackward(__first, __last, __result, [](BidirectionalIterator __begin, BidirectionalIterator __end, Type * __destEnd) {
+            std::move_backward(__begin, __end, __destEnd);
+        });
+    }
+    else { return std::move_backward(__first, __last, __result); }
+}
+
+/**
+ * @brief deque 之间的反向移动，源与目的两边都分段。
+*/
+template <
+            typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size,
+            typename OutType, typename OutRef, typename OutPtr, std::size_t Out_Buffer_Size
+        >
+Deque_Iterator<OutType, OutRef, OutPtr, Out_Buffer_Size> __dequeMoveBackward(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last,
+    Deque_Iterator<OutType, OutRef, OutPtr, Out_Buffer_Size> __result
+)
+{
+    while (__first.node != __last.node)
+    {
+        __result = __dequeMoveBackward(__last.first, __last.current, __result);
+
+        __last.setNode(__last.node - 1);
+        __last.current = __last.last;
+    }
+
+    return __dequeMoveBackward(__first.current, __last.current, __result);
+}
+
+/**
+ * @brief 把 deque 的 [__first, __last) 全部赋值为 __value，逐个缓冲区调用 std::fill。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename Value>
+void __dequeFill(Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last, const Value & __value)
+{
+    __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+        std::fill(__begin, __end, __value);
+        return true;
+    });
+}
+
+/**
+ * @brief 在 deque 的 [__first, __last) 中查找第一个等于 __value 的元素，逐个缓冲区调用 std::find，
+ *        找不到时返回 __last。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename Value>
+Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __dequeFind(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last, const Value & __value
+)
+{
+    Type * found = nullptr;
+
+    typename Deque_Iterator<Type, Ref, Ptr, Buffer_Size>::map_pointer node =
+        __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+            Type * position = std::find(__begin, __end, __value);
+
+            if (position == __end) { return true; }
+
+            found = position;
+            return false;
+        });
+
+    if (found == nullptr) { return __last; }
+
+    __first.setNode(node);
+    __first.current = found;
+
+    return __first;
+}
+
+/**
+ * @brief 对 deque 的 [__first, __last) 中的每个元素调用 __function，每个缓冲区内是一个对原生指针的循环。
+ *
+ * @return 调用之后的 __function（与 std::for_each 相同）。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename Function>
+Function __dequeForEach(Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last, Function __function)
+{
+    __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+        /*带捕获的 lambda 不能赋值，不能写成 __function = std::for_each(...)*/
+        for (; __begin != __end; ++__begin) { __function(*__begin); }
+        return true;
+    });
+
+    return __function;
+}
+
+/**
+ * @brief 按顺序累加 deque 的 [__first, __last)，逐个缓冲区调用 std::accumulate。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename Value>
+Value __dequeAccumulate(Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last, Value __init)
+{
+    __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+        __init = std::accumulate(__begin, __end, std::move(__init));
+        return true;
+    });
+
+    return __init;
+}
+
+/**
+ * @brief 按顺序用 __operation 累积 deque 的 [__first, __last)，逐个缓冲区调用 std::accumulate。
+*/
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size, typename Value, typename BinaryOperation>
+Value __dequeAccumulate(
+    Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __first, Deque_Iterator<Type, Ref, Ptr, Buffer_Size> __last,
+    Value __init, BinaryOperation __operation
+)
+{
+    __dequeForEachSegment(__first, __last, [&](Type * __begin, Type * __end) {
+        __init = std::accumulate(__begin, __end, std::move(__init), __operation);
+        return true;
+    });
+
+    return __init;
+}
+
+#endif // __DEQUE_ALGORITHM_H_
@@ -3,6 +3,7 @@
 
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 /**
  * @brief 全局函数，
@@ -24,6 +25,18 @@ inline std::size_t __dequeBufferSize(std::size_t __n, std::size_t __size)
     return (__n != 0) ? __n : ((__size < 512) ? std::size_t(512 / __size) : std::size_t(1ULL)) ;
 }
 
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size>
+struct Deque_Iterator;
+
+/**
+ * @brief 判断 Iterator 是否为 `Deque_Iterator`。
+*/
+template <typename Iterator>
+struct __isDequeIterator : std::false_type {};
+
+template <typename Type, typename Ref, typename Ptr, std::size_t Buffer_Size>
+struct __isDequeIterator<Deque_Iterator<Type, Ref, Ptr, Buffer_Size>> : std::true_type {};
+
 /**
  * @brief 供 deque 使用的迭代器，采用的是 `random access iterator`（随机访问迭代器），
  *        但双端队列的连续只是逻辑上的，所以不能像 `vector` 那样粗暴的使用裸指针当迭代器。
@@ -246,6 +259,63 @@ struct Deque_Iterator
     {  
         return (this->node == __x.node) ? (this->current < __x.current) : (this->node < __x.node);
     }
+
+    /**
+     * 以下是分段算法的隐藏友元，不加限定地调用 copy(first, last, result) 等时经 ADL 找到，
+     * 比 std 的通用版本更特化，实现是 deque_algorithm.h 中带 `__deque` 前缀的同名函数。
+     * 
+     * 源区间是 deque 的版本接受任意的目的迭代器（包括 deque 的迭代器），
+     * 目的是 deque 的版本则不接受 deque 的源区间，免得 deque 之间的拷贝同时匹配两个重载。
+    */
+    template <typename OutputIterator>
+    friend OutputIterator copy(self __first, self __last, OutputIterator __result)
+    { return __dequeCopy(__first, __last, __result); }
+
+    template <typename InputIterator, typename = std::enable_if_t<!__isDequeIterator<InputIterator>::value>>
+    friend self copy(InputIterator __first, InputIterator __last, self __result)
+    { return __dequeCopy(__first, __last, __result); }
+
+    template <typename BidirectionalIterator>
+    friend BidirectionalIterator copy_backward(self __first, self __last, BidirectionalIterator __result)
+    { return __dequeCopyBackward(__first, __last, __result); }
+
+    template <typename BidirectionalIterator, typename = std::enable_if_t<!__isDequeIterator<BidirectionalIterator>::value>>
+    friend self copy_backward(BidirectionalIterator __first, BidirectionalIterator __last, self __result)
+    { return __dequeCopyBackward(__first, __last, __result); }
+
+    template <typename OutputIterator>
+    friend OutputIterator move(self __first, self __last, OutputIterator __result)
+    { return __dequeMove(__first, __last, __result); }
+
+    template <typename InputIterator, typename = std::enable_if_t<!__isDequeIterator<InputIterator>::value>>
+    friend self move(InputIterator __first, InputIterator __last, self __result)
+    { return __dequeMove(__first, __last, __result); }
+
+    template <typename BidirectionalIterator>
+    friend BidirectionalIterator move_backward(self __first, self __last, BidirectionalIterator __result)
+    { return __dequeMoveBackward(__first, __last, __result); }
+
+    template <typename BidirectionalIterator, typename = std::enable_if_t<!__isDequeIterator<BidirectionalIterator>::value>>
+    friend self move_backward(BidirectionalIterator __first, BidirectionalIterator __last, self __result)
+    { return __dequeMoveBackward(__first, __last, __result); }
+
+    template <typename Value>
+    friend void fill(self __first, self __last, const Value & __value) { __dequeFill(__first, __last, __value); }
+
+    template <typename Value>
+    friend self find(self __first, self __last, const Value & __value) { return __dequeFind(__first, __last, __value); }
+
+    template <typename Function>
+    friend Function for_each(self __first, self __last, Function __function)
+    { return __dequeForEach(__first, __last, std::move(__function)); }
+
+    template <typename Value>
+    friend Value accumulate(self __first, self __last, Value __init)
+    { return __dequeAccumulate(__first, __last, std::move(__init)); }
+
+    template <typename Value, typename BinaryOperation>
+    friend Value accumulate(self __first, self __last, Value __init, BinaryOperation __operation)
+    { return __dequeAccumulate(__first, __last, std::move(__init), __operation); }
 };
 
 #endif // __DEQUE_ITERATOR_H_
\ No newline at end of file
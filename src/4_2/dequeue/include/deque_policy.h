@@ -0,0 +1,59 @@
+#ifndef __DEQUE_POLICY_H_
+#define __DEQUE_POLICY_H_
+
+#include <cstddef>
+
+/**
+ * @brief My_Deque 的节点策略（Policy 模板参数），决定每个缓冲区（节点）的大小和中控 map 的扩张方式。
+ *
+ * @brief - 每个策略提供两个静态函数和一个常量：
+ *
+ *          static constexpr std::size_t nodeElements(std::size_t elementSize);
+ *              每个缓冲区放多少个元素（至少 1 个）
+ *
+ *          static std::size_t nextMapSize(std::size_t mapSize, std::size_t nodesToAdd);
+ *              map 装不下、需要重新分配时新 map 的节点数（至少要比 mapSize + nodesToAdd 大）
+ *
+ *          static constexpr std::size_t spareNodes;
+ *              每个 deque 最多缓存多少个空闲的缓冲区，pop 腾出的缓冲区先放进缓存，之后 push 需要新缓冲区时直接取用
+ *
+ * @brief - SGI 原版的缓冲区固定为 512 字节，40 字节的记录每个缓冲区只能放 12 个，
+ *          顺序访问时每 12 个元素就要跳一次节点，随机访问时每个元素都要先读 map 再读缓冲区，
+ *          节点越小这两次间接访问的开销越明显，缓冲区本身的分配、释放也越频繁。
+ *          默认策略改为 4 KiB（一页）的缓冲区：缓冲区不超过一页，每页放下尽量多的元素。
+ *
+ * @brief - My_Deque 的 BufferSize 模板参数不为 0 时仍然直接指定每个缓冲区的元素个数，优先于策略。
+ *
+ * @tparam NodeBytes        每个缓冲区的字节数上限，元素大于它时每个缓冲区放 1 个元素
+ * @tparam MapGrowthFactor  map 重新分配时至少扩大为原来的多少倍
+ * @tparam SpareNodes       缓存的空闲缓冲区个数上限，0 表示不缓存（与 SGI 原版相同，腾出的缓冲区立即释放）
+*/
+template <std::size_t NodeBytes = 4096, std::size_t MapGrowthFactor = 2, std::size_t SpareNodes = 2>
+struct __DequePolicy
+{
+    static_assert(NodeBytes > 0, "node size must not be 0");
+    static_assert(MapGrowthFactor >= 2, "map must at least double, or push_back would reallocate the map too often");
+
+    static constexpr std::size_t spareNodes = SpareNodes;
+
+    static constexpr std::size_t nodeElements(std::size_t __elementSize)
+    {
+        return (__elementSize < NodeBytes) ? NodeBytes / __elementSize : std::size_t(1);
+    }
+
+    /**
+     * @brief MapGrowthFactor 为 2 时与 SGI 原版相同：mapSize + max(mapSize, nodesToAdd) + 2。
+    */
+    static std::size_t nextMapSize(std::size_t __mapSize, std::size_t __nodesToAdd)
+    {
+        const std::size_t grown    = __mapSize * MapGrowthFactor;
+        const std::size_t required = __mapSize + __nodesToAdd;
+
+        return ((grown > required) ? grown : required) + 2;
+    }
+};
+
+typedef __DequePolicy<512, 2, 0> sgiDequePolicy;    // SGI 原版：512 字节的缓冲区，腾出的缓冲区立即释放
+typedef __DequePolicy<4096>      pageDequePolicy;    // 一页（4 KiB）的缓冲区，缓存 2 个空闲的缓冲区，My_Deque 的默认策略
+
+#endif // __DEQUE_POLICY_H_
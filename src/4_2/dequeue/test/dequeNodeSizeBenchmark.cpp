@@ -0,0 +1,121 @@
+#include "../include/deque.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <vector>
+
+/*
+    My_Deque 节点大小基准：
+    1. 检查节点策略算出的每个缓冲区元素个数、map 的扩张，以及不同节点大小下 deque 的内容都正确；
+    2. 对 40 字节的记录，分别用 512 B（SGI 原版）、1 KiB、4 KiB（默认）、16 KiB、64 KiB 的缓冲区，
+       比较 push_back、随机访问 operator[]、顺序遍历、pop_front 的耗时（每个元素的平均纳秒数）。
+*/
+
+/**
+ * @brief 40 字节的记录。
+*/
+struct Record
+{
+    long    key;
+    double  values[4];
+};
+
+static_assert(sizeof(Record) == 40, "the benchmark is about 40-byte records");
+
+void checkPolicy(void)
+{
+    CHECK((My_Deque<Record, 0, std::allocator<Record>, sgiDequePolicy>::node_elements == 12));
+    CHECK((My_Deque<Record>::node_elements == 102));
+    CHECK((My_Deque<Record, 7>::node_elements == 7));
+    CHECK((My_Deque<char[5000]>::node_elements == 1));
+    CHECK((My_Deque<int>::iterator::getBufferSize() == 1024));
+
+    /*倍数为 2 时与 SGI 原版相同*/
+    CHECK(sgiDequePolicy::nextMapSize(8, 1) == 18 && sgiDequePolicy::nextMapSize(8, 20) == 30);
+    CHECK((__DequePolicy<4096, 4>::nextMapSize(8, 1) == 34));
+
+    /*不同节点大小下，两端的插入、删除与随机访问都正确*/
+    My_Deque<Record, 0, std::allocator<Record>, __DequePolicy<100, 3>> tiny;
+
+    for (long index = 0; index < 5000; ++index)
+    {
+        tiny.push_back(Record{index, {}});
+        tiny.push_front(Record{-index - 1, {}});
+    }
+
+    bool ordered = tiny.size() == 10000;
+    for (std::size_t index = 0; index < tiny.size(); ++index) { ordered = ordered && tiny[index].key == long(index) - 5000; }
+    CHECK(ordered);
+
+    for (int index = 0; index < 2500; ++index) { tiny.pop_front(); tiny.pop_back(); }
+    CHECK(tiny.size() == 5000 && tiny.front().key == -2500 && tiny.back().key == 2499);
+}
+
+/*防止编译器把整个循环优化掉*/
+volatile long sink = 0;
+
+template <typename Policy>
+void runSweep(const char * __name)
+{
+    typedef My_Deque<Record, 0, std::allocator<Record>, Policy> Deque;
+
+    constexpr std::size_t COUNT = 1 << 21;
+
+    std::mt19937_64 randEngine(2024);
+    std::uniform_int_distribution<std::size_t> dist(0, COUNT - 1);
+
+    std::vector<std::size_t> indices(COUNT);
+    for (std::size_t & index : indices) { index = dist(randEngine); }
+
+    auto perElement = [](std::chrono::steady_clock::time_point __startTime) {
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - __startTime;
+        return elapsed.count() / COUNT;
+    };
+
+    Deque deque;
+
+    auto startTime = std::chrono::steady_clock::now();
+    for (std::size_t index = 0; index < COUNT; ++index) { deque.push_back(Record{long(index), {}}); }
+    const double pushTime = perElement(startTime);
+
+    long total = 0;
+
+    startTime = std::chrono::steady_clock::now();
+    for (std::size_t index : indices) { total += deque[index].key; }
+    const double randomTime = perElement(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    for (typename Deque::iterator iter = deque.begin(); iter != deque.end(); ++iter) { total += iter->key; }
+    const double scanTime = perElement(startTime);
+
+    startTime = std::chrono::steady_clock::now();
+    while (!deque.empty()) { total += deque.front().key; deque.pop_front(); }
+    const double popTime = perElement(startTime);
+
+    sink = total;
+
+    long expected = long(COUNT) * long(COUNT - 1);
+    for (std::size_t index : indices) { expected += long(index); }
+    CHECK(total == expected);
+
+    printf("  %-8s %4zu per node  push_back : %5.2f ns, random [] : %5.2f ns, scan : %5.2f ns, pop_front : %5.2f ns\n",
+           __name, Deque::node_elements, pushTime, randomTime, scanTime, popTime);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkPolicy();
+
+    printf("My_Deque<Record> (%zu bytes per record), per element:\n", sizeof(Record));
+
+    runSweep<__DequePolicy<512>>("512 B");
+    runSweep<__DequePolicy<1024>>("1 KiB");
+    runSweep<__DequePolicy<4096>>("4 KiB");
+    runSweep<__DequePolicy<16384>>("16 KiB");
+    runSweep<__DequePolicy<65536>>("64 KiB");
+
+    return testResult();
+}
@@ -0,0 +1,219 @@
+#include "../include/deque.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+/*
+    Deque_Iterator 分段算法的测试：
+    1. copy、copy_backward（deque 到数组、数组到 deque、deque 到 deque，包括重叠的区间）、fill、find、for_each、accumulate
+       在各种跨越缓冲区边界的区间上，结果与逐个迭代器推进的 std 版本相同；
+    2. erase、insert 改用分段的 copy / copy_backward 之后结果不变；
+    3. 最后比较 std 版本（逐个迭代器推进）与分段版本在 256K 个 int（1 MiB，能放进缓存）上的耗时。
+*/
+
+/*缓冲区只有 8 个元素，区间很容易跨越多个缓冲区*/
+typedef My_Deque<int, 8> SmallDeque;
+
+template <typename Deque>
+bool sameAs(const Deque & __deque, const std::deque<int> & __expected)
+{
+    if (__deque.size() != __expected.size()) { return false; }
+
+    for (std::size_t index = 0; index < __expected.size(); ++index)
+    {
+        if (__deque[index] != __expected[index]) { return false; }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 构建 0, 1, ..., __n - 1，先 push_front 一部分，让 start 不在缓冲区开头。
+*/
+SmallDeque makeDeque(int __n)
+{
+    SmallDeque deque;
+
+    for (int value = __n / 3 - 1; value >= 0; --value) { deque.push_front(value); }
+    for (int value = __n / 3; value < __n; ++value) { deque.push_back(value); }
+
+    return deque;
+}
+
+void checkAlgorithms(void)
+{
+    const int COUNT = 100;
+
+    for (int from = 0; from <= COUNT; from += 3)
+    {
+        for (int to = from; to <= COUNT; to += 5)
+        {
+            SmallDeque deque = makeDeque(COUNT);
+            std::deque<int> expected(COUNT);
+            for (int index = 0; index < COUNT; ++index) { expected[index] = index; }
+
+            SmallDeque::iterator first = deque.begin() + from;
+            SmallDeque::iterator last  = deque.begin() + to;
+
+            /*deque 到数组*/
+            std::vector<int> out(to - from + 2, -1);
+            CHECK(copy(first, last, out.begin() + 1) == out.begin() + 1 + (to - from));
+            CHECK(std::equal(out.begin() + 1, out.end() - 1, expected.begin() + from) && out.back() == -1);
+
+            std::vector<int> outBackward(to - from + 2, -1);
+            CHECK(copy_backward(first, last, outBackward.end() - 1) == outBackward.begin() + 1);
+            CHECK(std::equal(outBackward.begin() + 1, outBackward.end() - 1, expected.begin() + from) && outBackward[0] == -1);
+
+            /*find、for_each、accumulate*/
+            const int target = (from + to) / 2;
+            CHECK(find(first, last, target) == std::find(first, last, target));
+            CHECK(find(first, last, -5) == last);
+
+            long sum = 0;
+            for_each(first, last, [&sum](int __value) { sum += __value; });
+            CHECK(sum == std::accumulate(first, last, 0L) && accumulate(first, last, 0L) == sum);
+            CHECK(accumulate(first, last, std::string(), [](std::string __text, int __value) { return __text + char('a' + __value % 26); }) ==
+                  std::accumulate(expected.begin() + from, expected.begin() + to, std::string(),
+                                  [](std::string __text, int __value) { return __text + char('a' + __value % 26); }));
+
+            /*数组到 deque*/
+            std::vector<int> source(to - from);
+            for (int index = 0; index < to - from; ++index) { source[index] = 1000 + index; }
+
+            CHECK(copy(source.begin(), source.end(), first) == last);
+            std::copy(source.begin(), source.end(), expected.begin() + from);
+            CHECK(sameAs(deque, expected));
+
+            for (int & value : source) { value += 1000; }
+
+            CHECK(copy_backward(source.begin(), source.end(), last) == first);
+            std::copy_backward(source.begin(), source.end(), expected.begin() + to);
+            CHECK(sameAs(deque, expected));
+
+            /*fill*/
+            fill(first, last, 7);
+            std::fill(expected.begin() + from, expected.begin() + to, 7);
+            CHECK(sameAs(deque, expected));
+
+            /*deque 到 deque（不同的缓冲区大小），以及同一个 deque 内重叠的区间*/
+            My_Deque<int, 5> other(COUNT, -1);
+            CHECK(copy(deque.begin(), deque.end(), other.begin()) == other.end());
+            CHECK(sameAs(other, expected));
+
+            if (to + 7 <= COUNT)
+            {
+                CHECK(copy_backward(first, last, last + 7) == first + 7);
+                std::copy_backward(expected.begin() + from, expected.begin() + to, expected.begin() + to + 7);
+                CHECK(sameAs(deque, expected));
+            }
+
+            if (from >= 7)
+            {
+                CHECK(copy(first, last, first - 7) == last - 7);
+                std::copy(expected.begin() + from, expected.begin() + to, expected.begin() + from - 7);
+                CHECK(sameAs(deque, expected));
+            }
+        }
+    }
+}
+
+void checkContainer(void)
+{
+    SmallDeque deque = makeDeque(60);
+    std::deque<int> expected;
+    for (int index = 0; index < 60; ++index) { expected.push_back(index); }
+
+    deque.erase(deque.begin() + 10, deque.begin() + 27);
+    expected.erase(expected.begin() + 10, expected.begin() + 27);
+    CHECK(sameAs(deque, expected));
+
+    deque.erase(deque.end() - 20, deque.end() - 3);
+    expected.erase(expected.end() - 20, expected.end() - 3);
+    CHECK(sameAs(deque, expected));
+
+    deque.erase(deque.begin() + 3);
+    expected.erase(expected.begin() + 3);
+    deque.erase(deque.end() - 4);
+    expected.erase(expected.end() - 4);
+    CHECK(sameAs(deque, expected));
+
+    for (int round = 0; round < 20; ++round)
+    {
+        const std::size_t position = (round * 7) % (deque.size() + 1);
+
+        deque.insert(deque.begin() + position, -round);
+        expected.insert(expected.begin() + position, -round);
+    }
+
+    CHECK(sameAs(deque, expected));
+}
+
+/*防止编译器把整个循环优化掉*/
+volatile long sink = 0;
+
+template <typename Run>
+double measure(Run __run, int __rounds)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < __rounds; ++round) { __run(); }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    return elapsed.count() / __rounds;
+}
+
+void compareSpeed(void)
+{
+    constexpr std::size_t COUNT  = 1 << 18;
+    constexpr int         ROUNDS = 200;
+
+    My_Deque<int> deque(COUNT, 1);
+    std::vector<int> buffer(COUNT);
+
+    auto report = [](const char * __name, double __iterator, double __segmented) {
+        printf("  %-10s std (iterator) : %6.1f us, segmented : %6.1f us (x%.1f)\n", __name, __iterator * 1000, __segmented * 1000, __iterator / __segmented);
+    };
+
+    printf("My_Deque<int> with %zu elements (%zu per buffer)\n", COUNT, My_Deque<int>::iterator::getBufferSize());
+
+    report("copy",
+           measure([&] { std::copy(deque.begin(), deque.end(), buffer.begin()); sink = buffer[COUNT / 2]; }, ROUNDS),
+           measure([&] { copy(deque.begin(), deque.end(), buffer.begin()); sink = buffer[COUNT / 2]; }, ROUNDS));
+
+    report("copy in",
+           measure([&] { std::copy(buffer.begin(), buffer.end(), deque.begin()); sink = deque[COUNT / 2]; }, ROUNDS),
+           measure([&] { copy(buffer.begin(), buffer.end(), deque.begin()); sink = deque[COUNT / 2]; }, ROUNDS));
+
+    report("fill",
+           measure([&] { std::fill(deque.begin(), deque.end(), 2); sink = deque[COUNT / 2]; }, ROUNDS),
+           measure([&] { fill(deque.begin(), deque.end(), 2); sink = deque[COUNT / 2]; }, ROUNDS));
+
+    report("find",
+           measure([&] { sink = std::find(deque.begin(), deque.end(), 3) - deque.begin(); }, ROUNDS),
+           measure([&] { sink = find(deque.begin(), deque.end(), 3) - deque.begin(); }, ROUNDS));
+
+    report("for_each",
+           measure([&] { std::for_each(deque.begin(), deque.end(), [](int & __value) { __value += 1; }); sink = deque[0]; }, ROUNDS),
+           measure([&] { for_each(deque.begin(), deque.end(), [](int & __value) { __value += 1; }); sink = deque[0]; }, ROUNDS));
+
+    report("accumulate",
+           measure([&] { sink = std::accumulate(deque.begin(), deque.end(), 0L); }, ROUNDS),
+           measure([&] { sink = accumulate(deque.begin(), deque.end(), 0L); }, ROUNDS));
+
+    CHECK(sink == long(COUNT) * (2 + 2 * ROUNDS));
+}
+
+int main(int argc, char const *argv[])
+{
+    checkAlgorithms();
+    checkContainer();
+    compareSpeed();
+
+    return testResult();
+}
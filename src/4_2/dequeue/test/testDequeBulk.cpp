@@ -0,0 +1,317 @@
+#include "../include/deque.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <deque>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+    My_Deque 批量操作的测试：
+    1. append、prepend、insert(pos, first, last) 在各种插入点、各种长度（跨越多个缓冲区）下，
+       结果与 std::deque 相同，前向迭代器和单趟的输入迭代器都支持；
+    2. pop_front(n)、pop_back(n) 的结果正确，腾出的缓冲区整个交还，append 一大段元素时 map 最多重新配置一次；
+    3. 构造元素时抛出异常，append、prepend 之后容器保持原样，insert 之后不泄漏任何元素；
+    4. 最后比较逐个元素操作与批量操作的耗时。
+*/
+
+template <typename Deque, typename Expected>
+bool sameAs(const Deque & __deque, const Expected & __expected)
+{
+    if (__deque.size() != __expected.size()) { return false; }
+
+    for (std::size_t index = 0; index < __expected.size(); ++index)
+    {
+        if (__deque[index] != __expected[index]) { return false; }
+    }
+
+    return true;
+}
+
+template <typename Value>
+Value makeValue(int __value) { return Value(__value); }
+
+template <>
+std::string makeValue<std::string>(int __value) { return std::to_string(__value) + " is long enough to be on the heap"; }
+
+/**
+ * @brief 构建 0, 1, ..., __n - 1，先 push_front 一部分，让 start 不在缓冲区开头。
+*/
+template <typename Deque, typename Expected>
+void makeDeque(Deque & __deque, Expected & __expected, int __n)
+{
+    typedef typename Expected::value_type Value;
+
+    for (int value = __n / 3 - 1; value >= 0; --value) { __deque.push_front(makeValue<Value>(value)); }
+    for (int value = __n / 3; value < __n; ++value) { __deque.push_back(makeValue<Value>(value)); }
+
+    for (int value = 0; value < __n; ++value) { __expected.push_back(makeValue<Value>(value)); }
+}
+
+template <typename Value>
+void checkRangeOperations(void)
+{
+    typedef My_Deque<Value, 8> SmallDeque;
+
+    const int COUNT = 40;
+
+    for (int length = 0; length <= 30; length += 3)
+    {
+        std::vector<Value> source;
+        for (int index = 0; index < length; ++index) { source.push_back(makeValue<Value>(1000 + index)); }
+
+        /*插入点遍布整个 deque，包括头尾*/
+        for (int position = 0; position <= COUNT; position += 1)
+        {
+            SmallDeque deque;
+            std::deque<Value> expected;
+            makeDeque(deque, expected, COUNT);
+
+            typename SmallDeque::iterator result = deque.insert(deque.begin() + position, source.begin(), source.end());
+
+            /*libstdc++ 在中间插入空区间时会把元素自我移动赋值，std::string 因此被清空，这里跳过*/
+            if (length != 0) { expected.insert(expected.begin() + position, source.begin(), source.end()); }
+
+            CHECK(sameAs(deque, expected) && result == deque.begin() + position);
+        }
+
+        SmallDeque deque;
+        std::deque<Value> expected;
+        makeDeque(deque, expected, COUNT);
+
+        deque.append(source.begin(), source.end());
+        expected.insert(expected.end(), source.begin(), source.end());
+        CHECK(sameAs(deque, expected));
+
+        deque.prepend(source.begin(), source.end());
+        expected.insert(expected.begin(), source.begin(), source.end());
+        CHECK(sameAs(deque, expected));
+
+        /*从自身拷贝*/
+        SmallDeque copy(deque);
+        std::deque<Value> expectedCopy(expected);
+        deque.insert(deque.begin() + 17, copy.begin() + 3, copy.end() - 5);
+        expected.insert(expected.begin() + 17, expectedCopy.begin() + 3, expectedCopy.end() - 5);
+        CHECK(sameAs(deque, expected));
+
+        /*成批删除*/
+        deque.pop_front(length);
+        expected.erase(expected.begin(), expected.begin() + length);
+        deque.pop_back(length + 5);
+        expected.erase(expected.end() - (length + 5), expected.end());
+        CHECK(sameAs(deque, expected));
+
+        deque.pop_front(0);
+        deque.pop_back(0);
+        CHECK(sameAs(deque, expected));
+    }
+}
+
+void checkInputIterator(void)
+{
+    My_Deque<int, 8> deque{5, 6, 7};
+
+    std::istringstream head("1 2 3 4");
+    deque.prepend(std::istream_iterator<int>(head), std::istream_iterator<int>());
+
+    std::istringstream tail("8 9 10 11 12 13 14 15 16 17");
+    deque.append(std::istream_iterator<int>(tail), std::istream_iterator<int>());
+
+    std::istringstream middle("-1 -2 -3 -4 -5 -6 -7 -8 -9");
+    deque.insert(deque.begin() + 2, std::istream_iterator<int>(middle), std::istream_iterator<int>());
+
+    deque.insert(deque.end() - 1, {100, 200});
+
+    CHECK(sameAs(deque, std::vector<int>{1, 2, -1, -2, -3, -4, -5, -6, -7, -8, -9, 3, 4, 5, 6, 7, 8, 9, 10,
+                                         11, 12, 13, 14, 15, 16, 100, 200, 17}));
+
+    /*pop 的个数超过元素个数时清空容器*/
+    deque.pop_back(1000);
+    CHECK(deque.empty());
+    deque.pop_front(1);
+    CHECK(deque.empty());
+}
+
+typedef CountingAllocator<int>      NodeCounter;
+typedef CountingAllocator<int *>    MapCounter;
+
+void checkNodes(void)
+{
+    /*每个缓冲区 16 个 int，不缓存空闲的缓冲区*/
+    typedef My_Deque<int, 0, NodeCounter, __DequePolicy<64, 2, 0>> Deque;
+
+    const long NODE_BYTES = long(16 * sizeof(int));
+
+    {
+        std::vector<int> source(100000);
+        for (std::size_t index = 0; index < source.size(); ++index) { source[index] = int(index); }
+
+        Deque deque;
+
+        const long mapAllocations = MapCounter::allocations;
+
+        deque.append(source.begin(), source.end());
+        CHECK(MapCounter::allocations - mapAllocations == 1);
+        CHECK(sameAs(deque, source));
+
+        /*100000 / 16 = 6250 个缓冲区正好装满，finish 落在新的缓冲区开头*/
+        CHECK(NodeCounter::liveBytes == 6251 * NODE_BYTES);
+
+        /*前 100 个缓冲区整个腾空*/
+        deque.pop_front(16 * 100 + 3);
+        CHECK(NodeCounter::liveBytes == 6151 * NODE_BYTES && deque.front() == 1603);
+
+        /*finish 所在的空缓冲区和后 200 个缓冲区整个腾空*/
+        deque.pop_back(16 * 200 + 1);
+        CHECK(NodeCounter::liveBytes == 5950 * NODE_BYTES && deque.back() == 100000 - 16 * 200 - 2);
+
+        const long nodeAllocations = NodeCounter::allocations;
+        const long prependMaps     = MapCounter::allocations;
+
+        deque.prepend(source.begin(), source.end());
+        CHECK(MapCounter::allocations - prependMaps <= 1);
+        CHECK(NodeCounter::allocations - nodeAllocations == 6250);
+        CHECK(deque.front() == 0 && deque[100000] == 1603 && deque.size() == 100000 + 100000 - 4804);
+    }
+
+    CHECK(NodeCounter::liveBytes == 0 && MapCounter::liveBytes == 0);
+}
+
+/**
+ * @brief 第 countdown 次拷贝时抛出异常的类型，同时统计存活的对象个数。
+*/
+struct Thrower
+{
+    static inline int live      = 0;
+    static inline int countdown = -1;
+
+    int value;
+
+    Thrower(int __value) : value(__value) { ++live; }
+
+    Thrower(const Thrower & __other) : value(__other.value)
+    {
+        if (countdown > 0 && --countdown == 0) { throw std::runtime_error("copy failed"); }
+        ++live;
+    }
+
+    Thrower & operator=(const Thrower &) = default;
+
+    ~Thrower() { --live; }
+
+    bool operator!=(const Thrower & __other) const { return this->value != __other.value; }
+};
+
+void checkExceptions(void)
+{
+    typedef My_Deque<Thrower, 4> Deque;
+
+    std::vector<Thrower> source;
+    for (int index = 0; index < 30; ++index) { source.push_back(Thrower(100 + index)); }
+
+    for (int failAt = 1; failAt <= 30; failAt += 4)
+    {
+        Deque deque;
+        std::vector<Thrower> expected;
+        for (int index = 0; index < 10; ++index) { deque.push_back(Thrower(index)); expected.push_back(Thrower(index)); }
+
+        const int liveBefore = Thrower::live;
+
+        bool thrown = false;
+        Thrower::countdown = failAt;
+        try { deque.append(source.begin(), source.end()); } catch (const std::runtime_error &) { thrown = true; }
+        CHECK(thrown && sameAs(deque, expected) && Thrower::live == liveBefore);
+
+        thrown = false;
+        Thrower::countdown = failAt;
+        try { deque.prepend(source.begin(), source.end()); } catch (const std::runtime_error &) { thrown = true; }
+        CHECK(thrown && sameAs(deque, expected) && Thrower::live == liveBefore);
+
+        /*中间插入只保证不泄漏，容器仍然可以正常使用*/
+        Thrower::countdown = failAt;
+        try { deque.insert(deque.begin() + 3, source.begin(), source.end()); } catch (const std::runtime_error &) {}
+        try { deque.insert(deque.end() - 3, source.begin(), source.end()); } catch (const std::runtime_error &) {}
+        Thrower::countdown = -1;
+
+        CHECK(Thrower::live == liveBefore + int(deque.size()) - 10);
+
+        deque.push_back(Thrower(-1));
+        CHECK(deque.back().value == -1);
+    }
+
+    source.clear();
+    CHECK(Thrower::live == 0);
+}
+
+/*防止编译器把整个循环优化掉*/
+volatile long sink = 0;
+
+template <typename Run>
+double measure(Run __run, int __rounds)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < __rounds; ++round) { __run(); }
+
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    return elapsed.count() / __rounds;
+}
+
+void compareSpeed(void)
+{
+    constexpr std::size_t COUNT  = 1 << 18;
+    constexpr int         ROUNDS = 100;
+
+    std::vector<int> source(COUNT, 1);
+
+    auto report = [](const char * __name, double __single, double __bulk) {
+        printf("  %-22s one by one : %7.1f us, bulk : %7.1f us (x%.1f)\n", __name, __single, __bulk, __single / __bulk);
+    };
+
+    printf("My_Deque<int>, %zu elements (%zu per buffer)\n", COUNT, My_Deque<int>::node_elements);
+
+    report("push_back / append",
+           measure([&] { My_Deque<int> deque; for (int value : source) { deque.push_back(value); } sink = deque.size(); }, ROUNDS),
+           measure([&] { My_Deque<int> deque; deque.append(source.begin(), source.end()); sink = deque.size(); }, ROUNDS));
+
+    report("push_front / prepend",
+           measure([&] { My_Deque<int> deque; for (int value : source) { deque.push_front(value); } sink = deque.size(); }, ROUNDS),
+           measure([&] { My_Deque<int> deque; deque.prepend(source.begin(), source.end()); sink = deque.size(); }, ROUNDS));
+
+    /*在 1/3 处插入 1024 个元素：逐个 insert 每次都要挪动插入点之前的所有元素*/
+    My_Deque<int> base(COUNT, 2);
+    const std::size_t INSERTED = COUNT / 256;
+
+    report("insert (middle)",
+           measure([&] {
+               My_Deque<int> deque(base);
+               for (std::size_t index = 0; index < INSERTED; ++index) { deque.insert(deque.begin() + COUNT / 3 + index, source[index]); }
+               sink = deque.size();
+           }, 10),
+           measure([&] {
+               My_Deque<int> deque(base);
+               deque.insert(deque.begin() + COUNT / 3, source.begin(), source.begin() + INSERTED);
+               sink = deque.size();
+           }, 10));
+
+    report("pop_front() / (n)",
+           measure([&] { My_Deque<int> deque(base); while (!deque.empty()) { deque.pop_front(); } sink = deque.size(); }, ROUNDS),
+           measure([&] { My_Deque<int> deque(base); deque.pop_front(COUNT - 1); sink = deque.size(); }, ROUNDS));
+}
+
+int main(int argc, char const *argv[])
+{
+    checkRangeOperations<int>();
+    checkRangeOperations<std::string>();
+    checkInputIterator();
+    checkNodes();
+    checkExceptions();
+    compareSpeed();
+
+    return testResult();
+}
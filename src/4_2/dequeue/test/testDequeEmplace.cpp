@@ -0,0 +1,321 @@
+#include "../include/deque.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+    My_Deque 就地构造与移动语义的测试：
+    1. emplace_back、emplace_front、emplace 直接用参数构造元素，右值的 push_back、push_front、insert 只移动不拷贝，
+       左值版本在缓冲区边界上也只拷贝一次（SGI 原版要先拷贝一份 valueCopy，共两次）；
+    2. insert、erase 挪动已有元素时只移动不拷贝，参数引用容器内的元素时结果仍然正确；
+    3. 只能移动的类型（std::unique_ptr）可以放进 deque，分段的 move、move_backward 结果正确；
+    4. 最后比较拷贝与移动长字符串的耗时。
+*/
+
+/**
+ * @brief 统计拷贝、移动次数的消息类型。
+*/
+struct Message
+{
+    static inline long copies = 0;
+    static inline long moves  = 0;
+
+    int         key;
+    std::string payload;
+
+    Message(int __key, std::string __payload) : key(__key), payload(std::move(__payload)) {}
+
+    Message(const Message & __other) : key(__other.key), payload(__other.payload) { ++copies; }
+    Message(Message && __other) noexcept : key(__other.key), payload(std::move(__other.payload)) { ++moves; }
+
+    Message & operator=(const Message & __other)
+    {
+        key     = __other.key;
+        payload = __other.payload;
+        ++copies;
+
+        return *this;
+    }
+
+    Message & operator=(Message && __other) noexcept
+    {
+        key     = __other.key;
+        payload = std::move(__other.payload);
+        ++moves;
+
+        return *this;
+    }
+
+    static void reset(void) { copies = 0; moves = 0; }
+};
+
+/*每个缓冲区 4 个元素，很容易走到缓冲区边界*/
+typedef My_Deque<Message, 4> SmallDeque;
+
+bool sameAs(const SmallDeque & __deque, const std::deque<int> & __expected)
+{
+    if (__deque.size() != __expected.size()) { return false; }
+
+    for (std::size_t index = 0; index < __expected.size(); ++index)
+    {
+        if (__deque[index].key != __expected[index] || __deque[index].payload != std::to_string(__expected[index])) { return false; }
+    }
+
+    return true;
+}
+
+void checkPush(void)
+{
+    SmallDeque deque;
+    std::deque<int> expected;
+
+    Message::reset();
+
+    for (int key = 0; key < 50; ++key)
+    {
+        CHECK(deque.emplace_back(key, std::to_string(key)).key == key);
+        CHECK(deque.emplace_front(-key, std::to_string(-key)).key == -key);
+
+        expected.push_back(key);
+        expected.push_front(-key);
+    }
+
+    CHECK(sameAs(deque, expected) && Message::copies == 0 && Message::moves == 0);
+
+    /*右值只移动一次*/
+    for (int key = 50; key < 100; ++key)
+    {
+        deque.push_back(Message(key, std::to_string(key)));
+        deque.push_front(Message(-key, std::to_string(-key)));
+
+        expected.push_back(key);
+        expected.push_front(-key);
+    }
+
+    CHECK(sameAs(deque, expected) && Message::copies == 0 && Message::moves == 100);
+
+    /*左值在缓冲区边界上也只拷贝一次*/
+    Message::reset();
+
+    for (int key = 100; key < 150; ++key)
+    {
+        const Message message(key, std::to_string(key));
+
+        deque.push_back(message);
+        deque.push_front(message);
+
+        expected.push_back(key);
+        expected.push_front(key);
+    }
+
+    CHECK(sameAs(deque, expected) && Message::copies == 100 && Message::moves == 0);
+
+    /*参数引用容器内的元素（在缓冲区边界上会配置新的缓冲区，甚至重新配置 map）*/
+    for (int round = 0; round < 20; ++round)
+    {
+        deque.push_back(deque.front());
+        deque.emplace_front(deque.back());
+
+        expected.push_back(expected.front());
+        expected.push_front(expected.back());
+    }
+
+    CHECK(sameAs(deque, expected));
+}
+
+void checkInsertErase(void)
+{
+    SmallDeque deque;
+    std::deque<int> expected;
+
+    for (int key = 0; key < 60; ++key)
+    {
+        deque.emplace_back(key, std::to_string(key));
+        expected.push_back(key);
+    }
+
+    Message::reset();
+
+    /*在各个位置就地构造、插入右值：已有的元素只移动*/
+    for (int round = 0; round < 30; ++round)
+    {
+        const std::size_t position = (round * 11) % (deque.size() + 1);
+        const int         key      = 1000 + round;
+
+        SmallDeque::iterator result = (round % 2 == 0) ? deque.emplace(deque.begin() + position, key, std::to_string(key))
+                                                       : deque.insert(deque.begin() + position, Message(key, std::to_string(key)));
+
+        CHECK(result == deque.begin() + position && result->key == key);
+        expected.insert(expected.begin() + position, key);
+    }
+
+    CHECK(sameAs(deque, expected) && Message::copies == 0);
+
+    /*成批插入只拷贝新元素*/
+    std::vector<Message> source;
+    for (int key = 2000; key < 2010; ++key) { source.emplace_back(key, std::to_string(key)); }
+
+    Message::reset();
+
+    deque.insert(deque.begin() + 7, source.begin(), source.end());
+    deque.insert(deque.end() - 7, source.begin(), source.end());
+    deque.insert(deque.begin() + 40, std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+
+    for (int key = 2000; key < 2010; ++key) { expected.insert(expected.begin() + 7 + (key - 2000), key); }
+    for (int key = 2000; key < 2010; ++key) { expected.insert(expected.end() - 7, key); }
+    for (int key = 2000; key < 2010; ++key) { expected.insert(expected.begin() + 40 + (key - 2000), key); }
+
+    CHECK(sameAs(deque, expected) && Message::copies == 20);
+
+    /*删除只移动*/
+    Message::reset();
+
+    for (int round = 0; round < 20; ++round)
+    {
+        const std::size_t position = (round * 13) % deque.size();
+
+        deque.erase(deque.begin() + position);
+        expected.erase(expected.begin() + position);
+    }
+
+    deque.erase(deque.begin() + 5, deque.begin() + 17);
+    expected.erase(expected.begin() + 5, expected.begin() + 17);
+    deque.erase(deque.end() - 30, deque.end() - 11);
+    expected.erase(expected.end() - 30, expected.end() - 11);
+
+    CHECK(sameAs(deque, expected) && Message::copies == 0);
+
+    /*参数引用容器内即将被挪动的元素*/
+    Message::reset();
+
+    deque.insert(deque.begin() + 3, deque[10]);
+    expected.insert(expected.begin() + 3, expected[10]);
+    deque.emplace(deque.end() - 3, deque[deque.size() - 10]);
+    expected.insert(expected.end() - 3, expected[expected.size() - 10]);
+
+    CHECK(sameAs(deque, expected) && Message::copies == 2);
+}
+
+void checkMoveOnly(void)
+{
+    typedef std::unique_ptr<int> Pointer;
+
+    My_Deque<Pointer, 4> deque;
+
+    for (int value = 0; value < 20; ++value)
+    {
+        deque.emplace_back(new int(value));
+        deque.push_front(std::make_unique<int>(-value - 1));
+    }
+
+    deque.emplace(deque.begin() + 13, new int(100));
+    deque.insert(deque.end() - 5, std::make_unique<int>(200));
+    deque.erase(deque.begin() + 2);
+    deque.erase(deque.end() - 9, deque.end() - 6);
+
+    std::deque<int> expected;
+    for (int value = 0; value < 20; ++value) { expected.push_back(value); expected.push_front(-value - 1); }
+    expected.insert(expected.begin() + 13, 100);
+    expected.insert(expected.end() - 5, 200);
+    expected.erase(expected.begin() + 2);
+    expected.erase(expected.end() - 9, expected.end() - 6);
+
+    bool same = deque.size() == expected.size();
+    for (std::size_t index = 0; same && index < expected.size(); ++index) { same = *deque[index] == expected[index]; }
+    CHECK(same);
+
+    /*分段的 move、move_backward：deque 到数组、数组到 deque、deque 内重叠的区间*/
+    std::vector<Pointer> out(deque.size());
+    CHECK(move(deque.begin(), deque.end(), out.begin()) == out.end());
+    CHECK(*out.front() == expected.front() && *out.back() == expected.back() && deque.front() == nullptr);
+
+    CHECK(move_backward(out.begin(), out.end(), deque.end()) == deque.begin());
+    CHECK(*deque[7] == expected[7] && out[7] == nullptr);
+
+    CHECK(move(deque.begin() + 10, deque.end(), deque.begin() + 3) == deque.end() - 7);
+    CHECK(*deque[3] == expected[10] && *deque[deque.size() - 8] == expected.back());
+
+    CHECK(move_backward(deque.begin(), deque.begin() + 20, deque.begin() + 27) == deque.begin() + 7);
+    CHECK(*deque[7] == expected[0] && *deque[26] == expected[26]);
+}
+
+/*防止编译器把整个循环优化掉*/
+volatile long sink = 0;
+
+template <typename Run>
+double measure(Run __run)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    __run();
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    return elapsed.count();
+}
+
+void compareSpeed(void)
+{
+    constexpr int COUNT = 1 << 18;
+
+    std::vector<std::string> source(COUNT, std::string(64, 'x'));
+
+    printf("My_Deque<std::string>, %d strings of 64 chars\n", COUNT);
+
+    const double copyTime = measure([&] {
+        My_Deque<std::string> deque;
+        for (const std::string & text : source) { deque.push_back(text); }
+        sink = deque.size();
+    });
+
+    const double moveTime = measure([&] {
+        My_Deque<std::string> deque;
+        for (std::string & text : source) { deque.push_back(std::move(text)); }
+        sink = deque.size();
+    });
+
+    printf("  push_back        copy : %6.1f ms, move : %6.1f ms\n", copyTime, moveTime);
+
+    /*在 1/3 处反复插入、删除：挪动的都是已有的元素*/
+    My_Deque<std::string> deque;
+    std::deque<std::string> reference;
+
+    for (int index = 0; index < 20000; ++index)
+    {
+        deque.emplace_back(64, 'y');
+        reference.emplace_back(64, 'y');
+    }
+
+    auto churn = [](auto & __container) {
+        for (int round = 0; round < 2000; ++round)
+        {
+            __container.emplace(__container.begin() + __container.size() / 3, 64, 'z');
+            __container.erase(__container.begin() + __container.size() / 4);
+        }
+
+        sink = __container.size();
+    };
+
+    const double myTime  = measure([&] { churn(deque); });
+    const double stdTime = measure([&] { churn(reference); });
+
+    printf("  insert + erase   My_Deque : %6.1f ms, std::deque : %6.1f ms\n", myTime, stdTime);
+
+    CHECK(deque.size() == 20000 && deque[deque.size() / 3] == reference[reference.size() / 3]);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkPush();
+    checkInsertErase();
+    checkMoveOnly();
+    compareSpeed();
+
+    return testResult();
+}
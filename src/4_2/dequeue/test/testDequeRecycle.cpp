@@ -0,0 +1,171 @@
+#include "../include/deque.h"
+#include "../../queue/include/queue.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+
+/*
+    My_Deque 空闲缓冲区缓存的测试：
+    1. 当作 FIFO 使用（push_back / pop_front，以及 queue 的 push_front / pop_back）时，
+       稳定状态下既不申请缓冲区，也不重新分配 map；
+    2. erase、clear 腾出的缓冲区同样进入缓存，shrink_to_fit() 和析构函数把缓存的缓冲区还给分配器；
+    3. 最后比较不缓存（SGI 原版）与缓存两种策略下，生产者 / 消费者队列每次 push + pop 的耗时。
+*/
+
+typedef CountingAllocator<int>      NodeCounter;
+typedef CountingAllocator<int *>    MapCounter;
+
+/*每个缓冲区 16 个 int，很快就会用到新的缓冲区*/
+typedef My_Deque<int, 0, NodeCounter, __DequePolicy<64>>            CachedDeque;
+typedef My_Deque<int, 0, NodeCounter, __DequePolicy<64, 2, 0>>      UncachedDeque;
+
+void checkSteadyState(void)
+{
+    {
+        CachedDeque deque;
+
+        /*预热：队列里保持 1000 个元素*/
+        for (int value = 0; value < 1000; ++value) { deque.push_back(value); }
+        for (int value = 1000; value < 100000; ++value) { deque.push_back(value); deque.pop_front(); }
+
+        const long nodeAllocations = NodeCounter::allocations;
+        const long mapAllocations  = MapCounter::allocations;
+
+        long expected = 100000 - 1000;
+        bool ordered  = true;
+
+        for (int value = 100000; value < 1000000; ++value)
+        {
+            deque.push_back(value);
+
+            ordered = ordered && deque.front() == expected;
+            ++expected;
+
+            deque.pop_front();
+        }
+
+        CHECK(ordered && deque.size() == 1000 && deque.front() == 1000000 - 1000);
+        CHECK(NodeCounter::allocations == nodeAllocations && MapCounter::allocations == mapAllocations);
+
+        /*queue 从前端放入、从后端取出，同样不申请内存*/
+        queue<int, CachedDeque> fifo;
+
+        for (int value = 0; value < 1000; ++value) { fifo.push(value); }
+        for (int value = 1000; value < 100000; ++value) { fifo.push(value); fifo.pop(); }
+
+        const long queueNodeAllocations = NodeCounter::allocations;
+        const long queueMapAllocations  = MapCounter::allocations;
+
+        for (int value = 100000; value < 1000000; ++value) { fifo.push(value); fifo.pop(); }
+
+        CHECK(fifo.size() == 1000 && fifo.back() == 1000000 - 1000);
+        CHECK(NodeCounter::allocations == queueNodeAllocations && MapCounter::allocations == queueMapAllocations);
+    }
+
+    CHECK(NodeCounter::liveBytes == 0 && MapCounter::liveBytes == 0);
+
+    /*不缓存时，每用完一个缓冲区就要申请一个新的*/
+    {
+        UncachedDeque deque;
+
+        for (int value = 0; value < 1000; ++value) { deque.push_back(value); }
+
+        const long nodeAllocations = NodeCounter::allocations;
+
+        for (int value = 1000; value < 1000 + 16 * 100; ++value) { deque.push_back(value); deque.pop_front(); }
+
+        CHECK(NodeCounter::allocations - nodeAllocations == 100);
+    }
+
+    CHECK(NodeCounter::liveBytes == 0 && MapCounter::liveBytes == 0);
+}
+
+void checkRelease(void)
+{
+    {
+        CachedDeque deque;
+
+        for (int value = 0; value < 1000; ++value) { deque.push_back(value); }
+
+        const long liveBytes = NodeCounter::liveBytes;
+
+        /*erase、clear 腾出的缓冲区只缓存 2 个，其余立即释放*/
+        deque.erase(deque.begin() + 100, deque.begin() + 900);
+        CHECK(deque.size() == 200 && deque[99] == 99 && deque[100] == 900);
+        CHECK(NodeCounter::liveBytes < liveBytes);
+
+        deque.clear();
+        CHECK(deque.empty() && NodeCounter::liveBytes == long(3 * 16 * sizeof(int)));
+
+        /*缓存的缓冲区被重用*/
+        const long nodeAllocations = NodeCounter::allocations;
+        for (int value = 0; value < 40; ++value) { deque.push_back(value); }
+        CHECK(NodeCounter::allocations == nodeAllocations && deque.back() == 39);
+
+        deque.clear();
+        deque.shrink_to_fit();
+        CHECK(NodeCounter::liveBytes == long(16 * sizeof(int)));
+
+        /*交换、移动之后缓存随之转移，析构时全部释放*/
+        CachedDeque other;
+        for (int value = 0; value < 100; ++value) { other.push_front(value); other.push_back(value); }
+        for (int value = 0; value < 100; ++value) { other.pop_front(); }
+
+        deque.swap(other);
+        CachedDeque moved(std::move(deque));
+        CHECK(moved.size() == 100 && moved.front() == 0 && moved.back() == 99);
+    }
+
+    CHECK(NodeCounter::liveBytes == 0 && MapCounter::liveBytes == 0);
+}
+
+template <typename Deque>
+double timeProducerConsumer(void)
+{
+    constexpr int OPERATIONS = 20000000;
+
+    Deque deque;
+    for (int value = 0; value < 1000; ++value) { deque.push_back(value); }
+
+    long total = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int value = 0; value < OPERATIONS; ++value)
+    {
+        deque.push_back(value);
+        total += deque.front();
+        deque.pop_front();
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+    CHECK(total > 0);
+
+    return elapsed.count() / OPERATIONS;
+}
+
+void compareSpeed(void)
+{
+    /*使用默认的 std::allocator 与 4 KiB 的缓冲区*/
+    typedef My_Deque<int, 0, std::allocator<int>, __DequePolicy<4096, 2, 0>>   Uncached;
+    typedef My_Deque<int, 0, std::allocator<int>, __DequePolicy<4096, 2, 2>>   Cached;
+
+    /*每个缓冲区 4 个元素，放大分配器的开销*/
+    typedef My_Deque<int, 0, std::allocator<int>, __DequePolicy<16, 2, 0>>     TinyUncached;
+    typedef My_Deque<int, 0, std::allocator<int>, __DequePolicy<16, 2, 2>>     TinyCached;
+
+    printf("producer / consumer queue, push_back + pop_front  4 KiB nodes : %.2f ns without cache, %.2f ns with cache;"
+           "  16 B nodes : %.2f ns without cache, %.2f ns with cache\n",
+           timeProducerConsumer<Uncached>(), timeProducerConsumer<Cached>(),
+           timeProducerConsumer<TinyUncached>(), timeProducerConsumer<TinyCached>());
+}
+
+int main(int argc, char const *argv[])
+{
+    checkSteadyState();
+    checkRelease();
+    compareSpeed();
+
+    return testResult();
+}
@@ -13,6 +13,7 @@
 #include "../../simple_allocator/simpleAlloc.h"
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <initializer_list>
 
@@ -23,7 +24,7 @@
  * @tparam Alloc 容器使用的分配器类型，默认为 `std::allocator<ListNode<Type>>`
 */
 template <typename Type, typename Alloc = std::allocator<ListNode<Type>>>
-class MyList
+class MyList : protected Simple_Alloc<ListNode<Type>, Alloc>
 {
     protected:
         using valueType      = Type;
@@ -39,7 +40,8 @@ class MyList
         using differenceType    = std::ptrdiff_t;
 
     public:
-        using linkType = listNode *;    // 链表节点指针
+        using linkType      = listNode *;   // 链表节点指针
+        using allocatorType = Alloc;        // 容器使用的分配器类型
 
     protected:
         /**
@@ -137,6 +139,58 @@ class MyList
             for (; __n; --__n) { this->push_back(valueType()); }
         }
 
+        /**
+         * @brief 辅助函数，把 `[__first, __last)` 内的元素依次赋值给现有节点，
+         *        多出来的节点删除，不够的再补上（尽量复用已经分配的节点）。
+        */
+        template <typename InputIterator>
+        void assignRange(InputIterator __first, InputIterator __last)
+        {
+            iterator current = this->begin();
+
+            for (; current != this->end() && __first != __last; ++current, ++__first)
+            {
+                *current = *__first;
+            }
+
+            if (__first == __last)
+            {
+                while (current != this->end()) { current = this->erase(current); }
+            }
+            else
+            {
+                for (; __first != __last; ++__first) { this->push_back(*__first); }
+            }
+        }
+
+        /**
+         * @brief 辅助函数，释放所有节点和空白节点，只在析构或者更换分配器之前调用。
+        */
+        void destroyAll(void)
+        {
+            this->clear();
+            this->freeNode(this->nodePointer);
+            this->nodePointer = nullptr;
+        }
+
+        /**
+         * @brief 辅助函数，接管 `__x` 的全部节点，`__x` 换上一个新的空白节点。
+         * 
+         * @brief - 调用前本链表不能持有任何节点，并且两个链表的分配器必须相等。
+        */
+        void steal(MyList & __x)
+        {
+            linkType newHeader = __x.getNode();     // 先分配，失败时两张链表都保持原样
+
+            this->nodePointer = __x.nodePointer;
+            this->nodeCount   = __x.nodeCount;
+
+            __x.nodePointer = newHeader;
+            __x.nodePointer->next = __x.nodePointer;
+            __x.nodePointer->prev = __x.nodePointer;
+            __x.nodeCount = 0ULL;
+        }
+
     public:
 
         /**
@@ -146,11 +200,19 @@ class MyList
         */
         MyList() : nodeCount(0ULL) { this->emptyInitialize(); }
 
+        /**
+         * @brief 使用指定的分配器对象（比如一块 arena）构建空链表。
+        */
+        explicit MyList(const Alloc & __alloc) : nodeAllocator(__alloc), nodeCount(0ULL) 
+        { 
+            this->emptyInitialize(); 
+        }
+
         /**
          * @brief 创造 `__n` 个链表节点，
          *        每一个节点都调用节点数据的默认构造函数进行构建。
         */
-        explicit MyList(sizeType __n) : nodeCount(0ULL)
+        explicit MyList(sizeType __n, const Alloc & __alloc = Alloc()) : nodeAllocator(__alloc), nodeCount(0ULL)
         {
             this->emptyInitialize();
             this->defaultInitialize(__n);
@@ -160,7 +222,8 @@ class MyList
          * @brief 创造 `__n` 个链表节点，
          *        每一个节点数据都设为 `__value`。
         */
-        MyList(sizeType __n, const valueType & __value) : nodeCount(0ULL)
+        MyList(sizeType __n, const valueType & __value, const Alloc & __alloc = Alloc()) 
+            : nodeAllocator(__alloc), nodeCount(0ULL)
         {
             this->emptyInitialize();
             this->fillInitialize(__n, __value);
@@ -169,7 +232,8 @@ class MyList
         /**
          * @brief 从初始化列表中获取数据并构造链表。
         */
-        explicit MyList(std::initializer_list<Type> __initList) : nodeCount(0ULL)
+        explicit MyList(std::initializer_list<Type> __initList, const Alloc & __alloc = Alloc()) 
+            : nodeAllocator(__alloc), nodeCount(0ULL)
         {
             this->emptyInitialize();
             
@@ -190,7 +254,8 @@ class MyList
                     typename InputIterator, 
                     typename = std::enable_if_t<!std::is_integral<InputIterator>::value>
             >
-        MyList(InputIterator __first, InputIterator __last) : nodeCount(0ULL)
+        MyList(InputIterator __first, InputIterator __last, const Alloc & __alloc = Alloc()) 
+            : nodeAllocator(__alloc), nodeCount(0ULL)
         {
             this->emptyInitialize();
 
@@ -204,9 +269,79 @@ class MyList
             }
         }
 
-        MyList(MyList &&) = default;
+        /**
+         * @brief 拷贝构造函数，新链表的分配器由 select_on_container_copy_construction 决定。
+        */
+        MyList(const MyList & __x) : nodeAllocator(__x.selectOnCopy()), nodeCount(0ULL)
+        {
+            this->emptyInitialize();
+            this->assignRange(__x.begin(), __x.end());
+        }
+
+        /**
+         * @brief 移动构造函数，分配器随节点一起移动过来，`__x` 留下一张空链表。
+        */
+        MyList(MyList && __x) : nodeAllocator(__x.getAllocator()), nodePointer(nullptr), nodeCount(0ULL)
+        {
+            this->steal(__x);
+        }
+
+        /**
+         * @brief 拷贝赋值，分配器是否随之拷贝由 propagate_on_container_copy_assignment 决定，
+         *        不更换分配器时尽量复用已有的节点。
+        */
+        MyList & operator=(const MyList & __x)
+        {
+            if (this == &__x) { return *this; }
+
+            if (nodeAllocator::propagateOnCopyAssignment::value && !this->equalAllocator(__x))
+            {
+                /*旧节点只能由旧分配器释放*/
+                this->destroyAll();
+                this->copyAssignAllocator(__x);
+                this->nodeCount = 0ULL;
+                this->emptyInitialize();
+            }
+            else { this->copyAssignAllocator(__x); }
+
+            this->assignRange(__x.begin(), __x.end());
+
+            return *this;
+        }
+
+        /**
+         * @brief 移动赋值。
+         * 
+         * @brief - 分配器会随之移动，或者两个分配器相等时，直接接管 `__x` 的节点；
+         *          否则本链表的分配器无法释放 `__x` 的节点，只能逐个移动元素。
+        */
+        MyList & operator=(MyList && __x)
+        {
+            if (this == &__x) { return *this; }
 
-        ~MyList() = default;
+            if (nodeAllocator::propagateOnMoveAssignment::value || this->equalAllocator(__x))
+            {
+                this->destroyAll();
+                this->moveAssignAllocator(__x);
+                this->steal(__x);
+            }
+            else
+            {
+                this->assignRange(std::make_move_iterator(__x.begin()), std::make_move_iterator(__x.end()));
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief 析构并释放所有节点（包括空白节点）。
+        */
+        ~MyList() { if (this->nodePointer) { this->destroyAll(); } }
+
+        /**
+         * @brief 获取链表使用的分配器对象的副本。
+        */
+        allocatorType get_allocator() const { return allocatorType(this->getAllocator()); }
 
         /**
          * @brief 获取链表第一个元素的迭代器。 
@@ -435,7 +570,8 @@ class MyList
          * @brief 交换两张链表 
          * 
          * @brief - 实现很粗暴，
-         *          交换两张链表的链表指针和链表节点计数即可。
+         *          交换两张链表的链表指针和链表节点计数即可，
+         *          分配器是否随之交换由 propagate_on_container_swap 决定（不交换时两个分配器必须相等）。
         */
         void swap(MyList & __x) 
         {
@@ -447,6 +583,8 @@ class MyList
 
             this->setSize(__x.size());
             __x.setSize(tempSize);
+
+            this->swapAllocator(__x);
         }
 };
 
@@ -594,10 +732,11 @@ void MyList<Type, Alloc>::sort()
     if (this->size() == 0 || this->size() == 1) { return; }
 
     /**
-     * 一些新的中介数据区。
+     * 一些新的中介数据区，它们必须与本链表使用同一个分配器（分配器可能不能默认构造），
+     * 所以 counter 在用到的时候才构建。
     */
-    MyList<Type, Alloc> carry;
-    MyList<Type, Alloc> counter[64];
+    MyList<Type, Alloc> carry(this->get_allocator());
+    std::optional<MyList<Type, Alloc>> counter[64];
     int fill = 0;
 
     while (!this->empty())
@@ -605,22 +744,24 @@ void MyList<Type, Alloc>::sort()
         carry.splice(carry.begin(), *this, this->begin());
         int i = 0;
 
-        while (i < fill && !counter[i].empty())
+        while (i < fill && !counter[i]->empty())
         {
-            counter[i].merge(carry);
-            carry.swap(counter[i++]);
+            counter[i]->merge(carry);
+            carry.swap(*counter[i++]);
         }
 
-        carry.swap(counter[i]);
+        if (!counter[i]) { counter[i].emplace(this->get_allocator()); }
+
+        carry.swap(*counter[i]);
         if (i == fill) ++fill;
     }
 
     for (int i = 1; i < fill; ++i) 
     {  
-        counter[i].merge(counter[i - 1]);
+        counter[i]->merge(*counter[i - 1]);
     }
 
-    this->swap(counter[fill - 1]);
+    this->swap(*counter[fill - 1]);
 }
 
 #endif // __LIST_H_
\ No newline at end of file
@@ -1,38 +1,339 @@
 #ifndef _SIMPLE_ALLOC_H_
 #define _SIMPLE_ALLOC_H_
 
-#include <cctype>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/*
+    容器与分配器之间的一层包装。
+
+    容器继承 Simple_Alloc，把（重绑定之后的）分配器对象保存在自己身上，而不是每次调用都临时构造一个 Alloc，
+    因此有状态的分配器（比如由一次请求持有的 arena）也可以用于 My_Vector、MyList、My_Deque 和 RB_Tree。
+    没有状态的分配器通过空基类优化（EBO）存放，不会让容器变大。
+
+    Alloc 可以是下面两种风格之一：
+
+        标准风格    有 value_type 的分配器（std::allocator 等），经 std::allocator_traits 重绑定到 Type，按元素个数申请
+        SGI 风格    没有 value_type、按字节申请的分配器（sgiAlloc、mallocAlloc 等），原样保存，按字节数申请，
+                    分配器提供 allocate(bytes, align) / deallocate(ptr, bytes, align) 时，一并传递 alignof(Type)
+
+    分配器还可以提供 reallocate（SGI 风格按字节：reallocate(ptr, oldBytes, newBytes[, align])，
+    标准风格按元素：reallocate(ptr, oldN, newN)），此时 canReallocate 为真，
+    容器可以对可平凡重定位的元素用 reallocate 扩容，让底层有机会原地扩展而不是申请、拷贝、释放。
+
+    分配器还可以提供 goodSize(bytes)，返回申请 bytes 字节时实际交出的字节数（比如向上取整到尺寸级别），
+    容器的扩容策略可以据此把分配器多给的空间也用上。
+
+    SGI 风格的分配器可以像标准分配器那样声明 propagate_on_container_copy_assignment、
+    propagate_on_container_move_assignment、propagate_on_container_swap 和 is_always_equal，
+    没有声明时取与 std::allocator_traits 相同的默认值（空类型总是相等，其余都不传播）。
+*/
+
+template <typename Alloc, typename = void>
+struct __isStdAllocator : std::false_type {};
+
+template <typename Alloc>
+struct __isStdAllocator<Alloc, std::void_t<typename Alloc::value_type>> : std::true_type {};
+
+template <typename Alloc, typename = void>
+struct __hasAlignedAllocate : std::false_type {};
+
+template <typename Alloc>
+struct __hasAlignedAllocate<
+    Alloc, std::void_t<decltype(std::declval<Alloc &>().allocate(std::size_t(), std::size_t()))>
+> : std::true_type {};
+
+template <typename Alloc, typename = void>
+struct __hasReallocate : std::false_type {};
+
+template <typename Alloc>
+struct __hasReallocate<
+    Alloc, std::void_t<decltype(std::declval<Alloc &>().reallocate((void *)nullptr, std::size_t(), std::size_t()))>
+> : std::true_type {};
+
+template <typename Alloc, typename = void>
+struct __hasAlignedReallocate : std::false_type {};
+
+template <typename Alloc>
+struct __hasAlignedReallocate<
+    Alloc, std::void_t<decltype(std::declval<Alloc &>().reallocate((void *)nullptr, std::size_t(), std::size_t(), std::size_t()))>
+> : std::true_type {};
+
+template <typename Type, typename Alloc, typename = void>
+struct __hasTypedReallocate : std::false_type {};
 
 template <typename Type, typename Alloc>
-class Simple_Alloc
+struct __hasTypedReallocate<
+    Type, Alloc, std::void_t<decltype(std::declval<Alloc &>().reallocate((Type *)nullptr, std::size_t(), std::size_t()))>
+> : std::true_type {};
+
+template <typename Alloc, typename = void>
+struct __hasGoodSize : std::false_type {};
+
+template <typename Alloc>
+struct __hasGoodSize<Alloc, std::void_t<decltype(std::declval<const Alloc &>().goodSize(std::size_t()))>> : std::true_type {};
+
+template <typename Alloc, typename = void>
+struct __propagateOnCopyAssignment : std::false_type {};
+
+template <typename Alloc>
+struct __propagateOnCopyAssignment<Alloc, std::void_t<typename Alloc::propagate_on_container_copy_assignment>>
+    : Alloc::propagate_on_container_copy_assignment {};
+
+template <typename Alloc, typename = void>
+struct __propagateOnMoveAssignment : std::false_type {};
+
+template <typename Alloc>
+struct __propagateOnMoveAssignment<Alloc, std::void_t<typename Alloc::propagate_on_container_move_assignment>>
+    : Alloc::propagate_on_container_move_assignment {};
+
+template <typename Alloc, typename = void>
+struct __propagateOnSwap : std::false_type {};
+
+template <typename Alloc>
+struct __propagateOnSwap<Alloc, std::void_t<typename Alloc::propagate_on_container_swap>>
+    : Alloc::propagate_on_container_swap {};
+
+template <typename Alloc, typename = void>
+struct __isAlwaysEqual : std::is_empty<Alloc> {};
+
+template <typename Alloc>
+struct __isAlwaysEqual<Alloc, std::void_t<typename Alloc::is_always_equal>> : Alloc::is_always_equal {};
+
+/**
+ * @brief SGI 风格的分配器：原样保存，按字节数申请和释放。
+*/
+template <typename Type, typename Alloc, bool = __isStdAllocator<Alloc>::value>
+struct __SimpleAllocTraits
+{
+    typedef Alloc                                   allocatorType;
+    typedef __propagateOnCopyAssignment<Alloc>      propagateOnCopyAssignment;
+    typedef __propagateOnMoveAssignment<Alloc>      propagateOnMoveAssignment;
+    typedef __propagateOnSwap<Alloc>                propagateOnSwap;
+    typedef __isAlwaysEqual<Alloc>                  isAlwaysEqual;
+
+    static_assert(
+        __hasAlignedAllocate<Alloc>::value || alignof(Type) <= alignof(std::max_align_t),
+        "over-aligned types need an allocator with allocate(bytes, align)"
+    );
+
+    static Type * allocate(allocatorType & __alloc, std::size_t __n)
+    {
+        if constexpr (__hasAlignedAllocate<Alloc>::value) { return (Type *)__alloc.allocate(__n * sizeof(Type), alignof(Type)); }
+        else { return (Type *)__alloc.allocate(__n * sizeof(Type)); }
+    }
+
+    static void deallocate(allocatorType & __alloc, Type * __ptr, std::size_t __n)
+    {
+        if constexpr (__hasAlignedAllocate<Alloc>::value) { __alloc.deallocate(__ptr, __n * sizeof(Type), alignof(Type)); }
+        else { __alloc.deallocate(__ptr, __n * sizeof(Type)); }
+    }
+
+    /*按对齐方式申请的内存，也必须按同样的方式 reallocate*/
+    static constexpr bool canReallocate = 
+        __hasAlignedAllocate<Alloc>::value ? __hasAlignedReallocate<Alloc>::value : __hasReallocate<Alloc>::value;
+
+    static Type * reallocate(allocatorType & __alloc, Type * __ptr, std::size_t __oldN, std::size_t __newN)
+    {
+        if constexpr (__hasAlignedAllocate<Alloc>::value)
+        {
+            return (Type *)__alloc.reallocate(__ptr, __oldN * sizeof(Type), __newN * sizeof(Type), alignof(Type));
+        }
+        else { return (Type *)__alloc.reallocate(__ptr, __oldN * sizeof(Type), __newN * sizeof(Type)); }
+    }
+
+    static allocatorType selectOnCopy(const allocatorType & __alloc) { return __alloc; }
+};
+
+/**
+ * @brief 标准风格的分配器：重绑定到 Type，一切交给 std::allocator_traits
+ *        （std::allocator 对超出默认对齐的类型会使用对齐的 operator new）。
+*/
+template <typename Type, typename Alloc>
+struct __SimpleAllocTraits<Type, Alloc, true>
 {
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Type>  allocatorType;
+    typedef std::allocator_traits<allocatorType>                                traits;
+
+    typedef typename traits::propagate_on_container_copy_assignment propagateOnCopyAssignment;
+    typedef typename traits::propagate_on_container_move_assignment propagateOnMoveAssignment;
+    typedef typename traits::propagate_on_container_swap            propagateOnSwap;
+    typedef typename traits::is_always_equal                        isAlwaysEqual;
+
+    static Type * allocate(allocatorType & __alloc, std::size_t __n)
+    {
+        return std::to_address(traits::allocate(__alloc, __n));
+    }
+
+    static void deallocate(allocatorType & __alloc, Type * __ptr, std::size_t __n)
+    {
+        traits::deallocate(__alloc, __ptr, __n);
+    }
+
+    static constexpr bool canReallocate = __hasTypedReallocate<Type, allocatorType>::value;
+
+    static Type * reallocate(allocatorType & __alloc, Type * __ptr, std::size_t __oldN, std::size_t __newN)
+    {
+        return __alloc.reallocate(__ptr, __oldN, __newN);
+    }
+
+    static allocatorType selectOnCopy(const allocatorType & __alloc)
+    {
+        return traits::select_on_container_copy_construction(__alloc);
+    }
+};
+
+/**
+ * @brief 分配器对象的存放处，空的分配器作为基类存放（EBO），不占空间。
+*/
+template <typename Alloc, bool = std::is_empty<Alloc>::value && !std::is_final<Alloc>::value>
+class __AllocHolder : private Alloc
+{
+    public:
+        __AllocHolder() = default;
+        explicit __AllocHolder(const Alloc & __alloc) : Alloc(__alloc) {}
+
+        Alloc & allocInstance(void) noexcept { return *this; }
+        const Alloc & allocInstance(void) const noexcept { return *this; }
+};
+
+template <typename Alloc>
+class __AllocHolder<Alloc, false>
+{
+    private:
+        Alloc alloc;
+
+    public:
+        __AllocHolder() = default;
+        explicit __AllocHolder(const Alloc & __alloc) : alloc(__alloc) {}
+
+        Alloc & allocInstance(void) noexcept { return this->alloc; }
+        const Alloc & allocInstance(void) const noexcept { return this->alloc; }
+};
+
+template <typename Type, typename Alloc>
+class Simple_Alloc : private __AllocHolder<typename __SimpleAllocTraits<Type, Alloc>::allocatorType>
+{
+    private:
+        typedef __SimpleAllocTraits<Type, Alloc>                allocTraits;
+        typedef __AllocHolder<typename allocTraits::allocatorType> holder;
+
     public:
-        static Type * allocate(std::size_t __n)
+        /**
+         * 实际保存的分配器类型（标准风格的分配器已重绑定到 Type）。
+        */
+        typedef typename allocTraits::allocatorType             allocatorType;
+
+        typedef typename allocTraits::propagateOnCopyAssignment propagateOnCopyAssignment;
+        typedef typename allocTraits::propagateOnMoveAssignment propagateOnMoveAssignment;
+        typedef typename allocTraits::propagateOnSwap           propagateOnSwap;
+        typedef typename allocTraits::isAlwaysEqual             isAlwaysEqual;
+
+        /**
+         * 分配器是否提供 reallocate()。
+        */
+        static constexpr bool canReallocate = allocTraits::canReallocate;
+
+        Simple_Alloc() = default;
+
+        /**
+         * @brief 从任意可以转换成 allocatorType 的分配器构造（包括同一分配器重绑定到其他类型的版本）。
+        */
+        template <
+                    typename OtherAlloc,
+                    typename = std::enable_if_t<std::is_constructible<allocatorType, const OtherAlloc &>::value>
+            >
+        explicit Simple_Alloc(const OtherAlloc & __alloc) : holder(allocatorType(__alloc)) {}
+
+        Type * allocate(std::size_t __n)
         {
-            Alloc allocInstance;
-            return (!__n) ? nullptr : (Type *)allocInstance.allocate(__n * sizeof(Type));
+            return (!__n) ? nullptr : allocTraits::allocate(this->allocInstance(), __n);
         }
 
-        static Type * allocate(void)
+        Type * allocate(void)
         {
-            Alloc allocInstance;
-            return (Type *)allocInstance.allocate(sizeof(Type));
+            return allocTraits::allocate(this->allocInstance(), 1);
         }
 
-        static void deallocate(Type * __ptr, std::size_t __n)
+        void deallocate(Type * __ptr, std::size_t __n)
         {
-            Alloc allocInstance;
             if (__n != 0)
             {
-                allocInstance.deallocate(__ptr, __n * sizeof(Type));
+                allocTraits::deallocate(this->allocInstance(), __ptr, __n);
             }
         }
 
-        static void deallocate(Type *__ptr)
+        void deallocate(Type *__ptr)
+        {
+            allocTraits::deallocate(this->allocInstance(), __ptr, 1);
+        }
+
+        /**
+         * @brief 把 __ptr 处 __oldN 个元素的内存调整为 __newN 个元素，按字节搬移原有的内容（仅当 canReallocate 时可用），
+         *        只适用于可平凡重定位的元素。
+        */
+        Type * reallocate(Type * __ptr, std::size_t __oldN, std::size_t __newN)
+        {
+            if (__ptr == nullptr || __oldN == 0) { return this->allocate(__newN); }
+
+            return allocTraits::reallocate(this->allocInstance(), __ptr, __oldN, __newN);
+        }
+
+        /**
+         * @brief 申请 __bytes 字节时分配器实际交出的字节数，分配器没有提供 goodSize() 时原样返回。
+        */
+        std::size_t goodSize(std::size_t __bytes) const
+        {
+            if constexpr (__hasGoodSize<allocatorType>::value) { return this->getAllocator().goodSize(__bytes); }
+            else { return __bytes; }
+        }
+
+        allocatorType & getAllocator(void) noexcept { return this->allocInstance(); }
+        const allocatorType & getAllocator(void) const noexcept { return this->allocInstance(); }
+
+        /**
+         * @brief 拷贝构造容器时，新容器应当使用的分配器。
+        */
+        allocatorType selectOnCopy(void) const { return allocTraits::selectOnCopy(this->allocInstance()); }
+
+        /**
+         * @brief 两个分配器能否互相释放对方申请的内存。
+        */
+        bool equalAllocator(const Simple_Alloc & __other) const
+        {
+            if constexpr (isAlwaysEqual::value) { return true; }
+            else { return this->getAllocator() == __other.getAllocator(); }
+        }
+
+        /**
+         * @brief 容器拷贝赋值时，按 propagateOnCopyAssignment 决定是否一并拷贝分配器。
+        */
+        void copyAssignAllocator(const Simple_Alloc & __other)
+        {
+            if constexpr (propagateOnCopyAssignment::value) { this->getAllocator() = __other.getAllocator(); }
+        }
+
+        /**
+         * @brief 容器移动赋值时，按 propagateOnMoveAssignment 决定是否一并移动分配器。
+        */
+        void moveAssignAllocator(Simple_Alloc & __other)
         {
-            Alloc allocInstance;
-            allocInstance.deallocate(__ptr, sizeof(Type));
+            if constexpr (propagateOnMoveAssignment::value) { this->getAllocator() = std::move(__other.getAllocator()); }
+        }
+
+        /**
+         * @brief 容器交换时，按 propagateOnSwap 决定是否一并交换分配器。
+        */
+        void swapAllocator(Simple_Alloc & __other)
+        {
+            if constexpr (propagateOnSwap::value)
+            {
+                using std::swap;
+                swap(this->getAllocator(), __other.getAllocator());
+            }
         }
 };
 
-#endif // _SIMPLE_ALLOC_H_
\ No newline at end of file
+#endif // _SIMPLE_ALLOC_H_
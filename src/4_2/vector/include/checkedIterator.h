@@ -0,0 +1,196 @@
+#ifndef _CHECKED_ITERATOR_H_
+#define _CHECKED_ITERATOR_H_
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+/*
+    My_Vector 检查模式的编译期开关，默认关闭。编译时定义 __VECTOR_CHECKED_ 为 1 即可打开：
+
+    1. operator[]、front()、back()、pop_back() 检查下标是否越界、vector 是否为空；
+    2. iterator / constIterator 换成 __CheckedIterator，解引用、移动、比较、传给 insert() / erase() 时检查：
+       迭代器属于这个 vector、vector 没有重新分配过内存（扩容、reserve、shrink_to_fit 之后旧迭代器都失效）、没有越界。
+
+    关闭时迭代器就是原生指针，所有检查都在编译期消失，没有任何额外开销。
+    检查失败时调用 vectorCheckHandler（默认打印出错原因后 abort()），可以用 setVectorCheckHandler() 替换，
+    用法与第一级配置器的 setMallocHandler() 相同。
+
+    检查只认 vector 当前的数组：swap() 或被移动之后，原来的迭代器同样视为失效（比标准的规定更严格），
+    vector 析构之后再使用它的迭代器则无法检查。
+*/
+#ifndef __VECTOR_CHECKED_
+#define __VECTOR_CHECKED_ 0
+#endif
+
+typedef void (*__VectorCheckHandler)(const char * __message);
+
+inline void __defaultVectorCheckHandler(const char * __message)
+{
+    std::fprintf(stderr, "My_Vector check failed: %s\n", __message);
+    std::abort();
+}
+
+inline __VectorCheckHandler vectorCheckHandler = __defaultVectorCheckHandler;
+
+/**
+ * @brief 设置检查失败时的处理函数，返回原来的处理函数。
+*/
+inline __VectorCheckHandler setVectorCheckHandler(__VectorCheckHandler __handler)
+{
+    __VectorCheckHandler oldHandler = vectorCheckHandler;
+    vectorCheckHandler = __handler;
+
+    return oldHandler;
+}
+
+#if __VECTOR_CHECKED_
+#define __VECTOR_ASSERT(condition, message)                     \
+    do                                                          \
+    {                                                           \
+        if (!(condition)) { vectorCheckHandler(message); }      \
+    } while (false)
+#else
+#define __VECTOR_ASSERT(condition, message) ((void)0)
+#endif
+
+/**
+ * @brief 检查模式下 My_Vector 的迭代器：除了当前位置，还记住所属 vector 的 start、finish 成员的地址，
+ *        以及创建时 vector 的数组首地址，每次使用时据此判断迭代器是否失效、是否越界。
+ *
+ * @tparam Type  元素类型
+ * @tparam Value 迭代器指向的类型（`Type` 或 `const Type`）
+*/
+template <typename Type, typename Value>
+class __CheckedIterator
+{
+    private:
+        template <typename, typename> friend class __CheckedIterator;
+
+        /*比较、相减允许 iterator 与 constIterator 混用，定义见类外*/
+        template <typename T, typename V1, typename V2>
+        friend bool operator==(const __CheckedIterator<T, V1> &, const __CheckedIterator<T, V2> &);
+
+        template <typename T, typename V1, typename V2>
+        friend bool operator<(const __CheckedIterator<T, V1> &, const __CheckedIterator<T, V2> &);
+
+        template <typename T, typename V1, typename V2>
+        friend std::ptrdiff_t operator-(const __CheckedIterator<T, V1> &, const __CheckedIterator<T, V2> &);
+
+        Value *         current;        // 当前位置
+        Type * const *  startSlot;      // 所属 vector 的 start 成员
+        Type * const *  finishSlot;     // 所属 vector 的 finish 成员
+        Type *          storage;        // 创建迭代器时 vector 的数组首地址
+
+        /**
+         * @brief 迭代器移动 __offset 之后的位置必须在 [begin(), end()] 内（__dereference 时不能是 end()）。
+        */
+        void check(std::ptrdiff_t __offset, bool __dereference) const
+        {
+            __VECTOR_ASSERT(this->startSlot != nullptr, "use of a singular iterator");
+            __VECTOR_ASSERT(*this->startSlot == this->storage, "iterator invalidated by reallocation");
+
+            const std::ptrdiff_t index = (this->current - this->storage) + __offset;
+            const std::ptrdiff_t size  = *this->finishSlot - *this->startSlot;
+
+            if (__dereference) { __VECTOR_ASSERT(index >= 0 && index < size, "dereferenced iterator out of range"); }
+            else { __VECTOR_ASSERT(index >= 0 && index <= size, "iterator moved out of range"); }
+        }
+
+        template <typename Other>
+        void checkComparable(const __CheckedIterator<Type, Other> & __other) const
+        {
+            __VECTOR_ASSERT(this->startSlot == __other.startSlot, "iterators from different vectors");
+        }
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef std::remove_const_t<Value>      value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef Value *                         pointer;
+        typedef Value &                         reference;
+
+        __CheckedIterator() noexcept : current(nullptr), startSlot(nullptr), finishSlot(nullptr), storage(nullptr) {}
+
+        __CheckedIterator(Value * __current, Type * const * __startSlot, Type * const * __finishSlot) noexcept
+            : current(__current), startSlot(__startSlot), finishSlot(__finishSlot), storage(*__startSlot) {}
+
+        /**
+         * @brief iterator 可以转换为 constIterator。
+        */
+        template <typename Other, typename = std::enable_if_t<std::is_const<Value>::value && std::is_same<Other, Type>::value>>
+        __CheckedIterator(const __CheckedIterator<Type, Other> & __other) noexcept
+            : current(__other.current), startSlot(__other.startSlot), finishSlot(__other.finishSlot), storage(__other.storage) {}
+
+        /**
+         * @brief 检查迭代器属于 start 成员为 *__startSlot 的 vector 并且仍然有效，返回原生指针（供 My_Vector 使用）。
+        */
+        Value * checkedBase(Type * const * __startSlot) const
+        {
+            __VECTOR_ASSERT(this->startSlot == __startSlot, "iterator does not belong to this vector");
+            this->check(0, false);
+
+            return this->current;
+        }
+
+        Value * base(void) const noexcept { return this->current; }
+
+        reference operator*() const { this->check(0, true); return *this->current; }
+        pointer  operator->() const { this->check(0, true); return this->current; }
+
+        reference operator[](difference_type __n) const { this->check(__n, true); return this->current[__n]; }
+
+        __CheckedIterator & operator++() { this->check(1, false); ++this->current; return *this; }
+        __CheckedIterator & operator--() { this->check(-1, false); --this->current; return *this; }
+
+        __CheckedIterator operator++(int) { __CheckedIterator old = *this; ++*this; return old; }
+        __CheckedIterator operator--(int) { __CheckedIterator old = *this; --*this; return old; }
+
+        __CheckedIterator & operator+=(difference_type __n) { this->check(__n, false); this->current += __n; return *this; }
+        __CheckedIterator & operator-=(difference_type __n) { return *this += -__n; }
+
+        __CheckedIterator operator+(difference_type __n) const { __CheckedIterator result = *this; return result += __n; }
+        __CheckedIterator operator-(difference_type __n) const { __CheckedIterator result = *this; return result -= __n; }
+
+        friend __CheckedIterator operator+(difference_type __n, const __CheckedIterator & __iter) { return __iter + __n; }
+};
+
+/**
+ * @brief 两个迭代器必须属于同一个 vector，iterator 与 constIterator 之间也可以比较、相减。
+*/
+template <typename Type, typename V1, typename V2>
+inline bool operator==(const __CheckedIterator<Type, V1> & __x, const __CheckedIterator<Type, V2> & __y)
+{
+    __x.checkComparable(__y);
+    return __x.current == __y.current;
+}
+
+template <typename Type, typename V1, typename V2>
+inline bool operator!=(const __CheckedIterator<Type, V1> & __x, const __CheckedIterator<Type, V2> & __y) { return !(__x == __y); }
+
+template <typename Type, typename V1, typename V2>
+inline bool operator<(const __CheckedIterator<Type, V1> & __x, const __CheckedIterator<Type, V2> & __y)
+{
+    __x.checkComparable(__y);
+    return __x.current < __y.current;
+}
+
+template <typename Type, typename V1, typename V2>
+inline bool operator>(const __CheckedIterator<Type, V1> & __x, const __CheckedIterator<Type, V2> & __y) { return __y < __x; }
+
+template <typename Type, typename V1, typename V2>
+inline bool operator<=(const __CheckedIterator<Type, V1> & __x, const __CheckedIterator<Type, V2> & __y) { return !(__y < __x); }
+
+template <typename Type, typename V1, typename V2>
+inline bool operator>=(const __CheckedIterator<Type, V1> & __x, const __CheckedIterator<Type, V2> & __y) { return !(__x < __y); }
+
+template <typename Type, typename V1, typename V2>
+inline std::ptrdiff_t operator-(const __CheckedIterator<Type, V1> & __x, const __CheckedIterator<Type, V2> & __y)
+{
+    __x.checkComparable(__y);
+    return __x.current - __y.current;
+}
+
+#endif // _CHECKED_ITERATOR_H_
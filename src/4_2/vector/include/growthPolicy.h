@@ -0,0 +1,80 @@
+#ifndef _GROWTH_POLICY_H_
+#define _GROWTH_POLICY_H_
+
+#include <cstddef>
+
+/*
+    My_Vector 的扩容策略（GrowthPolicy 模板参数）。
+
+    每个策略只需提供一个静态函数：
+
+        template <typename GoodSize>
+        static std::size_t nextCapacity(std::size_t size, std::size_t required, std::size_t elementSize, GoodSize goodSize);
+
+    size 为当前元素个数，required 为插入之后至少需要的元素个数（总是大于 size），
+    elementSize 为 sizeof(Type)，goodSize(bytes) 返回分配器实际会交出的字节数（分配器不提供时原样返回），
+    返回值为新的容量（不得小于 required）。
+
+        doublingGrowth      每次翻倍（SGI 原版的做法，也是默认策略）
+        oneAndHalfGrowth    每次增长到 1.5 倍，之前释放掉的几块内存加起来有机会装下新的数组，被分配器复用
+        pageGrowth          1.5 倍增长，超过一页之后容量按整页取整，大块内存不留半页的零头
+        sizeClassGrowth     翻倍之后再把容量补足到分配器的尺寸级别，分配器多给的空间不浪费
+*/
+
+/**
+ * @brief 按 Numerator / Denominator 的倍数增长，至少增长一个元素。
+*/
+template <std::size_t Numerator, std::size_t Denominator>
+struct __FactorGrowth
+{
+    static_assert(Numerator > Denominator, "growth factor must be greater than 1");
+
+    template <typename GoodSize>
+    static std::size_t nextCapacity(std::size_t __size, std::size_t __required, std::size_t, GoodSize)
+    {
+        const std::size_t grown = __size + (__size * (Numerator - Denominator) + Denominator - 1) / Denominator;
+
+        return (grown > __required) ? grown : __required;
+    }
+};
+
+/**
+ * @brief 1.5 倍增长，超过 PageBytes 之后把数组的字节数向上取整到整页。
+*/
+template <std::size_t PageBytes = 4096>
+struct __PageGrowth
+{
+    static_assert((PageBytes & (PageBytes - 1)) == 0, "page size must be a power of 2");
+
+    template <typename GoodSize>
+    static std::size_t nextCapacity(std::size_t __size, std::size_t __required, std::size_t __elementSize, GoodSize __goodSize)
+    {
+        const std::size_t capacity = __FactorGrowth<3, 2>::nextCapacity(__size, __required, __elementSize, __goodSize);
+        const std::size_t bytes    = capacity * __elementSize;
+
+        if (bytes < PageBytes) { return capacity; }
+
+        return ((bytes + PageBytes - 1) & ~(PageBytes - 1)) / __elementSize;
+    }
+};
+
+/**
+ * @brief 翻倍之后，把容量补足到分配器实际会交出的字节数（比如 sgiAlloc 的 free-list 区块大小）。
+*/
+struct __SizeClassGrowth
+{
+    template <typename GoodSize>
+    static std::size_t nextCapacity(std::size_t __size, std::size_t __required, std::size_t __elementSize, GoodSize __goodSize)
+    {
+        const std::size_t capacity = __FactorGrowth<2, 1>::nextCapacity(__size, __required, __elementSize, __goodSize);
+
+        return __goodSize(capacity * __elementSize) / __elementSize;
+    }
+};
+
+typedef __FactorGrowth<2, 1>    doublingGrowth;
+typedef __FactorGrowth<3, 2>    oneAndHalfGrowth;
+typedef __PageGrowth<>          pageGrowth;
+typedef __SizeClassGrowth       sizeClassGrowth;
+
+#endif // _GROWTH_POLICY_H_
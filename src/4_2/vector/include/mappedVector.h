@@ -0,0 +1,312 @@
+#ifndef _MAPPED_VECTOR_H_
+#define _MAPPED_VECTOR_H_
+
+#include "./myVector.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#if defined(_WIN32)
+#error "My_MappedVector requires POSIX mmap"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+    数据保存在内存映射文件中的 vector，只用于平凡可拷贝的元素。
+
+    文件的内容就是数组本身（前面加一个 64 字节的文件头，记录元素大小和元素个数），
+    打开一个已有的文件只需要 mmap，不需要解析或拷贝，大的查找表启动时 O(1) 就能用上。
+
+    My_MappedVector 就是一个 My_Vector，分配器换成了 __MappedFileAllocator：
+    它的 allocate / reallocate 把文件 ftruncate 到新的长度、再用 mremap 扩展映射（Linux 之外重新 mmap），
+    元素可平凡重定位，My_Vector 的扩容本来就走 reallocate，原有的数据留在文件里，不做任何拷贝。
+    默认的扩容策略为 sizeClassGrowth，文件总是整页大小。
+
+    元素个数只在 sync() 和析构时写回文件头，之前的修改已经在页缓存中，但进程崩溃时文件头记录的可能还是旧的个数；
+    sync() 同时调用 msync()，把数据真正写到磁盘上。
+*/
+
+/**
+ * @brief My_MappedVector 的文件头，位于文件开头。
+*/
+struct __MappedVectorHeader
+{
+    char            magic[8];       // "MYVECTOR"
+    std::uint64_t   elementSize;    // sizeof(Type)，打开时检查
+    std::uint64_t   elementAlign;   // alignof(Type)，打开时检查
+    std::uint64_t   size;           // 元素个数
+    std::uint64_t   reserved[4];
+};
+
+/**
+ * @brief 一个按读写方式打开、整个映射到内存中的文件：文件头之后的部分存放数组。
+*/
+class __MappedFile
+{
+    public:
+        static constexpr std::size_t HEADER_BYTES = 64;
+        static constexpr std::size_t PAGE_BYTES   = 4096;
+
+        static_assert(sizeof(__MappedVectorHeader) == HEADER_BYTES, "mapped vector header must stay 64 bytes");
+
+    private:
+        int         fd;
+        char *      base;       // 映射的首地址（文件头）
+        std::size_t length;     // 映射（即文件）的字节数
+
+        [[noreturn]] static void fail(const char * __what, const std::string & __path)
+        {
+            throw std::system_error(errno, std::generic_category(), std::string(__what) + " " + __path);
+        }
+
+        void map(const std::string & __path)
+        {
+            void * mapped = ::mmap(nullptr, this->length, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+
+            if (mapped == MAP_FAILED) { ::close(this->fd); fail("mmap", __path); }
+
+            this->base = static_cast<char *>(mapped);
+        }
+
+    public:
+        /**
+         * @brief 打开（不存在时创建）__path，检查文件头中的元素大小与对齐是否与 __elementSize、__elementAlign 一致。
+        */
+        __MappedFile(const std::string & __path, std::size_t __elementSize, std::size_t __elementAlign)
+            : fd(-1), base(nullptr), length(0)
+        {
+            this->fd = ::open(__path.c_str(), O_RDWR | O_CREAT, 0644);
+
+            if (this->fd < 0) { fail("open", __path); }
+
+            struct stat status;
+            if (::fstat(this->fd, &status) != 0) { ::close(this->fd); fail("fstat", __path); }
+
+            const bool created = (status.st_size == 0);
+
+            if (created)
+            {
+                if (::ftruncate(this->fd, HEADER_BYTES) != 0) { ::close(this->fd); fail("ftruncate", __path); }
+
+                this->length = HEADER_BYTES;
+            }
+            else { this->length = std::size_t(status.st_size); }
+
+            if (this->length < HEADER_BYTES)
+            {
+                ::close(this->fd);
+                throw std::runtime_error("not a mapped vector file: " + __path);
+            }
+
+            this->map(__path);
+
+            __MappedVectorHeader * fileHeader = this->header();
+
+            if (created)
+            {
+                std::memcpy(fileHeader->magic, "MYVECTOR", sizeof(fileHeader->magic));
+                fileHeader->elementSize  = __elementSize;
+                fileHeader->elementAlign = __elementAlign;
+                fileHeader->size         = 0;
+            }
+            else if (std::memcmp(fileHeader->magic, "MYVECTOR", sizeof(fileHeader->magic)) != 0  ||
+                     fileHeader->elementSize != __elementSize || fileHeader->elementAlign != __elementAlign ||
+                     fileHeader->size > (this->length - HEADER_BYTES) / __elementSize)
+            {
+                ::munmap(this->base, this->length);
+                ::close(this->fd);
+                throw std::runtime_error("incompatible mapped vector file: " + __path);
+            }
+        }
+
+        __MappedFile(const __MappedFile &) = delete;
+        __MappedFile & operator=(const __MappedFile &) = delete;
+
+        ~__MappedFile()
+        {
+            ::munmap(this->base, this->length);
+            ::close(this->fd);
+        }
+
+        __MappedVectorHeader * header(void) const noexcept { return reinterpret_cast<__MappedVectorHeader *>(this->base); }
+
+        void * data(void) const noexcept { return this->base + HEADER_BYTES; }
+
+        std::size_t dataBytes(void) const noexcept { return this->length - HEADER_BYTES; }
+
+        /**
+         * @brief 把文件头之后的部分调整为 __bytes 字节（扩大时新增的部分为 0），返回新的数据首地址。
+         *        映射可能移动到别的地址，文件中原有的数据保持不变。
+        */
+        void * resizeData(std::size_t __bytes)
+        {
+            const std::size_t newLength = HEADER_BYTES + __bytes;
+            const std::size_t oldLength = this->length;
+
+            if (newLength == oldLength) { return this->data(); }
+
+            /*扩大时先加长文件再扩展映射，缩小时先缩小映射再截短文件，映射始终不超出文件*/
+            if (newLength > oldLength && ::ftruncate(this->fd, off_t(newLength)) != 0) { fail("ftruncate", "mapped vector"); }
+
+#if defined(__linux__)
+            void * mapped = ::mremap(this->base, oldLength, newLength, MREMAP_MAYMOVE);
+
+            if (mapped == MAP_FAILED) { fail("mremap", "mapped vector"); }
+#else
+            ::munmap(this->base, oldLength);
+
+            void * mapped = ::mmap(nullptr, newLength, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0);
+
+            if (mapped == MAP_FAILED) { fail("mmap", "mapped vector"); }
+#endif
+
+            this->base   = static_cast<char *>(mapped);
+            this->length = newLength;
+
+            if (newLength < oldLength && ::ftruncate(this->fd, off_t(newLength)) != 0) { fail("ftruncate", "mapped vector"); }
+
+            return this->data();
+        }
+
+        /**
+         * @brief 把整个映射写回磁盘。
+        */
+        void sync(void)
+        {
+            if (::msync(this->base, this->length, MS_SYNC) != 0) { fail("msync", "mapped vector"); }
+        }
+
+        /**
+         * @brief 申请 __bytes 字节的数据区时文件实际的大小（整页）减去文件头。
+        */
+        static std::size_t goodSize(std::size_t __bytes) noexcept
+        {
+            return ((HEADER_BYTES + __bytes + PAGE_BYTES - 1) & ~(PAGE_BYTES - 1)) - HEADER_BYTES;
+        }
+};
+
+/**
+ * @brief 从一个 __MappedFile 中 “分配” 数组的分配器：整个文件只存放一个数组，分配即调整文件的长度。
+ *
+ * @brief - allocate() 并不给出一块新的内存，而是调整唯一的那块数组，映射可能被挪走，旧数组随即失效。
+ *          My_Vector 申请新数组之前用到的旧元素（例如 assign(n, x) 中的 x）必须先复制出来。
+*/
+template <typename Type>
+class __MappedFileAllocator
+{
+    private:
+        template <typename> friend class __MappedFileAllocator;
+
+        __MappedFile * file;
+
+    public:
+        typedef Type value_type;
+
+        explicit __MappedFileAllocator(__MappedFile * __file) noexcept : file(__file) {}
+
+        template <typename Other>
+        __MappedFileAllocator(const __MappedFileAllocator<Other> & __other) noexcept : file(__other.file) {}
+
+        Type * allocate(std::size_t __n) { return static_cast<Type *>(this->file->resizeData(__n * sizeof(Type))); }
+
+        /*数据留在文件中，映射在 vector 关闭文件时才解除*/
+        void deallocate(Type *, std::size_t) noexcept {}
+
+        Type * reallocate(Type *, std::size_t, std::size_t __newN) { return this->allocate(__newN); }
+
+        std::size_t goodSize(std::size_t __bytes) const noexcept { return __MappedFile::goodSize(__bytes); }
+
+        template <typename Other>
+        bool operator==(const __MappedFileAllocator<Other> & __other) const noexcept { return this->file == __other.file; }
+
+        template <typename Other>
+        bool operator!=(const __MappedFileAllocator<Other> & __other) const noexcept { return this->file != __other.file; }
+};
+
+/**
+ * @brief 先于 My_Vector 基类构造的文件（基类的分配器需要它）。
+*/
+struct __MappedFileHolder
+{
+    std::unique_ptr<__MappedFile> mappedFile;
+};
+
+/**
+ * @tparam Type         元素类型，必须平凡可拷贝
+ * @tparam GrowthPolicy 扩容策略（见 growthPolicy.h），默认 sizeClassGrowth，文件总是整页大小
+*/
+template <typename Type, typename GrowthPolicy = sizeClassGrowth>
+class My_MappedVector : private __MappedFileHolder, public My_Vector<Type, __MappedFileAllocator<Type>, GrowthPolicy>
+{
+    static_assert(std::is_trivially_copyable<Type>::value, "My_MappedVector stores raw bytes, Type must be trivially copyable");
+    static_assert(alignof(Type) <= __MappedFile::HEADER_BYTES, "Type is over-aligned for the mapped vector header");
+
+    private:
+        typedef My_Vector<Type, __MappedFileAllocator<Type>, GrowthPolicy> base;
+
+        /**
+         * @brief 把文件头记录的元素个数更新为 size()。
+        */
+        void writeSize(void) noexcept
+        {
+            if (this->mappedFile) { this->mappedFile->header()->size = this->size(); }
+        }
+
+    public:
+        typedef typename base::sizeType sizeType;
+
+        /**
+         * @brief 打开 __path 中保存的 vector（文件不存在时创建一个空的），原有的元素可以立即使用。
+        */
+        explicit My_MappedVector(const std::string & __path)
+            : __MappedFileHolder{std::make_unique<__MappedFile>(__path, sizeof(Type), alignof(Type))},
+              base(__MappedFileAllocator<Type>(this->mappedFile.get()))
+        {
+            Type * data = static_cast<Type *>(this->mappedFile->data());
+
+            this->start        = data;
+            this->finish       = data + this->mappedFile->header()->size;
+            this->endOfStorage = data + this->mappedFile->dataBytes() / sizeof(Type);
+        }
+
+        My_MappedVector(const My_MappedVector &) = delete;
+        My_MappedVector & operator=(const My_MappedVector &) = delete;
+
+        /**
+         * @brief 移动构造：文件随之移动，被移走的对象不再关联任何文件。
+        */
+        My_MappedVector(My_MappedVector && __vec) noexcept
+            : __MappedFileHolder{std::move(__vec.mappedFile)}, base(std::move(__vec)) {}
+
+        My_MappedVector & operator=(My_MappedVector &&) = delete;
+
+        void swap(My_MappedVector &) = delete;
+
+        ~My_MappedVector()
+        {
+            this->writeSize();
+
+            /*映射由文件负责解除，不能交给基类 “释放”*/
+            this->start = this->finish = this->endOfStorage = nullptr;
+        }
+
+        /**
+         * @brief 把元素个数写回文件头，并把所有数据写到磁盘上。
+        */
+        void sync(void)
+        {
+            this->writeSize();
+            this->mappedFile->sync();
+        }
+};
+
+#endif // _MAPPED_VECTOR_H_
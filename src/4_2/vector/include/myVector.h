@@ -2,127 +2,445 @@
 #define _MY_VECTOR_H_
 
 #include <initializer_list>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <iterator>
 #include <exception>
+#include <type_traits>
+#include <utility>
 
 #include "../../simple_allocator/simpleAlloc.h"
-
-template <typename Type, typename Alloc = std::allocator<Type>>
-class My_Vector
+#include "./growthPolicy.h"
+#include "./checkedIterator.h"
+#include "./parallelConstruct.h"
+
+/**
+ * @brief 可平凡重定位（trivially relocatable）：把对象按字节搬到另一处内存、且不再析构原对象，等价于移动构造后析构原对象。
+ *        平凡可拷贝的类型都满足，其他满足条件的类型可以特化这个模板。
+*/
+template <typename Type>
+struct __isTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
+/*
+    智能指针移动后原对象为空、析构什么也不做，按字节搬移与 “移动构造 + 析构原对象” 等价。
+    std::string 则不行：libstdc++ 的短字符串指向对象自身的缓冲区，搬到别处之后指针就错了。
+*/
+template <typename Type, typename Deleter>
+struct __isTriviallyRelocatable<std::unique_ptr<Type, Deleter>> : __isTriviallyRelocatable<Deleter> {};
+
+template <typename Type>
+struct __isTriviallyRelocatable<std::shared_ptr<Type>> : std::true_type {};
+
+template <typename Type>
+struct __isTriviallyRelocatable<std::weak_ptr<Type>> : std::true_type {};
+
+/**
+ * @brief 默认初始化的标记：resize(n, defaultInit)、My_Vector(n, defaultInit) 新增的元素只做默认初始化，
+ *        平凡类型的内容不做任何初始化。
+*/
+struct __DefaultInit { explicit __DefaultInit() = default; };
+
+inline constexpr __DefaultInit defaultInit{};
+
+/**
+ * @brief 只有（至少是）输入迭代器才参与区间版本的重载，避免与 insert(pos, n, x) 之类的整数参数混淆。
+*/
+template <typename Iterator>
+using __requireInputIterator = std::enable_if_t<
+    std::is_convertible<typename std::iterator_traits<Iterator>::iterator_category, std::input_iterator_tag>::value
+>;
+
+template <typename Iterator>
+struct __isForwardIterator 
+    : std::is_convertible<typename std::iterator_traits<Iterator>::iterator_category, std::forward_iterator_tag> {};
+
+/**
+ * @tparam Type         元素类型
+ * @tparam Alloc        分配器类型，默认为 `std::allocator<Type>`
+ * @tparam GrowthPolicy 扩容策略（见 growthPolicy.h），默认每次翻倍
+*/
+template <typename Type, typename Alloc = std::allocator<Type>, typename GrowthPolicy = doublingGrowth>
+class My_Vector : protected Simple_Alloc<Type, Alloc>
 {
     public:
         using valueType            = Type;
         using pointer              = valueType *;
         using constPointer         = const valueType *;
+#if __VECTOR_CHECKED_
+        using iterator             = __CheckedIterator<Type, Type>;         // 正向迭代器（检查模式）
+        using constIterator        = __CheckedIterator<Type, const Type>;   // 正向只读迭代器（检查模式）
+#else
         using iterator             = valueType *;                           // 正向迭代器
         using constIterator        = const valueType *;                     // 正向只读迭代器
+#endif
         using reverseIterator      = std::reverse_iterator<iterator>;       // 反向迭代器    
         using constReverseIterator = std::reverse_iterator<constIterator>;  // 反向只读迭代器
         using reference            = valueType &;
         using constReference       = const valueType &;
         using sizeType             = std::size_t;
         using differenceType       = std::ptrdiff_t;
+        using allocatorType        = Alloc;
 
     protected:
         /**
-         * vector 专属的迭代器，用于分配内存。
+         * vector 专属的分配器，用于分配内存（分配器对象就保存在基类中）。
         */
         using dataAllocator = Simple_Alloc<valueType, Alloc>;
 
-        iterator start;         // 指向数组之首的迭代器
-        iterator finish;        // 指向目前数组使用空间之尾的迭代器
-        iterator endOfStorage;  // 指向目前数组可用空间之尾的迭代器
+        pointer start;          // 指向数组之首的指针
+        pointer finish;         // 指向目前数组使用空间之尾的指针
+        pointer endOfStorage;   // 指向目前数组可用空间之尾的指针
+
+        /**
+         * 元素可平凡重定位、分配器又提供 reallocate() 时，扩容交给 reallocate()，
+         * 底层可以原地扩展（大块内存还可以由 mremap 搬移页表），不需要申请、逐个拷贝、释放。
+        */
+        static constexpr bool reallocGrowth = __isTriviallyRelocatable<Type>::value && dataAllocator::canReallocate;
+
+        /**
+         * 元素可平凡重定位时，insert()、erase() 在数组中间腾出或填补空位都直接 memmove，
+         * 扩容时旧元素 memcpy 到新数组、旧数组不再析构，不需要逐个移动构造、移动赋值。
+        */
+        static constexpr bool relocatable = __isTriviallyRelocatable<Type>::value;
+
+        /**
+         * @brief 辅助函数，把 [__first, __last) 的元素按字节搬到 __dest（两段区间可以重叠），
+         *        搬走之后原来的位置视为未初始化，不再析构（仅当 relocatable 时使用）。
+        */
+        static void relocate(pointer __first, pointer __last, pointer __dest) noexcept
+        {
+            if (__first != __last)
+            {
+                std::memmove(static_cast<void *>(__dest), static_cast<const void *>(__first), (__last - __first) * sizeof(Type));
+            }
+        }
+
+        /**
+         * @brief 辅助函数，把 [__pos, end()) 的元素后移 __n 个位置（空间必须足够），
+         *        再由 __construct(__pos) 在腾出的空位上构建 __n 个新元素（仅当 relocatable 时使用）。
+         * 
+         * @brief - __construct 抛出异常时，它自己负责析构已经构建的新元素，后移的元素再搬回原处，vector 保持不变。
+        */
+        template <typename Construct>
+        void relocateInsert(pointer __pos, sizeType __n, Construct __construct)
+        {
+            relocate(__pos, this->finish, __pos + __n);
+
+            try { __construct(__pos); }
+            catch (...)
+            {
+                relocate(__pos + __n, this->finish + __n, __pos);
+                throw;
+            }
+
+            this->finish += __n;
+        }
+
+        /**
+         * @brief 辅助函数，按 GrowthPolicy 计算再放入 __n 个元素时扩容后的容量。
+        */
+        sizeType nextCapacity(sizeType __n) const
+        {
+            return GrowthPolicy::nextCapacity(
+                this->size(), this->size() + __n, sizeof(Type), 
+                [this](std::size_t __bytes) { return this->goodSize(__bytes); }
+            );
+        }
+
+        /**
+         * @brief 通过 reallocate() 把容量调整为 __newCapacity（仅当 reallocGrowth 时使用），元素按字节搬移。
+        */
+        void reallocateStorage(sizeType __newCapacity)
+        {
+            const sizeType oldSize = this->size();
+
+            pointer newStart = dataAllocator::reallocate(this->start, this->capacity(), __newCapacity);
+
+            this->start        = newStart;
+            this->finish       = newStart + oldSize;
+            this->endOfStorage = newStart + __newCapacity;
+        }
+
+        /**
+         * @brief 辅助函数，把 [__first, __last) 的元素搬到未初始化的 __dest 处：
+         *        移动构造不会抛出异常（或者元素不可拷贝）时移动，否则拷贝，以便出错时原数组保持不变。
+         * 
+         * @return 最后一个搬移的元素之后的位置
+        */
+        static pointer uninitializedMoveIfNoexcept(pointer __first, pointer __last, pointer __dest)
+        {
+            if constexpr (std::is_nothrow_move_constructible<Type>::value || !std::is_copy_constructible<Type>::value)
+            {
+                return std::uninitialized_move(__first, __last, __dest);
+            }
+            else { return std::uninitialized_copy(__first, __last, __dest); }
+        }
+
+        /**
+         * @brief 辅助函数，空间不足时在 __pos 处插入 __n 个新元素：
+         *        分配容量为 __newCapacity 的新数组，先由 __construct(dest) 在新数组中构建好新元素，
+         *        再把旧数组的元素按 uninitializedMoveIfNoexcept() 搬过去。
+         * 
+         * @brief - 新元素先于搬移构建，所以它们的初值引用旧数组中的元素也没有关系；
+         *          期间出现任何异常，新数组被销毁、释放，旧数组保持不变（强异常安全保证）。
+        */
+        template <typename Construct>
+        void reallocInsert(pointer __pos, sizeType __n, sizeType __newCapacity, Construct __construct)
+        {
+            pointer newStart  = dataAllocator::allocate(__newCapacity);
+            pointer newPos    = newStart + (__pos - this->start);
+            pointer newFinish = newStart;
+            bool     inserted  = false;
+
+            try
+            {
+                __construct(newPos);
+                inserted = true;
+
+                if constexpr (relocatable)
+                {
+                    relocate(this->start, __pos, newStart);
+                    relocate(__pos, this->finish, newPos + __n);
+                    newFinish = newPos + __n + (this->finish - __pos);
+                }
+                else
+                {
+                    newFinish = uninitializedMoveIfNoexcept(this->start, __pos, newStart);
+                    newFinish = uninitializedMoveIfNoexcept(__pos, this->finish, newPos + __n);
+                }
+            }
+            catch (...)
+            {
+                /*搬移到一半时 newFinish 停在 newStart 或 newPos，[newStart, newFinish) 是已经搬过去的前半段*/
+                std::destroy(newStart, newFinish);
+                if (inserted) { std::destroy(newPos, newPos + __n); }
+
+                dataAllocator::deallocate(newStart, __newCapacity);
+                throw;
+            }
+
+            // 完成搬移后析构并释放旧数组（按字节搬走的元素不再析构）
+            if constexpr (!relocatable) { std::destroy(this->start, this->finish); }
+            this->deallocate();
+
+            // 调整迭代器，指向新的数组
+            this->start        = newStart;
+            this->finish       = newFinish;
+            this->endOfStorage = newStart + __newCapacity;
+        }
 
         /**
-         * @brief 实现数组的扩容以及新值的插入操作（在 insert() 上也可用）。
+         * @brief 实现数组的扩容以及新值的插入操作（在 insert()、emplace() 上也可用），
+         *        新元素由 __args 原地构建。
          * 
-         * @param __pos 要插入的位置
-         * @param __n   要插入的值
+         * @param __pos     要插入的位置
+         * @param __args    构建新元素的参数
          * 
          * @return no return
         */
-        void insertAux(iterator __pos, const Type & __n)
+        template <typename... Args>
+        void insertAux(pointer __pos, Args &&... __args)
         {
             /**
              * 若数组还有多余的空间，就不进行扩容操作，在 insert() 操作时有大用。
             */
             if (this->finish != this->endOfStorage)
             {
-                std::_Construct(this->finish, *(this->finish - 1));
+                if (__pos == this->finish)
+                {
+                    std::_Construct(this->finish, std::forward<Args>(__args)...);
+                    ++this->finish;
+
+                    return;
+                }
+
+                if constexpr (relocatable)
+                {
+                    /*新值先构建在一块临时的内存上，元素后移之后再按字节搬到空位，临时内存不再析构*/
+                    alignas(Type) unsigned char buffer[sizeof(Type)];
+                    ::new (static_cast<void *>(buffer)) Type(std::forward<Args>(__args)...);
+
+                    this->relocateInsert(__pos, 1, [&](pointer __dest) { 
+                        relocate(reinterpret_cast<Type *>(buffer), reinterpret_cast<Type *>(buffer) + 1, __dest);
+                    });
+
+                    return;
+                }
+
+                /*__args 可能引用数组中的元素，元素后移之前先构建好新值*/
+                Type value(std::forward<Args>(__args)...);
+
+                std::_Construct(this->finish, std::move(*(this->finish - 1)));
                 ++this->finish;
-                Type nCopy = __n;
-                std::copy_backward(__pos, finish - 2, finish - 1);
-                *__pos = nCopy;
+                std::move_backward(__pos, this->finish - 2, this->finish - 1);
+                *__pos = std::move(value);
             }
             else
             {
-                // 确定旧数组的长度
-                const sizeType oldSize      = this->size();
+                /*确定新数组的长度（由 GrowthPolicy 决定，默认翻倍）*/
+                const sizeType allocaLength = this->nextCapacity(1);
 
-                /**
-                 *  确定新数组的长度，先判断旧数组长度是否为 0，
-                 * 
-                 *  是：只分配一个 Type 长度的内存
-                 *  否：分配旧数组长度 * 2 的内存
-                */
-                const sizeType allocaLength = (oldSize != 0) ? (2 * oldSize) : 1;
+                if constexpr (reallocGrowth)
+                {
+                    /*__args 可能引用数组中的元素，扩容之后原来的地址会失效，先构建好新值*/
+                    const differenceType index = __pos - this->start;
+                    Type value(std::forward<Args>(__args)...);
 
-                /* 
-                    调用分配器的 allocate() 方法，
-                    分配长度为 allocaLength * sizeof(Type) 字节的内存交由 newStart 迭代器管理，
-                    后面要把旧数组和末尾插入的新数据全部拷贝到此处。
-                */
-                iterator newStart  = dataAllocator::allocate(allocaLength);
+                    this->reallocateStorage(allocaLength);
+                    this->insertAux(this->start + index, std::move(value));
+                }
+                else
+                {
+                    this->reallocInsert(
+                        __pos, 1, allocaLength, 
+                        [&](pointer __dest) { std::_Construct(__dest, std::forward<Args>(__args)...); }
+                    );
+                }
+            }
+        }
 
-                /*
-                    由于新数组只完成了分配却没有构建，
-                    所以代表新数组尾部迭代器的 newFinish 暂时指向新数组开头。
-                */
-                iterator newFinish = newStart;
+        /**
+         * @brief 辅助函数，在 __pos 处插入前向迭代器区间 [__first, __last) 中的 __n 个元素，最多扩容一次。
+         * 
+         * @brief - 空间足够时原地后移插入点之后的元素，可平凡重定位的元素直接 memmove；
+         *          空间不够时一次分配到位，新元素和旧元素各自只搬一次。
+        */
+        template <typename ForwardIterator>
+        void rangeInsert(pointer __pos, ForwardIterator __first, ForwardIterator __last, sizeType __n)
+        {
+            if (__n == 0) { return; }
 
-                try
+            if (sizeType(this->endOfStorage - this->finish) >= __n)
+            {
+                const sizeType insertAfter = this->finish - __pos;
+                pointer       oldFinish   = this->finish;
+
+                if constexpr (relocatable)
                 {
-                    /*
-                        将旧数组，范围在 [this->start, __pos)（__pos 一般为 this->end()）
-                        内的所有数据先拷贝到新数组 newStart 处。
-                        返回最后一个复制对象之后一个的位置的迭代器给 newFinish
-                    */
-                    newFinish = std::uninitialized_copy(this->start, __pos, newStart);
+                    this->relocateInsert(__pos, __n, [&](pointer __dest) { std::uninitialized_copy(__first, __last, __dest); });
+                }
+                else if (insertAfter > __n)
+                {
+                    std::uninitialized_move(this->finish - __n, this->finish, this->finish);
+                    this->finish += __n;
 
-                    /*
-                        调用 _Construct() 函数给新元素构建为 __n 的值
-                    */
-                    std::_Construct(newFinish, __n);
-                    ++newFinish;    // 调整水位
+                    std::move_backward(__pos, oldFinish - __n, oldFinish);
+                    std::copy(__first, __last, __pos);
+                }
+                else
+                {
+                    ForwardIterator middle = std::next(__first, insertAfter);
 
-                    /**
-                     * 将安插点的原内容也拷贝过来，在 insert() 的实现中会有大用
-                    */
-                    newFinish = std::uninitialized_copy(__pos, this->finish, newFinish);
+                    this->finish = std::uninitialized_copy(middle, __last, this->finish);
+                    this->finish = std::uninitialized_move(__pos, oldFinish, this->finish);
+                    std::copy(__first, middle, __pos);
+                }
+            }
+            else
+            {
+                const sizeType allocateLength = this->nextCapacity(__n);
+
+                if constexpr (reallocGrowth)
+                {
+                    const differenceType index = __pos - this->start;
+
+                    this->reallocateStorage(allocateLength);
+                    this->rangeInsert(this->start + index, __first, __last, __n);
+                }
+                else
+                {
+                    this->reallocInsert(
+                        __pos, __n, allocateLength, 
+                        [&](pointer __dest) { std::uninitialized_copy(__first, __last, __dest); }
+                    );
+                }
+            }
+        }
+
+        /**
+         * @brief 辅助函数，把所有元素搬到容量为 __newCapacity（不小于 size()）的新数组上，只分配一次。
+        */
+        void relocateStorage(sizeType __newCapacity)
+        {
+            if constexpr (reallocGrowth) { this->reallocateStorage(__newCapacity); }
+            else
+            {
+                pointer newStart  = dataAllocator::allocate(__newCapacity);
+                pointer newFinish = newStart;
+
+                try
+                {
+                    if constexpr (relocatable)
+                    {
+                        relocate(this->start, this->finish, newStart);
+                        newFinish = newStart + this->size();
+                    }
+                    else { newFinish = uninitializedMoveIfNoexcept(this->start, this->finish, newStart); }
                 }
                 catch (...)
                 {
-                    /*
-                        若拷贝，构造的过程中出现任何异常，都需要停止拷贝，
-                        析构并释放新数组的所有内存，最后抛出异常。
-                    */
-                    std::destroy(newStart, newFinish);
-                    dataAllocator::deallocate(newStart, allocaLength);
+                    dataAllocator::deallocate(newStart, __newCapacity);
                     throw;
                 }
 
-                // 完成拷贝后析构并释放旧数组
-                std::destroy(this->begin(), this->end());
-                dataAllocator::deallocate(this->begin(), this->size());
+                if constexpr (!relocatable) { std::destroy(this->start, this->finish); }
+                this->deallocate();
 
-                // 调整迭代器，指向新的数组
                 this->start        = newStart;
                 this->finish       = newFinish;
-                this->endOfStorage = newStart + allocaLength;
+                this->endOfStorage = newStart + __newCapacity;
             }
         }
 
+        /**
+         * @brief 辅助函数，在末尾追加 __count 个由 __construct(dest, count) 批量构建的元素，最多扩容一次。
+        */
+        template <typename Construct>
+        void appendConstruct(sizeType __count, Construct __construct)
+        {
+            if (sizeType(this->endOfStorage - this->finish) < __count)
+            {
+                const sizeType allocateLength = this->nextCapacity(__count);
+
+                if constexpr (reallocGrowth) { this->reallocateStorage(allocateLength); }
+                else
+                {
+                    this->reallocInsert(
+                        this->finish, __count, allocateLength, 
+                        [&](pointer __dest) { __construct(__dest, __count); }
+                    );
+
+                    return;
+                }
+            }
+
+            __construct(this->finish, __count);
+            this->finish += __count;
+        }
+
+        /**
+         * @brief 辅助函数，在末尾追加 __count 个元素：容量不够时先扩到刚好够用，
+         *        再由多个线程并行执行 __construct(dest, count) 构建新元素（见 parallelConstruct.h）。
+        */
+        template <typename Construct>
+        void parallelAppend(sizeType __count, __ParallelInit __policy, Construct __construct)
+        {
+            if (sizeType(this->endOfStorage - this->finish) < __count) { this->relocateStorage(this->size() + __count); }
+
+            __parallelConstruct(this->finish, __count, __policy, __construct);
+            this->finish += __count;
+        }
+
+        /**
+         * @brief 辅助函数，析构 [__pos, end()) 中的元素，不移动其他元素。
+        */
+        void eraseAtEnd(pointer __pos) noexcept
+        {
+            std::destroy(__pos, this->finish);
+            this->finish = __pos;
+        }
+
         /**
          * @brief 辅助函数，调用分配器，销毁整个 `vector` 的数据。
         */
@@ -131,13 +449,62 @@ class My_Vector
             if (this->start) { dataAllocator::deallocate(start, endOfStorage - start); }
         }
 
+        /**
+         * @brief 辅助函数，析构所有元素并释放内存，让 vector 回到没有分配任何内存的状态。
+        */
+        void destroyAndDeallocate()
+        {
+            std::destroy(this->start, this->finish);
+            this->deallocate();
+
+            this->start        = nullptr;
+            this->finish       = nullptr;
+            this->endOfStorage = nullptr;
+        }
+
+        /**
+         * @brief 辅助函数，为 `[__first, __last)` 分配刚好够用的内存并拷贝（或移动）过来，
+         *        通常被构造函数和赋值运算符调用（调用前 vector 必须没有持有内存）。
+        */
+        template <typename InputIterator>
+        void rangeInitialize(InputIterator __first, InputIterator __last, sizeType __n)
+        {
+            this->start        = dataAllocator::allocate(__n);
+            this->endOfStorage = this->start + __n;
+
+            try
+            {
+                this->finish = std::uninitialized_copy(__first, __last, this->start);
+            }
+            catch (...)
+            {
+                this->deallocate();
+                this->start = this->finish = this->endOfStorage = nullptr;
+                throw;
+            }
+        }
+
+        /**
+         * @brief 辅助函数，接管 `__vec` 的全部内存，`__vec` 变为空。
+        */
+        void steal(My_Vector & __vec) noexcept
+        {
+            this->start         = __vec.start;
+            this->finish        = __vec.finish;
+            this->endOfStorage  = __vec.endOfStorage;
+
+            __vec.start         = nullptr;
+            __vec.finish        = nullptr;
+            __vec.endOfStorage  = nullptr;
+        }
+
         /**
          * @brief 辅助函数，为 `__n` 个 `Type` 类型的值分配内存并统一构建初值 `__value`，
          *        返回操作完成后的数据首地址。
         */
-        iterator allocate_and_fill(sizeType __n, const Type & __value)
+        pointer allocate_and_fill(sizeType __n, const Type & __value)
         {
-            iterator result = dataAllocator::allocate(__n);
+            pointer result = dataAllocator::allocate(__n);
             std::uninitialized_fill_n(result, __n, __value);
 
             return result;
@@ -154,13 +521,123 @@ class My_Vector
             this->endOfStorage = finish; 
         }
 
+        /**
+         * @brief 辅助函数，从 __pos 开始插入 __n 个元素，每一个元素的初值都为 __x。
+        */
+        void fillInsert(pointer __pos, sizeType __n, const Type & __x)
+        {
+            if (__n != 0)   // 总不能插入 0 个元素吧 。。。
+            {
+                /**
+                 * 计算数组还剩下多少空间，看看是不是大于等于要插入的元素数 
+                */
+                if (sizeType(this->endOfStorage - this->finish) >= __n)
+                {
+                    Type xCopy = __x;
+
+                    if constexpr (relocatable)
+                    {
+                        this->relocateInsert(__pos, __n, [&](pointer __dest) { std::uninitialized_fill_n(__dest, __n, xCopy); });
+
+                        return;
+                    }
+
+                    /**
+                     * 计算插入点之后的现有元素个数。
+                    */
+                    const sizeType insertAfter = this->finish - __pos;
+
+                    // 保存当前的数组使用空间之尾的指针
+                    pointer oldFinish = this->finish;
+
+                    /**
+                     * 当插入点之后的现有元素个数 大于 要插入的元素数 时
+                    */
+                    if (insertAfter > __n)
+                    {
+                        std::uninitialized_move(this->finish - __n, this->finish, this->finish);
+                        this->finish += __n;
+
+                        std::move_backward(__pos, oldFinish - __n, oldFinish);
+                        std::fill(__pos, __pos + __n, xCopy);
+                    }
+                    else // 插入点之后的现有元素个数 小于 要插入的元素数 时
+                    {
+                        std::uninitialized_fill_n(this->finish, __n - insertAfter, xCopy);
+                        this->finish += __n - insertAfter;
+                        std::uninitialized_move(__pos, oldFinish, this->finish);
+                        this->finish += insertAfter;
+                        std::fill(__pos, oldFinish, xCopy);
+                    }
+                }
+                else // 数组内剩下的备用空间不足，需要重新分配内存
+                {
+                    if constexpr (reallocGrowth)
+                    {
+                        /*原地扩容之后，空间足够，按上面的分支插入*/
+                        const differenceType index = __pos - this->start;
+                        Type xCopy = __x;
+
+                        this->reallocateStorage(this->nextCapacity(__n));
+                        this->fillInsert(this->start + index, __n, xCopy);
+
+                        return;
+                    }
+
+                    /**
+                     * 确定要分配的新数组大小（由 GrowthPolicy 决定），
+                     * 默认要么是原数组的两倍长，要么是原数组长度 + 要插入元素的个数。
+                    */
+                    const sizeType allocateLength = this->nextCapacity(__n);
+
+                    this->reallocInsert(
+                        __pos, __n, allocateLength, 
+                        [&](pointer __dest) { std::uninitialized_fill_n(__dest, __n, __x); }
+                    );
+                }
+            }
+        }
+
+        /**
+         * @brief 辅助函数，把指向数组中某个位置的指针包装成迭代器（检查模式之外就是指针本身）。
+        */
+        iterator makeIterator(pointer __ptr) noexcept
+        {
+#if __VECTOR_CHECKED_
+            return iterator(__ptr, &this->start, &this->finish);
+#else
+            return __ptr;
+#endif
+        }
+
+        constIterator makeIterator(constPointer __ptr) const noexcept
+        {
+#if __VECTOR_CHECKED_
+            return constIterator(__ptr, &this->start, &this->finish);
+#else
+            return __ptr;
+#endif
+        }
+
+        /**
+         * @brief 辅助函数，取出迭代器指向的位置（检查模式下同时检查它属于本 vector 并且仍然有效）。
+        */
+        pointer unwrap(constIterator __pos) const
+        {
+#if __VECTOR_CHECKED_
+            return const_cast<pointer>(__pos.checkedBase(&this->start));
+#else
+            return const_cast<pointer>(__pos);
+#endif
+        }
+
     public:
-        iterator begin() noexcept               { return this->start; }
-        iterator end()   noexcept               { return this->finish; }
-        constIterator begin() const noexcept    { return this->start; }
-        constIterator end()   const noexcept    { return this->finish; }
-        constIterator cbegin() const noexcept   { return this->start; }
-        constIterator cend()   const noexcept   { return this->finish; }
+        iterator begin() noexcept               { return this->makeIterator(this->start); }
+        iterator end()   noexcept               { return this->makeIterator(this->finish); }
+        constIterator begin() const noexcept    { return this->makeIterator(this->start); }
+        constIterator end()   const noexcept    { return this->makeIterator(this->finish); }
+        constIterator cbegin() const noexcept   { return this->makeIterator(this->start); }
+        constIterator cend()   const noexcept   { return this->makeIterator(this->finish); }
         reverseIterator rbegin() noexcept       { return reverseIterator(this->end()); }
         reverseIterator rend()   noexcept       { return reverseIterator(this->begin()); }
 #if true
@@ -168,46 +645,65 @@ class My_Vector
         constReverseIterator rcend()   const noexcept { return constReverseIterator(this->cbegin()); }
 #endif
 
-        sizeType size()     const       { return sizeType(this->end() - this->begin()); }
-        sizeType capacity() const       { return sizeType(endOfStorage - this->begin()); }
+        sizeType size()     const       { return sizeType(this->finish - this->start); }
+        sizeType capacity() const       { return sizeType(this->endOfStorage - this->start); }
 
-        reference front() { return *begin(); }
-        reference back()  { return *(end() - 1); }
+        reference front() { __VECTOR_ASSERT(!this->empty(), "front() on an empty vector"); return *this->start; }
+        reference back()  { __VECTOR_ASSERT(!this->empty(), "back() on an empty vector"); return *(this->finish - 1); }
 
-        constReference front() const { return (*cbegin()); }
-        constReference back()  const  { return *(cend() - 1); }
+        constReference front() const { __VECTOR_ASSERT(!this->empty(), "front() on an empty vector"); return *this->start; }
+        constReference back()  const { __VECTOR_ASSERT(!this->empty(), "back() on an empty vector"); return *(this->finish - 1); }
 
-        bool empty() const { return (this->begin() == this->end()); }
+        bool empty() const { return (this->start == this->finish); }
 
-        reference      operator[](sizeType __n)       { return *(begin() + __n); }
-        constReference operator[](sizeType __n) const { return *(begin() + __n); }
-        My_Vector &    operator= (const My_Vector<Type> & __vec)
+        reference operator[](sizeType __n)
         {
-            if (this == &__vec) { return *this; }
-
-            this->~My_Vector();
+            __VECTOR_ASSERT(__n < this->size(), "operator[] index out of range");
+            return *(this->start + __n);
+        }
 
-            this->start  = dataAllocator::allocate(__vec.capacity());
-            this->finish = std::uninitialized_copy(__vec.begin(), __vec.end(), this->begin());
+        constReference operator[](sizeType __n) const
+        {
+            __VECTOR_ASSERT(__n < this->size(), "operator[] index out of range");
+            return *(this->start + __n);
+        }
+        /**
+         * @brief 拷贝赋值，分配器是否随之拷贝由 propagate_on_container_copy_assignment 决定。
+        */
+        My_Vector &    operator= (const My_Vector & __vec)
+        {
+            if (this == &__vec) { return *this; }
 
-            this->endOfStorage = this->begin() + __vec.capacity();
+            this->destroyAndDeallocate();
+            this->copyAssignAllocator(__vec);
+            this->rangeInitialize(__vec.start, __vec.finish, __vec.size());
 
             return *this;
         }
 
-        My_Vector & operator= (My_Vector<Type> && __vec)
+        /**
+         * @brief 移动赋值。
+         * 
+         * @brief - 分配器会随之移动，或者两个分配器相等时，直接接管 `__vec` 的内存；
+         *          否则本容器的分配器无法释放 `__vec` 的内存，只能逐个移动元素。
+        */
+        My_Vector & operator= (My_Vector && __vec)
         {
             if (this == &__vec) { return *this; }
 
-            this->~My_Vector();
-
-            this->start         = __vec.start;
-            this->finish        = __vec.finish;
-            this->endOfStorage  = __vec.endOfStorage;
+            this->destroyAndDeallocate();
 
-            __vec.start         = nullptr;
-            __vec.finish        = nullptr;
-            __vec.endOfStorage  = nullptr;
+            if (dataAllocator::propagateOnMoveAssignment::value || this->equalAllocator(__vec))
+            {
+                this->moveAssignAllocator(__vec);
+                this->steal(__vec);
+            }
+            else
+            {
+                this->rangeInitialize(
+                    std::make_move_iterator(__vec.start), std::make_move_iterator(__vec.finish), __vec.size()
+                );
+            }
 
             return *this;
         }
@@ -239,77 +735,174 @@ class My_Vector
         }
 
         My_Vector() : start(nullptr), finish(nullptr), endOfStorage(nullptr) {}
-        My_Vector(sizeType __n, const Type & __value)       { this->fillInitialize(__n, __value); }
-        My_Vector(int __n, const Type & __value)            { this->fillInitialize(__n, __value); }
-        My_Vector(long int __n, const Type & __value)       { this->fillInitialize(__n, __value); }
-        explicit My_Vector(sizeType __n)                    { this->fillInitialize(__n, Type()); }
+
+        /**
+         * @brief 使用指定的分配器对象（比如一块 arena）构造空的 vector。
+        */
+        explicit My_Vector(const Alloc & __alloc) 
+            : dataAllocator(__alloc), start(nullptr), finish(nullptr), endOfStorage(nullptr) {}
+
+        My_Vector(sizeType __n, const Type & __value, const Alloc & __alloc = Alloc()) 
+            : dataAllocator(__alloc) { this->fillInitialize(__n, __value); }
+
+        My_Vector(int __n, const Type & __value, const Alloc & __alloc = Alloc()) 
+            : dataAllocator(__alloc) { this->fillInitialize(__n, __value); }
+
+        My_Vector(long int __n, const Type & __value, const Alloc & __alloc = Alloc()) 
+            : dataAllocator(__alloc) { this->fillInitialize(__n, __value); }
+
+        explicit My_Vector(sizeType __n, const Alloc & __alloc = Alloc()) 
+            : My_Vector(__alloc) { this->resize(__n); }
+
+        /**
+         * @brief 构造 __n 个默认初始化的元素（平凡类型不做初始化）。
+        */
+        My_Vector(sizeType __n, __DefaultInit, const Alloc & __alloc = Alloc()) 
+            : My_Vector(__alloc) { this->resize(__n, defaultInit); }
+
+        /**
+         * @brief 由多个线程并行构建 __n 个 __value 的副本（见 parallelConstruct.h），适合上亿个元素的大数组。
+        */
+        My_Vector(sizeType __n, const Type & __value, __ParallelInit __policy, const Alloc & __alloc = Alloc()) 
+            : My_Vector(__alloc) { this->resize(__n, __value, __policy); }
+
+        /**
+         * @brief 由多个线程并行构建 __n 个值初始化的元素。
+        */
+        My_Vector(sizeType __n, __ParallelInit __policy, const Alloc & __alloc = Alloc()) 
+            : My_Vector(__alloc) { this->resize(__n, __policy); }
 
         /**
          * @brief 从初始化参数列表拷贝数据到 vector
         */
-        My_Vector(const std::initializer_list<valueType> & __initList)
+        My_Vector(const std::initializer_list<valueType> & __initList, const Alloc & __alloc = Alloc())
+            : dataAllocator(__alloc)
         {
-            this->start  = dataAllocator::allocate(__initList.size());
-            this->finish = std::uninitialized_copy(__initList.begin(), __initList.end(), this->begin());
-
-            this->endOfStorage = this->finish;
+            this->rangeInitialize(__initList.begin(), __initList.end(), __initList.size());
         }
 
         /**
          * @brief 从 C 风格数组拷贝数据到 vector 
         */
-        My_Vector(const valueType * __first, const valueType * __last)
+        My_Vector(const valueType * __first, const valueType * __last, const Alloc & __alloc = Alloc())
+            : dataAllocator(__alloc)
         {
-            this->start  = dataAllocator::allocate(sizeType(__last - __first));
-            this->finish = std::uninitialized_copy(__first, __last, this->begin());
+            this->rangeInitialize(__first, __last, sizeType(__last - __first));
+        }
 
-            this->endOfStorage = this->finish;
+        /**
+         * @brief 拷贝构造函数，新 vector 的分配器由 select_on_container_copy_construction 决定。
+        */
+        explicit My_Vector(const My_Vector & __vec) : dataAllocator(__vec.selectOnCopy())
+        {
+            this->rangeInitialize(__vec.start, __vec.finish, __vec.size());
         }
 
         /**
-         * @brief 拷贝构造函数
+         * @brief 拷贝构造函数，使用指定的分配器。
         */
-        explicit My_Vector(const My_Vector<Type> & __vec)
+        My_Vector(const My_Vector & __vec, const Alloc & __alloc) : dataAllocator(__alloc)
         {
-            this->start  = dataAllocator::allocate(__vec.capacity());
-            this->finish = std::uninitialized_copy(__vec.begin(), __vec.end(), this->begin());
+            this->rangeInitialize(__vec.start, __vec.finish, __vec.size());
+        }
 
-            this->endOfStorage = this->begin() + __vec.capacity();
+        /**
+         * @brief 移动构造函数，分配器随内存一起移动过来。
+        */
+        My_Vector(My_Vector && __vec) noexcept : dataAllocator(__vec.getAllocator())
+        {
+            this->steal(__vec);
         }
 
         /**
-         * @brief 移动构造函数
+         * @brief 移动构造函数，使用指定的分配器，与 `__vec` 的分配器不相等时只能逐个移动元素。
         */
-        My_Vector(My_Vector && __vec)
+        My_Vector(My_Vector && __vec, const Alloc & __alloc) : dataAllocator(__alloc)
         {
-            this->start         = __vec.start;
-            this->finish        = __vec.finish;
-            this->endOfStorage  = __vec.endOfStorage;
+            if (this->equalAllocator(__vec)) { this->steal(__vec); }
+            else
+            {
+                this->rangeInitialize(
+                    std::make_move_iterator(__vec.start), std::make_move_iterator(__vec.finish), __vec.size()
+                );
+            }
+        }
 
-            __vec.start         = nullptr;
-            __vec.finish        = nullptr;
-            __vec.endOfStorage  = nullptr;
+        /**
+         * @brief 获取 vector 使用的分配器对象的副本。
+        */
+        allocatorType get_allocator() const { return allocatorType(this->getAllocator()); }
+
+        /**
+         * @brief 交换两个 vector 的内容，
+         *        分配器是否随之交换由 propagate_on_container_swap 决定（不交换时两个分配器必须相等）。
+        */
+        void swap(My_Vector & __vec) noexcept
+        {
+            std::swap(this->start, __vec.start);
+            std::swap(this->finish, __vec.finish);
+            std::swap(this->endOfStorage, __vec.endOfStorage);
+
+            this->swapAllocator(__vec);
         }
 
         /**
          * @brief 往 vector 末尾添加元素 
         */
-        void push_back(const Type & __n)
+        void push_back(const Type & __n) { this->emplace_back(__n); }
+
+        void push_back(Type && __n) { this->emplace_back(std::move(__n)); }
+
+        /**
+         * @brief 用 __args 在 vector 末尾原地构建一个元素
+         * 
+         * @return 新元素的引用
+        */
+        template <typename... Args>
+        reference emplace_back(Args &&... __args)
         {
             if (this->finish != this->endOfStorage)
             {
-                std::_Construct(this->finish, __n);
-                ++finish;
+                std::_Construct(this->finish, std::forward<Args>(__args)...);
+                ++this->finish;
             }
-            else { insertAux(this->end(), __n); }
+            else { this->insertAux(this->finish, std::forward<Args>(__args)...); }
+
+            return this->back();
+        }
+
+        /**
+         * @brief 用 __args 在 __pos 处原地构建一个元素
+         * 
+         * @return 指向新元素的迭代器
+        */
+        template <typename... Args>
+        iterator emplace(constIterator __pos, Args &&... __args)
+        {
+            const differenceType index = this->unwrap(__pos) - this->start;
+
+            this->insertAux(this->start + index, std::forward<Args>(__args)...);
+
+            return this->makeIterator(this->start + index);
         }
 
+        /**
+         * @brief 在 __pos 处插入一个元素
+         * 
+         * @return 指向新元素的迭代器
+        */
+        iterator insert(constIterator __pos, const Type & __x) { return this->emplace(__pos, __x); }
+
+        iterator insert(constIterator __pos, Type && __x) { return this->emplace(__pos, std::move(__x)); }
+
         /**
          * @brief 删除 vector 末尾的元素
         */
         void pop_back()
         {
-            std::_Destroy(this->end() - 1);
+            __VECTOR_ASSERT(!this->empty(), "pop_back() on an empty vector");
+
+            std::_Destroy(this->finish - 1);
             --this->finish;
         }
 
@@ -318,242 +911,252 @@ class My_Vector
          * 
          * @return  要清除范围的第一个迭代器
         */
-        iterator erase(iterator __first, iterator __last)
+        iterator erase(constIterator __first, constIterator __last)
         {
-            iterator newIter = std::copy(__last, this->finish, __first);
-            std::destroy(newIter, this->finish);
+            pointer first = this->unwrap(__first);
+            pointer last  = this->unwrap(__last);
+
+            __VECTOR_ASSERT(first <= last, "erase() with an invalid range");
+
+            if constexpr (relocatable)
+            {
+                /*析构被清除的元素，后面的元素按字节前移填补空位*/
+                std::destroy(first, last);
+                relocate(last, this->finish, first);
+            }
+            else
+            {
+                pointer newFinish = std::move(last, this->finish, first);
+                std::destroy(newFinish, this->finish);
+            }
 
-            this->finish = this->finish - (__last - __first);
+            this->finish = this->finish - (last - first);
 
-            return __first;
+            return this->makeIterator(first);
         }
 
         /**
          *  @brief 清除指定位置 __pos 的元素 
         */
-        iterator erase(iterator __pos)
+        iterator erase(constIterator __pos)
         {
+            pointer pos = this->unwrap(__pos);
+
+            __VECTOR_ASSERT(pos != this->finish, "erase() of end()");
+
+            if constexpr (relocatable) { return this->erase(__pos, __pos + 1); }
+
             /**
              *  确保 __pos 的位置不是最后一个元素，避免多余的拷贝操作。
             */
-            if (__pos + 1 != this->end()) { std::copy(__pos + 1, this->finish, __pos); }
+            if (pos + 1 != this->finish) { std::move(pos + 1, this->finish, pos); }
 
             --this->finish;
 
-            std::destroy(this->end() - 1, this->end());
+            std::_Destroy(this->finish);
 
-            return __pos;
+            return this->makeIterator(pos);
         }
 
-        void clear() { this->erase(this->start, this->finish); }
+        void clear() { this->eraseAtEnd(this->start); }
 
         /**
          * @brief 从  __pos 开始，插入 __n 个元素，每一个元素的初值都为 __x
         */
-        void insert(iterator __pos, sizeType __n, const Type & __x)
+        void insert(constIterator __pos, sizeType __n, const Type & __x) { this->fillInsert(this->unwrap(__pos), __n, __x); }
+
+        /**
+         * @brief 在 __pos 处插入区间 [__first, __last) 中的元素（区间不能来自本 vector）。
+         * 
+         * @brief - 前向迭代器先算出元素个数，最多扩容一次；
+         *          单趟的输入迭代器只能逐个追加到末尾，再旋转到插入点。
+         * 
+         * @return 指向第一个新元素的迭代器
+        */
+        template <typename InputIterator, typename = __requireInputIterator<InputIterator>>
+        iterator insert(constIterator __pos, InputIterator __first, InputIterator __last)
         {
-            if (__n != 0)   // 总不能插入 0 个元素吧 。。。
-            {
-                /**
-                 * 计算数组还剩下多少空间，看看是不是大于等于要插入的元素数 
-                */
-                if (sizeType(this->endOfStorage - this->finish) >= __n)
-                {
-                    Type xCopy = __x;
+            const differenceType index = this->unwrap(__pos) - this->start;
 
-                    /**
-                     * 计算插入点之后的现有元素个数。
-                    */
-                    const sizeType insertAfter = this->finish - __pos;
+            if constexpr (__isForwardIterator<InputIterator>::value)
+            {
+                this->rangeInsert(this->start + index, __first, __last, sizeType(std::distance(__first, __last)));
+            }
+            else
+            {
+                const sizeType oldSize = this->size();
 
-                    // 保存当前的数组使用空间之尾的迭代器
-                    iterator oldFinish = this->finish;
+                for (; __first != __last; ++__first) { this->emplace_back(*__first); }
 
-                    /**
-                     * 当插入点之后的现有元素个数 大于 要插入的元素数 时
-                    */
-                    if (insertAfter > __n)
-                    {
-                        std::uninitialized_copy(this->finish - __n, this->finish, this->finish);
-                        this->finish += __n;
+                std::rotate(this->start + index, this->start + oldSize, this->finish);
+            }
 
-                        std::copy_backward(__pos, oldFinish - __n, oldFinish);
-                        std::fill(__pos, oldFinish, xCopy);
-                    }
-                    else // 插入点之后的现有元素个数 小于 要插入的元素数 时
-                    {
-                        std::uninitialized_fill_n(this->finish, __n - insertAfter, xCopy);
-                        this->finish += __n - insertAfter;
-                        std::uninitialized_copy(__pos, oldFinish, this->finish);
-                        this->finish += insertAfter;
-                        std::fill(__pos, oldFinish, xCopy);
-                    }
-                }
-                else // 数组内剩下的备用空间不足，需要重新分配内存
-                {
-                    const sizeType oldSize = this->size();   // 记录旧数组的大小
+            return this->makeIterator(this->start + index);
+        }
 
-                    /**
-                     * 确定要分配的新数组大小，
-                     * 要么是原数组的两倍长，要么是原数组长度 + 要插入元素的个数。
-                    */
-                    const sizeType allocateLength = oldSize + std::max(oldSize, __n);
+        iterator insert(constIterator __pos, std::initializer_list<valueType> __initList)
+        {
+            return this->insert(__pos, __initList.begin(), __initList.end());
+        }
 
-                    /**
-                     * 给新数组分配内存并设置新数组的头尾指针
-                    */
-                    iterator newStart  = dataAllocator::allocate(allocateLength);
-                    iterator newFinish = newStart;
+        /**
+         * @brief 把区间 __range 中的元素追加到末尾，相当于 insert(end(), begin(__range), end(__range))。
+        */
+        template <typename Range>
+        void append_range(Range && __range)
+        {
+            this->insert(this->cend(), std::begin(__range), std::end(__range));
+        }
 
-                    try
-                    {
-                        /**
-                         * 整个拷贝过程分 3 步
-                         * 1. 从旧数组拷贝插入点前的数据到新数组
-                         * 2. 拷贝要插入的 __n 个值到新数组
-                         * 3. 最后从旧数组拷贝插入点之后的数据到新数组
-                         * 
-                         * 期间如果出现任何异常，都需要停止拷贝，销毁新数组并抛出异常。
-                        */
-                        newFinish = std::uninitialized_copy(this->start, __pos, newStart);
-                        newFinish = std::uninitialized_fill_n(newFinish, __n, __x);
-                        newFinish = std::uninitialized_copy(__pos, this->finish, newFinish);
-                    }
-                    catch (...)
-                    {
-                        std::destroy(newStart, newFinish);
-                        dataAllocator::deallocate(newStart, allocateLength);
-                        throw;
-                    }
+        /**
+         * @brief 用区间 [__first, __last) 中的元素替换 vector 的内容，
+         *        容量不够时直接分配刚好够用的内存，已有的元素尽量原地赋值。
+        */
+        template <typename InputIterator, typename = __requireInputIterator<InputIterator>>
+        void assign(InputIterator __first, InputIterator __last)
+        {
+            if constexpr (__isForwardIterator<InputIterator>::value)
+            {
+                const sizeType newSize = sizeType(std::distance(__first, __last));
 
-                    /**
-                     * 最后销毁旧数组，并把设置指针到新数组
-                    */
-                    std::destroy(this->start, this->finish);
-                    dataAllocator::deallocate(this->start, oldSize);
+                if (newSize > this->capacity())
+                {
+                    this->destroyAndDeallocate();
+                    this->rangeInitialize(__first, __last, newSize);
+                }
+                else if (newSize <= this->size())
+                {
+                    this->eraseAtEnd(std::copy(__first, __last, this->start));
+                }
+                else
+                {
+                    InputIterator middle = std::next(__first, this->size());
 
-                    this->start  = newStart;
-                    this->finish = newFinish;
-                    this->endOfStorage = newStart + allocateLength;
+                    std::copy(__first, middle, this->start);
+                    this->finish = std::uninitialized_copy(middle, __last, this->finish);
                 }
             }
+            else
+            {
+                pointer current = this->start;
+
+                for (; __first != __last && current != this->finish; ++__first, ++current) { *current = *__first; }
+
+                if (__first == __last) { this->eraseAtEnd(current); }
+                else { for (; __first != __last; ++__first) { this->emplace_back(*__first); } }
+            }
         }
+
         /**
-         * 修改 vector 内部数组的大小。
-         * 
+         * @brief 把 vector 的内容替换为 __n 个 __x。
         */
-        void resize(sizeType __newSize)
+        void assign(sizeType __n, const Type & __x)
         {
-            /**
-             * 若传入的值为 0，直接 clear() 打发了。
-             */
-            if (__newSize == 0) { this->clear(); }
-
-            /**
-             * 增加数组尺寸
-            */
-            if (__newSize > this->size())
+            if (__n > this->capacity())
             {
                 /**
-                 * 增加的量并没有超过 capacity() 的返回值，
-                 * 无需扩容操作，仅调整 finish 指针的位置即可。
-                */
-                if ((this->size() + (__newSize - this->size())) < this->capacity())
-                {
-                    sizeType appendSize = __newSize - this->size();
-                    this->finish = std::fill_n(this->end(), appendSize, 0);
-                }
-                /**
-                 * 增加的量超过了 capacity() 的返回值，
-                 * 就需要扩容操作，并调整  finish 和 endOfStorage 指针的位置。
+                 * __x 可能是本 vector 的元素，先复制一份：
+                 * 有的分配器（如 __MappedFileAllocator）申请新数组时就会挪动旧数组，不能指望旧数组在填充时仍然有效。
                 */
-                else
-                {
-                    /**
-                     * 计算两个数据：
-                     * 1. 仅仅需要追加初值的元素数
-                     * 2. 需要分配且构造初值的元素数
-                    */
-                    sizeType appendSize   = this->capacity() - this->size();
-                    sizeType allocateSize = __newSize - this->capacity();
-
-                    // 先填充数组可用空间
-                    this->finish = std::fill_n(this->end(), appendSize, 0);
-                    
-                    // 剩下的部分可以通过循环并使用 insertAux() 函数进行插入和扩容
-                    for (sizeType index = 0; index < allocateSize; ++index)
-                    {
-                        this->insertAux(this->end(), 0);
-                    }
-                }
+                const Type xCopy = __x;
+                pointer newStart = this->allocate_and_fill(__n, xCopy);
+
+                this->destroyAndDeallocate();
+
+                this->start        = newStart;
+                this->finish       = newStart + __n;
+                this->endOfStorage = this->finish;
             }
-            /**
-             * 缩小数组尺寸，只需要抹掉 [this->start + __newSize, this->finish) 范围内的数据，
-             * 并调整 finish 指针即可到 this->start + __newSize 即可。
-            */
-            else 
+            else if (__n > this->size())
             {
-                this->erase(this->begin() + __newSize, this->end());
+                std::fill(this->start, this->finish, __x);
+                this->finish = std::uninitialized_fill_n(this->finish, __n - this->size(), __x);
             }
+            else
+            {
+                std::fill_n(this->start, __n, __x);
+                this->eraseAtEnd(this->start + __n);
+            }
+        }
+
+        void assign(std::initializer_list<valueType> __initList) { this->assign(__initList.begin(), __initList.end()); }
+
+        /**
+         * @brief 修改 vector 的大小，新增的元素值初始化（平凡类型即清零）。
+        */
+        void resize(sizeType __newSize)
+        {
+            if (__newSize > this->size())
+            {
+                this->appendConstruct(
+                    __newSize - this->size(), 
+                    [](pointer __dest, sizeType __count) { std::uninitialized_value_construct_n(__dest, __count); }
+                );
+            }
+            else { this->eraseAtEnd(this->start + __newSize); }
         }
 
+        /**
+         * @brief 修改 vector 的大小，新增的元素为 __x 的副本（__x 可以是本 vector 的元素）。
+        */
         void resize(sizeType __newSize, const valueType & __x)
         {
-            /**
-             * 若传入的值为 0，直接 clear() 打发了。
-             */
-            if (__newSize == 0) { this->clear(); }
+            if (__newSize > this->size()) { this->fillInsert(this->finish, __newSize - this->size(), __x); }
+            else { this->eraseAtEnd(this->start + __newSize); }
+        }
 
-            /**
-             * 增加数组尺寸
-            */
+        /**
+         * @brief 修改 vector 的大小，新增的元素默认初始化：
+         *        平凡类型不做任何初始化（内容不确定，由调用者随后写入），适合马上就要被覆盖的缓冲区。
+        */
+        void resize(sizeType __newSize, __DefaultInit)
+        {
             if (__newSize > this->size())
             {
-                /**
-                 * 增加的量并没有超过 capacity() 的返回值，
-                 * 无需扩容操作，仅调整 finish 指针的位置即可。
-                */
-                if ((this->size() + (__newSize - this->size())) < this->capacity())
-                {
-                    sizeType appendSize = __newSize - this->size();
-                    this->finish = std::fill_n(this->end(), appendSize, __x);
-                }
-                /**
-                 * 增加的量超过了 capacity() 的返回值，
-                 * 就需要扩容操作，并调整  finish 和 endOfStorage 指针的位置。
-                */
-                else
-                {
-                    /**
-                     * 计算两个数据：
-                     * 1. 仅仅需要追加初值的元素数
-                     * 2. 需要分配且构造初值的元素数
-                    */
-                    sizeType appendSize   = this->capacity() - this->size();
-                    sizeType allocateSize = __newSize - this->capacity();
-
-                    // 先填充数组可用空间
-                    this->finish = std::fill_n(this->end(), appendSize, __x);
-                    
-                    // 剩下的部分可以通过循环并使用 insertAux() 函数进行插入和扩容
-                    for (sizeType index = 0; index < allocateSize; ++index)
-                    {
-                        this->insertAux(this->end(), __x);
-                    }
-                }
+                this->appendConstruct(
+                    __newSize - this->size(), 
+                    [](pointer __dest, sizeType __count) { std::uninitialized_default_construct_n(__dest, __count); }
+                );
             }
-            /**
-             * 缩小数组尺寸，只需要抹掉 [this->start + __newSize, this->finish) 范围内的数据，
-             * 并调整 finish 指针即可到 this->start + __newSize 即可。
-            */
-            else 
+            else { this->eraseAtEnd(this->start + __newSize); }
+        }
+
+        /**
+         * @brief 修改 vector 的大小，新增的元素为 __x 的副本，由多个线程并行构建（见 parallelConstruct.h）。
+         *        容量不够时只扩到刚好够用；构建失败时新增的元素全部析构，原有的元素保持不变。
+        */
+        void resize(sizeType __newSize, const valueType & __x, __ParallelInit __policy)
+        {
+            if (__newSize > this->size())
             {
-                this->erase(this->begin() + __newSize, this->end());
+                /*__x 可能是本 vector 的元素，扩容之前先复制一份*/
+                const Type xCopy = __x;
+
+                this->parallelAppend(
+                    __newSize - this->size(), __policy, 
+                    [&xCopy](pointer __dest, sizeType __count) { std::uninitialized_fill_n(__dest, __count, xCopy); }
+                );
             }
+            else { this->eraseAtEnd(this->start + __newSize); }
         }
 
         /**
-         * @brief 预分配容器的容量
+         * @brief 修改 vector 的大小，新增的元素值初始化，由多个线程并行构建。
+        */
+        void resize(sizeType __newSize, __ParallelInit __policy)
+        {
+            if (__newSize > this->size())
+            {
+                this->parallelAppend(
+                    __newSize - this->size(), __policy, 
+                    [](pointer __dest, sizeType __count) { std::uninitialized_value_construct_n(__dest, __count); }
+                );
+            }
+            else { this->eraseAtEnd(this->start + __newSize); }
+        }
+
+        /**
+         * @brief 预分配容器的容量，只分配一次内存，不改变 size()。
          * 
          * @param __newSize 请求的容量大小
         */
@@ -565,15 +1168,18 @@ class My_Vector
             */
             if (__newSize <= this->capacity()) { return; }
 
-            /**
-             * 若请求的大小大于当前容量，则需要扩容该数组。
-            */
-            sizeType allocateSize = __newSize - this->capacity();
+            this->relocateStorage(__newSize);
+        }
 
-            for (sizeType index = 0; index < allocateSize; ++index)
-            {
-                this->insertAux(this->end(), 0);
-            }
+        /**
+         * @brief 释放多余的容量，让 capacity() == size()（只分配一次内存）。
+        */
+        void shrink_to_fit()
+        {
+            if (this->capacity() == this->size()) { return; }
+
+            if (this->empty()) { this->destroyAndDeallocate(); }
+            else { this->relocateStorage(this->size()); }
         }
 
         pointer data(void) noexcept
@@ -0,0 +1,121 @@
+#ifndef _PARALLEL_CONSTRUCT_H_
+#define _PARALLEL_CONSTRUCT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*
+    My_Vector 的并行构建（My_Vector(n, x, parallelInit)、resize(n, x, parallelInit) 等）。
+
+    上亿个元素的 vector，启动时间主要花在单线程的缺页和逐个构建上。
+    并行构建把要构建的区间切成若干段，交给多个线程同时构建：
+
+    1. 分段的边界按页对齐，每一页只由一个线程第一次写入（first-touch），
+       在 NUMA 机器上页面就分配在之后使用它的线程所在的节点上；
+    2. 某一段构建失败时，该段自己析构已经构建的元素（uninitialized_* 算法本来如此），
+       等所有线程结束之后再析构其他段已经构建好的元素，然后重新抛出第一个异常，调用者随后释放内存。
+
+    区间太小（不到 minBytes）或者只有一个线程时直接在当前线程构建，不创建任何线程。
+*/
+
+/**
+ * @brief 并行构建的标记。
+ *
+ * @param threads   使用的线程数（包括当前线程），0 表示 std::thread::hardware_concurrency()
+ * @param minBytes  区间小于这个字节数时不并行
+*/
+struct __ParallelInit
+{
+    unsigned    threads  = 0;
+    std::size_t minBytes = 1 << 20;
+};
+
+inline constexpr __ParallelInit parallelInit{};
+
+/**
+ * @brief 在未初始化的 [__first, __first + __n) 上并行执行 __construct(dest, count)，
+ *        每个 __construct 调用要么构建好 [dest, dest + count)，要么析构自己构建的元素并抛出异常。
+ *
+ * @brief - 任何一段失败时，其他段构建好的元素都会被析构，然后重新抛出第一个异常，区间回到未初始化的状态。
+*/
+template <typename Type, typename Construct>
+void __parallelConstruct(Type * __first, std::size_t __n, __ParallelInit __policy, Construct __construct)
+{
+    constexpr std::size_t PAGE_BYTES = 4096;
+
+    std::size_t threads = __policy.threads != 0 ? __policy.threads : std::thread::hardware_concurrency();
+
+    if (threads <= 1 || __n * sizeof(Type) < __policy.minBytes) { __construct(__first, __n); return; }
+
+    /*每段至少一页，分段边界对齐到页（元素跨页时只能对齐到附近的元素）*/
+    const std::size_t pageElements = (PAGE_BYTES + sizeof(Type) - 1) / sizeof(Type);
+    const std::size_t maxThreads   = (__n + pageElements - 1) / pageElements;
+
+    if (threads > maxThreads) { threads = maxThreads; }
+
+    std::vector<std::size_t> bounds(threads + 1);
+    bounds[0]       = 0;
+    bounds[threads] = __n;
+
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(__first);
+
+    for (std::size_t index = 1; index < threads; ++index)
+    {
+        const std::uintptr_t target  = base + (__n * index / threads) * sizeof(Type);
+        const std::uintptr_t aligned = (target + PAGE_BYTES - 1) & ~std::uintptr_t(PAGE_BYTES - 1);
+
+        std::size_t bound = (aligned - base + sizeof(Type) - 1) / sizeof(Type);
+
+        if (bound < bounds[index - 1]) { bound = bounds[index - 1]; }
+        if (bound > __n) { bound = __n; }
+
+        bounds[index] = bound;
+    }
+
+    std::vector<std::exception_ptr> errors(threads);
+
+    auto runChunk = [&](std::size_t __chunk) {
+        try { __construct(__first + bounds[__chunk], bounds[__chunk + 1] - bounds[__chunk]); }
+        catch (...) { errors[__chunk] = std::current_exception(); }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    try
+    {
+        for (std::size_t chunk = 1; chunk < threads; ++chunk) { workers.emplace_back(runChunk, chunk); }
+    }
+    catch (...)
+    {
+        /*线程创建失败：剩下的段由当前线程构建*/
+        for (std::size_t chunk = workers.size() + 1; chunk < threads; ++chunk) { runChunk(chunk); }
+    }
+
+    runChunk(0);
+
+    for (std::thread & worker : workers) { worker.join(); }
+
+    std::exception_ptr firstError;
+
+    for (std::size_t chunk = 0; chunk < threads; ++chunk)
+    {
+        if (errors[chunk] && !firstError) { firstError = errors[chunk]; }
+    }
+
+    if (firstError)
+    {
+        for (std::size_t chunk = 0; chunk < threads; ++chunk)
+        {
+            if (!errors[chunk]) { std::destroy(__first + bounds[chunk], __first + bounds[chunk + 1]); }
+        }
+
+        std::rethrow_exception(firstError);
+    }
+}
+
+#endif // _PARALLEL_CONSTRUCT_H_
@@ -0,0 +1,283 @@
+#ifndef _MY_SMALL_VECTOR_H_
+#define _MY_SMALL_VECTOR_H_
+
+#include "./myVector.h"
+
+/*
+    带内联缓冲区的 vector（small-buffer optimization）。
+
+    My_SmallVector<Type, N> 自带能放下 N 个元素的缓冲区，元素不超过 N 个时完全不经过分配器，
+    超出之后才像 My_Vector 一样在堆上扩容，API 与 My_Vector 相同（它就是一个 My_Vector）。
+
+    实现上 My_Vector 的分配器换成了 __SmallBufferAllocator：它持有内联缓冲区的指针，
+    缓冲区空闲且请求不超过 N 个元素时交出缓冲区，否则转交真正的分配器 Alloc，
+    释放时认出内联缓冲区并把它标记为空闲。My_Vector 的扩容、插入、reserve 等代码因此无需改动。
+
+    与内联缓冲区的地址有关的操作（构造、移动、交换、shrink_to_fit、析构）由 My_SmallVector 自己处理：
+    内联的元素只能逐个移动，堆上的数组则直接接管。
+*/
+
+/**
+ * @brief 内联缓冲区：N 个未构造的 Type，以及缓冲区当前是否被 vector 使用。
+*/
+template <typename Type, std::size_t N>
+struct __SmallBuffer
+{
+    alignas(Type) unsigned char storage[N * sizeof(Type)];
+    bool inUse = false;
+
+    Type * data(void) noexcept { return reinterpret_cast<Type *>(this->storage); }
+    const Type * data(void) const noexcept { return reinterpret_cast<const Type *>(this->storage); }
+};
+
+/**
+ * @brief 先从内联缓冲区分配、放不下时转交 Alloc 的分配器，只供 My_SmallVector 使用。
+*/
+template <typename Type, std::size_t N, typename Alloc>
+class __SmallBufferAllocator
+{
+    private:
+        template <typename, std::size_t, typename> friend class __SmallBufferAllocator;
+
+        __SmallBuffer<Type, N> *    buffer;
+        Simple_Alloc<Type, Alloc>   heap;       // 真正的分配器（标准风格、SGI 风格都可以）
+
+    public:
+        typedef Type value_type;
+
+        /*内联缓冲区属于具体的某个容器，分配器不能随容器传播，也只与自己相等*/
+        typedef std::false_type propagate_on_container_copy_assignment;
+        typedef std::false_type propagate_on_container_move_assignment;
+        typedef std::false_type propagate_on_container_swap;
+        typedef std::false_type is_always_equal;
+
+        template <typename Other>
+        struct rebind { typedef __SmallBufferAllocator<Other, N, Alloc> other; };
+
+        __SmallBufferAllocator(__SmallBuffer<Type, N> * __buffer, const Alloc & __alloc)
+            : buffer(__buffer), heap(__alloc) {}
+
+        Type * allocate(std::size_t __n)
+        {
+            if (__n <= N && !this->buffer->inUse)
+            {
+                this->buffer->inUse = true;
+                return this->buffer->data();
+            }
+
+            return this->heap.allocate(__n);
+        }
+
+        void deallocate(Type * __ptr, std::size_t __n)
+        {
+            if (__ptr == this->buffer->data()) { this->buffer->inUse = false; }
+            else { this->heap.deallocate(__ptr, __n); }
+        }
+
+        /**
+         * @brief 两个分配器在堆上申请的内存能否互相释放。
+        */
+        bool heapEqual(const __SmallBufferAllocator & __other) const { return this->heap.equalAllocator(__other.heap); }
+
+        Alloc heapAllocator(void) const { return Alloc(this->heap.getAllocator()); }
+
+        template <typename Other>
+        bool operator==(const __SmallBufferAllocator<Other, N, Alloc> & __other) const
+        {
+            return (void *)this->buffer == (void *)__other.buffer;
+        }
+
+        template <typename Other>
+        bool operator!=(const __SmallBufferAllocator<Other, N, Alloc> & __other) const { return !(*this == __other); }
+};
+
+/**
+ * @tparam Type         元素类型
+ * @tparam N            内联缓冲区能放下的元素个数
+ * @tparam Alloc        超出 N 个元素之后使用的分配器，默认为 `std::allocator<Type>`
+ * @tparam GrowthPolicy 扩容策略（见 growthPolicy.h），默认每次翻倍
+*/
+template <typename Type, std::size_t N, typename Alloc = std::allocator<Type>, typename GrowthPolicy = doublingGrowth>
+class My_SmallVector : public My_Vector<Type, __SmallBufferAllocator<Type, N, Alloc>, GrowthPolicy>
+{
+    static_assert(N > 0, "My_SmallVector needs room for at least one element, use My_Vector otherwise");
+
+    private:
+        typedef __SmallBufferAllocator<Type, N, Alloc>              bufferAllocator;
+        typedef My_Vector<Type, bufferAllocator, GrowthPolicy>      base;
+
+        __SmallBuffer<Type, N> smallBuffer;
+
+        /**
+         * @brief 让 vector 重新使用（空的）内联缓冲区，调用前元素必须已经析构、堆上的数组已经释放。
+        */
+        void resetToInline(void) noexcept
+        {
+            this->start        = this->smallBuffer.data();
+            this->finish       = this->start;
+            this->endOfStorage = this->start + N;
+
+            this->smallBuffer.inUse = true;
+        }
+
+        /**
+         * @brief 析构所有元素，释放堆上的数组（如果有），回到空的内联缓冲区。
+        */
+        void releaseToInline(void) noexcept
+        {
+            this->eraseAtEnd(this->start);
+
+            if (!this->isInline())
+            {
+                this->deallocate();
+                this->resetToInline();
+            }
+        }
+
+        /**
+         * @brief 把 __vec 的元素移动过来（调用前本容器必须是空的内联状态）：
+         *        __vec 在堆上、并且两边堆上的内存可以互相释放时直接接管它的数组，否则逐个移动元素。
+        */
+        void moveFrom(My_SmallVector & __vec)
+        {
+            if (!__vec.isInline() && this->getAllocator().heapEqual(__vec.getAllocator()))
+            {
+                this->smallBuffer.inUse = false;
+
+                this->start        = __vec.start;
+                this->finish       = __vec.finish;
+                this->endOfStorage = __vec.endOfStorage;
+
+                __vec.resetToInline();
+            }
+            else
+            {
+                this->assign(std::make_move_iterator(__vec.begin()), std::make_move_iterator(__vec.end()));
+                __vec.clear();
+            }
+        }
+
+    public:
+        typedef typename base::sizeType         sizeType;
+        typedef typename base::pointer          pointer;
+        typedef Alloc                           allocatorType;
+
+        My_SmallVector() : My_SmallVector(Alloc()) {}
+
+        explicit My_SmallVector(const Alloc & __alloc) : base(bufferAllocator(&smallBuffer, __alloc))
+        {
+            this->resetToInline();
+        }
+
+        My_SmallVector(sizeType __n, const Type & __value, const Alloc & __alloc = Alloc())
+            : My_SmallVector(__alloc) { this->assign(__n, __value); }
+
+        explicit My_SmallVector(sizeType __n, const Alloc & __alloc = Alloc())
+            : My_SmallVector(__alloc) { this->resize(__n); }
+
+        My_SmallVector(sizeType __n, __DefaultInit, const Alloc & __alloc = Alloc())
+            : My_SmallVector(__alloc) { this->resize(__n, defaultInit); }
+
+        My_SmallVector(std::initializer_list<Type> __initList, const Alloc & __alloc = Alloc())
+            : My_SmallVector(__alloc) { this->assign(__initList.begin(), __initList.end()); }
+
+        template <typename InputIterator, typename = __requireInputIterator<InputIterator>>
+        My_SmallVector(InputIterator __first, InputIterator __last, const Alloc & __alloc = Alloc())
+            : My_SmallVector(__alloc) { this->assign(__first, __last); }
+
+        My_SmallVector(const My_SmallVector & __vec)
+            : My_SmallVector(__vec.get_allocator()) { this->assign(__vec.begin(), __vec.end()); }
+
+        /**
+         * @brief 移动构造：堆上的数组直接接管，内联的元素逐个移动。
+        */
+        My_SmallVector(My_SmallVector && __vec) noexcept(std::is_nothrow_move_constructible<Type>::value)
+            : My_SmallVector(__vec.get_allocator())
+        {
+            this->moveFrom(__vec);
+        }
+
+        My_SmallVector & operator=(const My_SmallVector & __vec)
+        {
+            if (this != &__vec) { this->assign(__vec.begin(), __vec.end()); }
+
+            return *this;
+        }
+
+        My_SmallVector & operator=(My_SmallVector && __vec)
+        {
+            if (this != &__vec)
+            {
+                this->releaseToInline();
+                this->moveFrom(__vec);
+            }
+
+            return *this;
+        }
+
+        My_SmallVector & operator=(std::initializer_list<Type> __initList)
+        {
+            this->assign(__initList.begin(), __initList.end());
+
+            return *this;
+        }
+
+        ~My_SmallVector()
+        {
+            this->eraseAtEnd(this->start);
+
+            /*内联缓冲区先于基类析构，不能再交给基类去 "释放"*/
+            if (this->isInline())
+            {
+                this->start = this->finish = this->endOfStorage = nullptr;
+            }
+        }
+
+        /**
+         * @brief 元素是否存放在内联缓冲区中（没有使用堆上的内存）。
+        */
+        bool isInline(void) const noexcept { return this->start == this->smallBuffer.data(); }
+
+        /**
+         * @brief 获取超出内联缓冲区之后使用的分配器。
+        */
+        allocatorType get_allocator() const { return this->getAllocator().heapAllocator(); }
+
+        /**
+         * @brief 交换两个 vector 的内容：两边都在堆上时只交换指针，否则经由一个临时对象逐个移动内联的元素。
+        */
+        void swap(My_SmallVector & __vec)
+        {
+            if (this == &__vec) { return; }
+
+            My_SmallVector temp(std::move(__vec));
+
+            __vec = std::move(*this);
+            *this = std::move(temp);
+        }
+
+        /**
+         * @brief 释放多余的容量：元素不超过 N 个时搬回内联缓冲区，否则与 My_Vector 相同。
+        */
+        void shrink_to_fit()
+        {
+            if (this->isInline()) { return; }
+
+            if (this->size() > N) { base::shrink_to_fit(); return; }
+
+            const sizeType oldSize = this->size();
+            pointer newStart       = this->smallBuffer.data();
+
+            base::uninitializedMoveIfNoexcept(this->start, this->finish, newStart);
+
+            std::destroy(this->start, this->finish);
+            this->deallocate();
+
+            this->start             = newStart;
+            this->finish            = newStart + oldSize;
+            this->endOfStorage      = newStart + N;
+            this->smallBuffer.inUse = true;
+        }
+};
+
+#endif // _MY_SMALL_VECTOR_H_
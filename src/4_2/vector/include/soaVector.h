@@ -0,0 +1,734 @@
+#ifndef _MY_SOA_VECTOR_H_
+#define _MY_SOA_VECTOR_H_
+
+#include "./myVector.h"
+
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+/*
+    按字段分开存放的 vector（structure of arrays）。
+
+    My_Vector<Particle> 把每个结构体的所有字段挨在一起存放，只读其中一两个字段的循环也要把整个结构体载入缓存，
+    步长为 sizeof(Particle) 的访问也很难被编译器向量化。
+    My_SoAVector<float, float, float, int> 则为每个字段各分配一个连续的数组，所有数组共用同一个 size() 与 capacity()：
+
+    1. field<I>() 返回第 I 个字段的 std::span，扫描单个字段就是遍历一个连续的数组，编译器可以直接向量化；
+    2. operator[]、迭代器解引用得到的是各字段引用组成的 std::tuple（代理引用，与 std::vector<bool> 类似），
+       可以用结构化绑定按 “一行” 访问：auto [x, y, z, id] = vec[n];
+    3. 每个字段的数组都像 My_Vector 那样管理：经 Simple_Alloc 申请（标准风格的分配器重绑定到字段类型），
+       容量由 GrowthPolicy 决定，可平凡重定位的字段扩容时直接 memcpy，否则逐个移动（有字段移动可能抛出异常时拷贝）。
+
+    添加一行时逐个字段构建，某个字段构建失败则析构已经构建的字段，容器保持不变；扩容失败时同样保持不变。
+*/
+
+/**
+ * @brief My_SoAVector 的迭代器：各字段数组的首地址加上行号，解引用得到代理引用（各字段引用组成的 std::tuple）。
+ *
+ * @tparam Const  是否为只读迭代器
+ * @tparam Fields 各字段的类型
+*/
+template <bool Const, typename... Fields>
+class __SoAIterator
+{
+    private:
+        template <bool, typename...> friend class __SoAIterator;
+
+        typedef std::conditional_t<Const, std::tuple<const Fields *...>, std::tuple<Fields *...>> pointers;
+
+        pointers        starts;     // 各字段数组的首地址
+        std::ptrdiff_t  index;      // 当前行号
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef std::tuple<Fields...>           value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef void                            pointer;
+        typedef std::conditional_t<Const, std::tuple<const Fields &...>, std::tuple<Fields &...>> reference;
+
+        __SoAIterator() noexcept : starts(), index(0) {}
+
+        __SoAIterator(const pointers & __starts, difference_type __index) noexcept : starts(__starts), index(__index) {}
+
+        /**
+         * @brief iterator 可以转换为 constIterator。
+        */
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        __SoAIterator(const __SoAIterator<OtherConst, Fields...> & __other) noexcept
+            : starts(__other.starts), index(__other.index) {}
+
+        /**
+         * @brief 当前行第 Index 个字段的引用。
+        */
+        template <std::size_t Index>
+        auto & field(void) const { return std::get<Index>(this->starts)[this->index]; }
+
+        difference_type position(void) const noexcept { return this->index; }
+
+        reference operator*() const { return (*this)[0]; }
+
+        reference operator[](difference_type __n) const
+        {
+            return std::apply([this, __n](auto *... __starts) { return reference(__starts[this->index + __n]...); }, this->starts);
+        }
+
+        __SoAIterator & operator++() { ++this->index; return *this; }
+        __SoAIterator & operator--() { --this->index; return *this; }
+
+        __SoAIterator operator++(int) { __SoAIterator old = *this; ++this->index; return old; }
+        __SoAIterator operator--(int) { __SoAIterator old = *this; --this->index; return old; }
+
+        __SoAIterator & operator+=(difference_type __n) { this->index += __n; return *this; }
+        __SoAIterator & operator-=(difference_type __n) { this->index -= __n; return *this; }
+
+        __SoAIterator operator+(difference_type __n) const { return __SoAIterator(this->starts, this->index + __n); }
+        __SoAIterator operator-(difference_type __n) const { return __SoAIterator(this->starts, this->index - __n); }
+
+        friend __SoAIterator operator+(difference_type __n, const __SoAIterator & __iter) { return __iter + __n; }
+
+        difference_type operator-(const __SoAIterator & __other) const { return this->index - __other.index; }
+
+        bool operator==(const __SoAIterator & __other) const { return this->index == __other.index; }
+        bool operator!=(const __SoAIterator & __other) const { return this->index != __other.index; }
+        bool operator< (const __SoAIterator & __other) const { return this->index <  __other.index; }
+        bool operator> (const __SoAIterator & __other) const { return this->index >  __other.index; }
+        bool operator<=(const __SoAIterator & __other) const { return this->index <= __other.index; }
+        bool operator>=(const __SoAIterator & __other) const { return this->index >= __other.index; }
+};
+
+/**
+ * @tparam Alloc        分配器类型，每个字段各用一个重绑定（SGI 风格则原样保存）的副本
+ * @tparam GrowthPolicy 扩容策略（见 growthPolicy.h），按一行的字节数（各字段大小之和）计算
+ * @tparam Fields       各字段的类型
+*/
+template <typename Alloc, typename GrowthPolicy, typename... Fields>
+class My_BasicSoAVector
+{
+    static_assert(sizeof...(Fields) > 0, "My_SoAVector needs at least one field");
+
+    public:
+        using valueType      = std::tuple<Fields...>;           // 一行的值
+        using reference      = std::tuple<Fields &...>;         // 一行的代理引用
+        using constReference = std::tuple<const Fields &...>;   // 一行的只读代理引用
+        using iterator       = __SoAIterator<false, Fields...>;
+        using constIterator  = __SoAIterator<true, Fields...>;
+        using sizeType       = std::size_t;
+        using differenceType = std::ptrdiff_t;
+        using allocatorType  = Alloc;
+
+        /**
+         * 第 Index 个字段的类型。
+        */
+        template <std::size_t Index>
+        using fieldType = std::tuple_element_t<Index, valueType>;
+
+        static constexpr std::size_t fieldCount = sizeof...(Fields);
+
+    protected:
+        using pointers = std::tuple<Fields *...>;
+        using fieldIndices = std::index_sequence_for<Fields...>;
+
+        std::tuple<Simple_Alloc<Fields, Alloc>...> allocators;  // 每个字段数组各自的分配器
+
+        pointers start;         // 各字段数组之首
+        sizeType count;         // 元素（行）个数
+        sizeType storageCount;  // 每个字段数组能放下的元素个数
+
+        /**
+         * @brief 辅助函数，依次对每个字段调用 __apply(std::integral_constant<std::size_t, I>())。
+        */
+        template <typename Apply, std::size_t... Index>
+        static void forEachField(Apply __apply, std::index_sequence<Index...>)
+        {
+            (__apply(std::integral_constant<std::size_t, Index>()), ...);
+        }
+
+        /**
+         * @brief 辅助函数，依次对每个字段调用 __apply，某个字段抛出异常时，
+         *        对之前已经成功的字段调用 __undo 撤销，再重新抛出异常。
+        */
+        template <typename Apply, typename Undo, std::size_t... Index>
+        static void forEachFieldOrUndo(Apply __apply, Undo __undo, std::index_sequence<Index...>)
+        {
+            std::size_t done = 0;
+
+            try { ((__apply(std::integral_constant<std::size_t, Index>()), ++done), ...); }
+            catch (...)
+            {
+                ((Index < done ? __undo(std::integral_constant<std::size_t, Index>()) : void()), ...);
+                throw;
+            }
+        }
+
+        /**
+         * @brief 辅助函数，为每个字段申请能放下 __n 个元素的数组，某个字段申请失败时释放已经申请的数组。
+        */
+        pointers allocateFields(sizeType __n)
+        {
+            pointers fresh{};
+
+            if (__n == 0) { return fresh; }
+
+            forEachFieldOrUndo(
+                [&](auto __index) { std::get<__index>(fresh) = std::get<__index>(this->allocators).allocate(__n); },
+                [&](auto __index) { std::get<__index>(this->allocators).deallocate(std::get<__index>(fresh), __n); },
+                fieldIndices()
+            );
+
+            return fresh;
+        }
+
+        void deallocateFields(const pointers & __fields, sizeType __n) noexcept
+        {
+            forEachField([&](auto __index) { std::get<__index>(this->allocators).deallocate(std::get<__index>(__fields), __n); }, fieldIndices());
+        }
+
+        /**
+         * @brief 辅助函数，析构 __fields 中第 [__first, __last) 行的所有字段。
+        */
+        static void destroyRows(const pointers & __fields, sizeType __first, sizeType __last) noexcept
+        {
+            forEachField([&](auto __index) {
+                std::destroy(std::get<__index>(__fields) + __first, std::get<__index>(__fields) + __last);
+            }, fieldIndices());
+        }
+
+        /**
+         * @brief 辅助函数，在 __fields 的第 __row 行用 __args 逐个构建字段（第 I 个参数构建第 I 个字段），
+         *        某个字段构建失败时析构已经构建的字段。
+        */
+        template <typename... Args>
+        static void constructRow(const pointers & __fields, sizeType __row, Args &&... __args)
+        {
+            static_assert(sizeof...(Args) == sizeof...(Fields), "one argument per field");
+
+            auto arguments = std::forward_as_tuple(std::forward<Args>(__args)...);
+
+            forEachFieldOrUndo(
+                [&](auto __index) {
+                    std::_Construct(
+                        std::get<__index>(__fields) + __row,
+                        std::forward<std::tuple_element_t<__index, std::tuple<Args &&...>>>(std::get<__index>(arguments))
+                    );
+                },
+                [&](auto __index) { std::_Destroy(std::get<__index>(__fields) + __row); },
+                fieldIndices()
+            );
+        }
+
+        /**
+         * @brief 辅助函数，在 __fields 的第 __row 行构建 __value 的拷贝（或移动）。
+        */
+        template <typename Tuple, std::size_t... Index>
+        static void constructRowFromTuple(const pointers & __fields, sizeType __row, Tuple && __value, std::index_sequence<Index...>)
+        {
+            constructRow(__fields, __row, std::get<Index>(std::forward<Tuple>(__value))...);
+        }
+
+        /**
+         * @brief 辅助函数，在 __fields 的第 [__first, __last) 行构建 __construct(fieldIndex, dest, n) 给出的元素，
+         *        每次调用负责一个字段，失败时它自己析构已经构建的元素，已经完成的字段由这里析构。
+        */
+        template <typename Construct>
+        static void constructRows(const pointers & __fields, sizeType __first, sizeType __last, Construct __construct)
+        {
+            forEachFieldOrUndo(
+                [&](auto __index) { __construct(__index, std::get<__index>(__fields) + __first, __last - __first); },
+                [&](auto __index) { std::destroy(std::get<__index>(__fields) + __first, std::get<__index>(__fields) + __last); },
+                fieldIndices()
+            );
+        }
+
+        /**
+         * 每个字段都可平凡重定位或者移动时不会抛出异常，扩容时整行搬移不会失败。
+         * 否则某个字段失败时，之前已经移动过的字段无法复原，这时能拷贝的字段都改为拷贝。
+        */
+        static constexpr bool nothrowRelocate =
+            ((__isTriviallyRelocatable<Fields>::value || std::is_nothrow_move_constructible<Fields>::value) && ...);
+
+        /**
+         * @brief 辅助函数，把一个字段的 [__first, __last) 搬到未初始化的 __dest：
+         *        可平凡重定位时按字节搬移（原来的位置视为未初始化），否则移动构建（见 nothrowRelocate）。
+        */
+        template <typename Field>
+        static void moveField(Field * __first, Field * __last, Field * __dest)
+        {
+            if constexpr (__isTriviallyRelocatable<Field>::value)
+            {
+                if (__first != __last)
+                {
+                    std::memcpy(static_cast<void *>(__dest), static_cast<const void *>(__first), (__last - __first) * sizeof(Field));
+                }
+            }
+            else if constexpr (nothrowRelocate || !std::is_copy_constructible<Field>::value)
+            {
+                std::uninitialized_move(__first, __last, __dest);
+            }
+            else { std::uninitialized_copy(__first, __last, __dest); }
+        }
+
+        /**
+         * @brief 辅助函数，把每个字段数组的容量调整为 __newCapacity（不小于 size()），
+         *        搬移元素之前先由 __construct(fresh) 在新数组的 [size(), size() + __added) 行构建新增的元素，
+         *        这样参数引用的是本容器的元素时也是安全的。
+         *
+         * @brief - 任何一步抛出异常时，新数组中构建的元素全部析构、新数组全部释放，容器保持不变。
+        */
+        template <typename Construct>
+        void relocateStorage(sizeType __newCapacity, sizeType __added, Construct __construct)
+        {
+            pointers fresh = this->allocateFields(__newCapacity);
+
+            try
+            {
+                __construct(fresh);
+
+                try
+                {
+                    forEachFieldOrUndo(
+                        [&](auto __index) {
+                            moveField(std::get<__index>(this->start), std::get<__index>(this->start) + this->count, std::get<__index>(fresh));
+                        },
+                        [&](auto __index) {
+                            using Field = std::tuple_element_t<__index, valueType>;
+
+                            if constexpr (!__isTriviallyRelocatable<Field>::value)
+                            {
+                                std::destroy(std::get<__index>(fresh), std::get<__index>(fresh) + this->count);
+                            }
+                        },
+                        fieldIndices()
+                    );
+                }
+                catch (...)
+                {
+                    destroyRows(fresh, this->count, this->count + __added);
+                    throw;
+                }
+            }
+            catch (...)
+            {
+                this->deallocateFields(fresh, __newCapacity);
+                throw;
+            }
+
+            /*按字节搬走的字段不再析构*/
+            forEachField([&](auto __index) {
+                using Field = std::tuple_element_t<__index, valueType>;
+
+                if constexpr (!__isTriviallyRelocatable<Field>::value)
+                {
+                    std::destroy(std::get<__index>(this->start), std::get<__index>(this->start) + this->count);
+                }
+            }, fieldIndices());
+
+            this->deallocateFields(this->start, this->storageCount);
+
+            this->start        = fresh;
+            this->storageCount = __newCapacity;
+            this->count       += __added;
+        }
+
+        /**
+         * @brief 辅助函数，按 GrowthPolicy 计算再放入 __n 行时扩容后的容量。
+        */
+        sizeType nextCapacity(sizeType __n) const
+        {
+            return GrowthPolicy::nextCapacity(
+                this->count, this->count + __n, (sizeof(Fields) + ...),
+                [](std::size_t __bytes) { return __bytes; }
+            );
+        }
+
+        /**
+         * @brief 辅助函数，在末尾添加 __n 行，由 __construct(fields, first, last) 在 [first, last) 行构建各字段，
+         *        容量不够时先扩容（新增的行先于旧元素的搬移构建）。
+        */
+        template <typename Construct>
+        void appendRows(sizeType __n, Construct __construct)
+        {
+            if (this->storageCount - this->count >= __n)
+            {
+                __construct(this->start, this->count, this->count + __n);
+                this->count += __n;
+            }
+            else
+            {
+                this->relocateStorage(this->nextCapacity(__n), __n, [&](const pointers & __fresh) {
+                    __construct(__fresh, this->count, this->count + __n);
+                });
+            }
+        }
+
+        /**
+         * @brief 辅助函数，在末尾添加 __n 个 __value 的拷贝。
+        */
+        void appendFill(sizeType __n, const valueType & __value)
+        {
+            this->appendRows(__n, [&](const pointers & __fields, sizeType __first, sizeType __last) {
+                constructRows(__fields, __first, __last, [&](auto __index, auto * __dest, sizeType __rows) {
+                    std::uninitialized_fill_n(__dest, __rows, std::get<__index>(__value));
+                });
+            });
+        }
+
+        /**
+         * @brief 辅助函数，析构第 __row 行及之后的所有元素。
+        */
+        void eraseAtEnd(sizeType __row) noexcept
+        {
+            destroyRows(this->start, __row, this->count);
+            this->count = __row;
+        }
+
+        /**
+         * @brief 辅助函数，析构所有元素并释放内存，回到没有分配任何内存的状态。
+        */
+        void destroyAndDeallocate() noexcept
+        {
+            destroyRows(this->start, 0, this->count);
+            this->deallocateFields(this->start, this->storageCount);
+
+            this->start        = pointers{};
+            this->count        = 0;
+            this->storageCount = 0;
+        }
+
+        /**
+         * @brief 辅助函数，拷贝（__Move 时移动）__other 的全部元素，调用前容器必须没有持有内存。
+        */
+        template <bool Move, typename Other>
+        void copyFrom(Other & __other)
+        {
+            pointers fresh = this->allocateFields(__other.count);
+
+            try
+            {
+                constructRows(fresh, 0, __other.count, [&](auto __index, auto * __dest, sizeType __rows) {
+                    auto * source = std::get<__index>(__other.start);
+
+                    if constexpr (Move) { std::uninitialized_move(source, source + __rows, __dest); }
+                    else { std::uninitialized_copy(source, source + __rows, __dest); }
+                });
+            }
+            catch (...)
+            {
+                this->deallocateFields(fresh, __other.count);
+                throw;
+            }
+
+            this->start        = fresh;
+            this->count        = __other.count;
+            this->storageCount = __other.count;
+        }
+
+        /**
+         * @brief 辅助函数，接管 __other 的数组，__other 变为空。
+        */
+        void steal(My_BasicSoAVector & __other) noexcept
+        {
+            this->start        = std::exchange(__other.start, pointers{});
+            this->count        = std::exchange(__other.count, 0);
+            this->storageCount = std::exchange(__other.storageCount, 0);
+        }
+
+        bool equalAllocators(const My_BasicSoAVector & __other) const
+        {
+            bool equal = true;
+            forEachField([&](auto __index) {
+                equal = equal && std::get<__index>(this->allocators).equalAllocator(std::get<__index>(__other.allocators));
+            }, fieldIndices());
+
+            return equal;
+        }
+
+        constIterator makeIterator(sizeType __row) const noexcept
+        {
+            return constIterator(this->start, differenceType(__row));
+        }
+
+    public:
+        iterator begin() noexcept               { return iterator(this->start, 0); }
+        iterator end()   noexcept               { return iterator(this->start, differenceType(this->count)); }
+        constIterator begin() const noexcept    { return this->makeIterator(0); }
+        constIterator end()   const noexcept    { return this->makeIterator(this->count); }
+        constIterator cbegin() const noexcept   { return this->makeIterator(0); }
+        constIterator cend()   const noexcept   { return this->makeIterator(this->count); }
+
+        sizeType size()     const noexcept { return this->count; }
+        sizeType capacity() const noexcept { return this->storageCount; }
+
+        bool empty() const noexcept { return this->count == 0; }
+
+        /**
+         * @brief 第 Index 个字段的连续数组，长度为 size()。
+        */
+        template <std::size_t Index>
+        std::span<fieldType<Index>> field() noexcept { return std::span<fieldType<Index>>(std::get<Index>(this->start), this->count); }
+
+        template <std::size_t Index>
+        std::span<const fieldType<Index>> field() const noexcept
+        {
+            return std::span<const fieldType<Index>>(std::get<Index>(this->start), this->count);
+        }
+
+        /**
+         * @brief 第 Index 个字段数组的首地址。
+        */
+        template <std::size_t Index>
+        fieldType<Index> * data() noexcept { return std::get<Index>(this->start); }
+
+        template <std::size_t Index>
+        const fieldType<Index> * data() const noexcept { return std::get<Index>(this->start); }
+
+        reference operator[](sizeType __n)
+        {
+            __VECTOR_ASSERT(__n < this->size(), "operator[] index out of range");
+            return std::apply([__n](auto *... __starts) { return reference(__starts[__n]...); }, this->start);
+        }
+
+        constReference operator[](sizeType __n) const
+        {
+            __VECTOR_ASSERT(__n < this->size(), "operator[] index out of range");
+            return std::apply([__n](auto *... __starts) { return constReference(__starts[__n]...); }, this->start);
+        }
+
+        reference at(sizeType __n)
+        {
+            if (__n >= this->size())
+            {
+                throw std::out_of_range(
+                    "invalid argument __n = " + std::to_string(__n)  +
+                    " current size = " + std::to_string(this->size()) + ".\n"
+                );
+            }
+
+            return (*this)[__n];
+        }
+
+        constReference at(sizeType __n) const { return const_cast<My_BasicSoAVector *>(this)->at(__n); }
+
+        reference front() { __VECTOR_ASSERT(!this->empty(), "front() on an empty vector"); return (*this)[0]; }
+        reference back()  { __VECTOR_ASSERT(!this->empty(), "back() on an empty vector"); return (*this)[this->count - 1]; }
+
+        constReference front() const { __VECTOR_ASSERT(!this->empty(), "front() on an empty vector"); return (*this)[0]; }
+        constReference back()  const { __VECTOR_ASSERT(!this->empty(), "back() on an empty vector"); return (*this)[this->count - 1]; }
+
+        My_BasicSoAVector() : allocators(), start(), count(0), storageCount(0) {}
+
+        explicit My_BasicSoAVector(const Alloc & __alloc)
+            : allocators(Simple_Alloc<Fields, Alloc>(__alloc)...), start(), count(0), storageCount(0) {}
+
+        /**
+         * @brief 构造 __n 行，每个字段都值初始化。
+        */
+        explicit My_BasicSoAVector(sizeType __n, const Alloc & __alloc = Alloc()) : My_BasicSoAVector(__alloc)
+        {
+            this->resize(__n);
+        }
+
+        My_BasicSoAVector(sizeType __n, const valueType & __value, const Alloc & __alloc = Alloc()) : My_BasicSoAVector(__alloc)
+        {
+            this->appendFill(__n, __value);
+        }
+
+        My_BasicSoAVector(std::initializer_list<valueType> __initList, const Alloc & __alloc = Alloc()) : My_BasicSoAVector(__alloc)
+        {
+            this->reserve(__initList.size());
+
+            for (const valueType & value : __initList) { this->push_back(value); }
+        }
+
+        My_BasicSoAVector(const My_BasicSoAVector & __other)
+            : allocators(std::apply([](const auto &... __allocs) {
+                  return std::tuple<Simple_Alloc<Fields, Alloc>...>(Simple_Alloc<Fields, Alloc>(__allocs.selectOnCopy())...);
+              }, __other.allocators)),
+              start(), count(0), storageCount(0)
+        {
+            this->template copyFrom<false>(__other);
+        }
+
+        /**
+         * @brief 移动构造函数，分配器随数组一起移动过来。
+        */
+        My_BasicSoAVector(My_BasicSoAVector && __other) noexcept
+            : allocators(__other.allocators), start(), count(0), storageCount(0)
+        {
+            this->steal(__other);
+        }
+
+        /**
+         * @brief 拷贝赋值，分配器是否随之拷贝由 propagate_on_container_copy_assignment 决定。
+        */
+        My_BasicSoAVector & operator=(const My_BasicSoAVector & __other)
+        {
+            if (this == &__other) { return *this; }
+
+            this->destroyAndDeallocate();
+            forEachField([&](auto __index) {
+                std::get<__index>(this->allocators).copyAssignAllocator(std::get<__index>(__other.allocators));
+            }, fieldIndices());
+            this->template copyFrom<false>(__other);
+
+            return *this;
+        }
+
+        /**
+         * @brief 移动赋值：分配器会随之移动或者相等时直接接管数组，否则逐个移动元素。
+        */
+        My_BasicSoAVector & operator=(My_BasicSoAVector && __other)
+        {
+            if (this == &__other) { return *this; }
+
+            this->destroyAndDeallocate();
+
+            if ((Simple_Alloc<Fields, Alloc>::propagateOnMoveAssignment::value && ...) || this->equalAllocators(__other))
+            {
+                forEachField([&](auto __index) {
+                    std::get<__index>(this->allocators).moveAssignAllocator(std::get<__index>(__other.allocators));
+                }, fieldIndices());
+                this->steal(__other);
+            }
+            else { this->template copyFrom<true>(__other); }
+
+            return *this;
+        }
+
+        ~My_BasicSoAVector()
+        {
+            destroyRows(this->start, 0, this->count);
+            this->deallocateFields(this->start, this->storageCount);
+        }
+
+        /**
+         * @brief 交换两个容器的内容，分配器是否随之交换由 propagate_on_container_swap 决定（不交换时必须相等）。
+        */
+        void swap(My_BasicSoAVector & __other) noexcept
+        {
+            std::swap(this->start, __other.start);
+            std::swap(this->count, __other.count);
+            std::swap(this->storageCount, __other.storageCount);
+
+            forEachField([&](auto __index) {
+                std::get<__index>(this->allocators).swapAllocator(std::get<__index>(__other.allocators));
+            }, fieldIndices());
+        }
+
+        /**
+         * @brief 在末尾添加一行，第 I 个参数构建第 I 个字段。
+         *
+         * @return 新行的代理引用
+        */
+        template <typename... Args>
+        reference emplace_back(Args &&... __args)
+        {
+            static_assert(sizeof...(Args) == sizeof...(Fields), "emplace_back() takes one argument per field");
+
+            this->appendRows(1, [&](const pointers & __fields, sizeType __row, sizeType) {
+                constructRow(__fields, __row, std::forward<Args>(__args)...);
+            });
+
+            return this->back();
+        }
+
+        void push_back(const valueType & __value)
+        {
+            this->appendRows(1, [&](const pointers & __fields, sizeType __row, sizeType) {
+                constructRowFromTuple(__fields, __row, __value, fieldIndices());
+            });
+        }
+
+        void push_back(valueType && __value)
+        {
+            this->appendRows(1, [&](const pointers & __fields, sizeType __row, sizeType) {
+                constructRowFromTuple(__fields, __row, std::move(__value), fieldIndices());
+            });
+        }
+
+        void pop_back()
+        {
+            __VECTOR_ASSERT(!this->empty(), "pop_back() on an empty vector");
+            this->eraseAtEnd(this->count - 1);
+        }
+
+        /**
+         * @brief 删除 [__first, __last) 中的行，之后的行逐个字段前移。
+        */
+        iterator erase(constIterator __first, constIterator __last)
+        {
+            const sizeType first = sizeType(__first.position());
+            const sizeType last  = sizeType(__last.position());
+
+            if (first != last)
+            {
+                forEachField([&](auto __index) {
+                    auto * fieldStart = std::get<__index>(this->start);
+                    std::move(fieldStart + last, fieldStart + this->count, fieldStart + first);
+                }, fieldIndices());
+
+                this->eraseAtEnd(this->count - (last - first));
+            }
+
+            return iterator(this->start, differenceType(first));
+        }
+
+        iterator erase(constIterator __pos) { return this->erase(__pos, __pos + 1); }
+
+        void clear() noexcept { this->eraseAtEnd(0); }
+
+        /**
+         * @brief 调整行数，新增的行每个字段都值初始化。
+        */
+        void resize(sizeType __newSize)
+        {
+            if (__newSize > this->count)
+            {
+                this->appendRows(__newSize - this->count, [&](const pointers & __fields, sizeType __first, sizeType __last) {
+                    constructRows(__fields, __first, __last, [](auto, auto * __dest, sizeType __rows) {
+                        std::uninitialized_value_construct_n(__dest, __rows);
+                    });
+                });
+            }
+            else { this->eraseAtEnd(__newSize); }
+        }
+
+        /**
+         * @brief 调整行数，新增的行为 __value 的拷贝。
+        */
+        void resize(sizeType __newSize, const valueType & __value)
+        {
+            if (__newSize > this->count) { this->appendFill(__newSize - this->count, __value); }
+            else { this->eraseAtEnd(__newSize); }
+        }
+
+        /**
+         * @brief 预分配每个字段数组的容量，不改变 size()。
+        */
+        void reserve(sizeType __newCapacity)
+        {
+            if (__newCapacity <= this->storageCount) { return; }
+
+            this->relocateStorage(__newCapacity, 0, [](const pointers &) {});
+        }
+
+        /**
+         * @brief 释放多余的容量，让 capacity() == size()。
+        */
+        void shrink_to_fit()
+        {
+            if (this->storageCount == this->count) { return; }
+
+            if (this->empty()) { this->destroyAndDeallocate(); }
+            else { this->relocateStorage(this->count, 0, [](const pointers &) {}); }
+        }
+};
+
+/**
+ * @brief 使用 std::allocator、每次翻倍扩容的 My_BasicSoAVector：My_SoAVector<float, float, int>。
+*/
+template <typename... Fields>
+using My_SoAVector = My_BasicSoAVector<std::allocator<char>, doublingGrowth, Fields...>;
+
+#endif // _MY_SOA_VECTOR_H_
@@ -0,0 +1,116 @@
+#include "../include/mappedVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/*
+    My_MappedVector 基准：
+    比较两种启动方式加载一个 1000 万条记录的查找表的耗时：从文本文件逐行解析重建，与直接打开映射文件。
+    运行时会在临时目录写入约 230 MiB 的映射文件和一个更大的文本文件，结束后删除。
+*/
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief 查找表中的一条记录。
+*/
+struct Entry
+{
+    std::uint64_t   key;
+    double          value;
+    std::uint32_t   flags;
+};
+
+fs::path tempPath(const char * __name)
+{
+    fs::path path = fs::temp_directory_path() / (std::string("myMappedVector_") + std::to_string(::getpid()) + "_" + __name);
+    fs::remove(path);
+
+    return path;
+}
+
+void compareStartup(void)
+{
+    constexpr std::size_t COUNT = 10000000;
+
+    const fs::path textPath   = tempPath("table.txt");
+    const fs::path mappedPath = tempPath("table.vec");
+
+    /*准备两种格式的同一张表*/
+    {
+        std::ofstream text(textPath);
+        My_MappedVector<Entry> table(mappedPath.string());
+
+        text.precision(17);
+
+        table.reserve(COUNT);
+
+        for (std::size_t index = 0; index < COUNT; ++index)
+        {
+            Entry entry{index * 2654435761u, index * 0.5, std::uint32_t(index % 7)};
+
+            text << entry.key << ' ' << entry.value << ' ' << entry.flags << '\n';
+            table.push_back(entry);
+        }
+
+        table.sync();
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    double textChecksum = 0;
+
+    {
+        std::ifstream text(textPath);
+        My_Vector<Entry> table;
+        Entry entry;
+
+        while (text >> entry.key >> entry.value >> entry.flags) { table.push_back(entry); }
+
+        textChecksum = table[COUNT / 2].value + table.back().value;
+        CHECK(table.size() == COUNT);
+    }
+
+    std::chrono::duration<double, std::milli> textTime = std::chrono::steady_clock::now() - startTime;
+
+    startTime = std::chrono::steady_clock::now();
+
+    double mappedChecksum = 0;
+    std::chrono::duration<double, std::milli> openTime;
+
+    {
+        My_MappedVector<Entry> table(mappedPath.string());
+
+        mappedChecksum = table[COUNT / 2].value + table.back().value;
+        openTime = std::chrono::steady_clock::now() - startTime;
+
+        CHECK(table.size() == COUNT);
+
+        /*再完整地扫描一遍，把所有页都读进来*/
+        std::uint64_t flags = 0;
+        for (const Entry & entry : table) { flags += entry.flags; }
+        CHECK(flags > 0);
+    }
+
+    std::chrono::duration<double, std::milli> scanTime = std::chrono::steady_clock::now() - startTime;
+
+    CHECK(textChecksum == mappedChecksum);
+
+    printf("load %zu entries (%.0f MiB)  parse text : %.1f ms;  open mapped file : %.3f ms, open + full scan : %.1f ms\n",
+           COUNT, COUNT * sizeof(Entry) / 1048576.0, textTime.count(), openTime.count(), scanTime.count());
+
+    fs::remove(textPath);
+    fs::remove(mappedPath);
+}
+
+int main(int argc, char const *argv[])
+{
+    compareStartup();
+
+    return testResult();
+}
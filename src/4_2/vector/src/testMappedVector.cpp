@@ -0,0 +1,112 @@
+#include "../include/mappedVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+/*
+    My_MappedVector 测试：
+    1. push_back、insert、resize、erase 之后关闭，再次打开时元素原样可用，文件是整页大小；
+    2. 打开元素大小不同的文件、不是 My_MappedVector 的文件时抛出异常；
+    3. shrink_to_fit() 截短文件，移动构造之后文件随之移动。
+
+    启动耗时的比较见 mappedVectorBenchmark.cpp。
+*/
+
+namespace fs = std::filesystem;
+
+fs::path tempPath(const char * __name)
+{
+    fs::path path = fs::temp_directory_path() / (std::string("myMappedVector_") + std::to_string(::getpid()) + "_" + __name);
+    fs::remove(path);
+
+    return path;
+}
+
+void checkPersistence(void)
+{
+    const fs::path path = tempPath("ints");
+
+    {
+        My_MappedVector<int> vec(path.string());
+        CHECK(vec.empty());
+
+        for (int index = 0; index < 100000; ++index) { vec.push_back(index); }
+
+        vec.insert(vec.begin(), {-1, -2});
+        vec.erase(vec.begin() + 10, vec.begin() + 20);
+        vec.resize(vec.size() + 5);
+        vec.sync();
+    }
+
+    CHECK(fs::file_size(path) % 4096 == 0);
+
+    {
+        My_MappedVector<int> vec(path.string());
+
+        CHECK(vec.size() == 100000 + 2 - 10 + 5);
+        CHECK(vec[0] == -1 && vec[1] == -2 && vec[2] == 0 && vec[10] == 18);
+        CHECK(vec[vec.size() - 6] == 99999 && vec.back() == 0);
+
+        /*再次打开之后继续追加*/
+        vec.pop_back();
+        vec.append_range(std::initializer_list<int>{7, 8, 9});
+    }
+
+    {
+        My_MappedVector<int> vec(path.string());
+        CHECK(vec.size() == 100000 + 2 - 10 + 4 + 3 && vec.back() == 9);
+
+        /*shrink_to_fit 截短文件*/
+        vec.resize(10);
+        vec.shrink_to_fit();
+        CHECK(vec.capacity() == 10 && fs::file_size(path) == __MappedFile::HEADER_BYTES + 10 * sizeof(int));
+
+        My_MappedVector<int> moved(std::move(vec));
+        moved.push_back(42);
+        CHECK(moved.size() == 11 && moved[0] == -1 && moved.back() == 42);
+    }
+
+    {
+        My_MappedVector<int> vec(path.string());
+        CHECK(vec.size() == 11 && vec.back() == 42);
+
+        /*参数引用自己的元素：扩展文件时映射可能被 mremap 挪走，旧地址随之失效*/
+        for (int round = 0; round < 8; ++round)
+        {
+            const std::size_t count = vec.capacity() * 8 + 1;
+
+            vec.assign(count, vec[0]);
+            CHECK(vec.size() == count && vec.front() == -1 && vec.back() == -1);
+        }
+    }
+
+    /*元素大小不同*/
+    bool thrown = false;
+    try { My_MappedVector<double> wrongType(path.string()); }
+    catch (const std::runtime_error &) { thrown = true; }
+    CHECK(thrown);
+
+    /*不是 My_MappedVector 的文件*/
+    const fs::path textPath = tempPath("text");
+    std::ofstream(textPath) << "this is not a mapped vector, but it is long enough to hold a header........";
+
+    thrown = false;
+    try { My_MappedVector<int> notVector(textPath.string()); }
+    catch (const std::runtime_error &) { thrown = true; }
+    CHECK(thrown);
+
+    fs::remove(path);
+    fs::remove(textPath);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkPersistence();
+
+    return testResult();
+}
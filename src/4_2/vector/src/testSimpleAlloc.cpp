@@ -1,26 +1,201 @@
-#include "../include/simpleAlloc.h"
+#include "../../simple_allocator/simpleAlloc.h"
+#include "../include/myVector.h"
+#include "../../list/include/list.h"
+#include "../../dequeue/include/deque.h"
+#include "../../../common/include/testHarness.h"
 
+#include <cstdio>
 #include <cstdlib>
-#include <ctime>
-#include <algorithm>
-#include <iostream>
-#include <memory>
+#include <string>
 
-int main(int argc, char const *argv[])
+/*
+    有状态分配器测试：
+    用一个按请求划分的计数 arena 作为 My_Vector、MyList、My_Deque 的分配器，检查
+    1. 无状态分配器不增加容器的大小（EBO），有状态分配器只多占一个指针；
+    2. 容器的每一次申请都落在自己的 arena 上，容器销毁后申请和释放的字节数对得上；
+    3. 拷贝构造沿用原分配器，分配器不相等且不传播时，移动赋值退化为逐个移动元素；
+    4. 不能默认构造的分配器也能用于 MyList::sort()；
+    5. 按字节申请的 SGI 风格分配器照常可用。
+*/
+
+/**
+ * @brief 一个只记账的 arena，申请直接交给 malloc。
+*/
+struct CountingArena
+{
+    std::size_t allocatedBytes   = 0;
+    std::size_t deallocatedBytes = 0;
+
+    std::size_t liveBytes(void) const { return allocatedBytes - deallocatedBytes; }
+};
+
+/**
+ * @brief 标准风格的有状态分配器，持有一个 arena 的指针，没有默认构造函数，也不随容器赋值传播。
+*/
+template <typename Type>
+struct ArenaAllocator
+{
+    typedef Type value_type;
+
+    CountingArena * arena;
+
+    explicit ArenaAllocator(CountingArena & __arena) : arena(&__arena) {}
+
+    template <typename Other>
+    ArenaAllocator(const ArenaAllocator<Other> & __other) : arena(__other.arena) {}
+
+    Type * allocate(std::size_t __n)
+    {
+        arena->allocatedBytes += __n * sizeof(Type);
+        return (Type *)std::malloc(__n * sizeof(Type));
+    }
+
+    void deallocate(Type * __ptr, std::size_t __n)
+    {
+        arena->deallocatedBytes += __n * sizeof(Type);
+        std::free(__ptr);
+    }
+
+    template <typename Other>
+    bool operator==(const ArenaAllocator<Other> & __other) const { return arena == __other.arena; }
+};
+
+/**
+ * @brief SGI 风格的分配器：没有 value_type，静态的按字节申请。
+*/
+struct ByteAllocator
+{
+    static inline std::size_t liveBytes = 0;
+
+    static void * allocate(std::size_t __bytes) { liveBytes += __bytes; return std::malloc(__bytes); }
+    static void deallocate(void * __ptr, std::size_t __bytes) { liveBytes -= __bytes; std::free(__ptr); }
+};
+
+void checkContainerSize(void)
+{
+    CHECK(sizeof(My_Vector<int>) == 3 * sizeof(void *));
+    CHECK(sizeof(My_Vector<int, ByteAllocator>) == 3 * sizeof(void *));
+    CHECK(sizeof(My_Vector<int, ArenaAllocator<int>>) == 4 * sizeof(void *));
+
+    CHECK(sizeof(MyList<int>) == 2 * sizeof(void *));
+    CHECK(sizeof(MyList<int, ArenaAllocator<ListNode<int>>>) == 3 * sizeof(void *));
+
+    CHECK(sizeof(My_Deque<int>) == sizeof(My_Deque<int, 0, ByteAllocator>));
+    CHECK(sizeof(My_Deque<int, 0, ArenaAllocator<int>>) == sizeof(My_Deque<int>) + sizeof(void *));
+}
+
+void checkVector(void)
+{
+    CountingArena arenaA, arenaB;
+    ArenaAllocator<int> allocA(arenaA), allocB(arenaB);
+
+    {
+        My_Vector<int, ArenaAllocator<int>> vecA(allocA);
+
+        for (int index = 0; index < 1000; ++index) { vecA.push_back(index); }
+
+        CHECK(arenaA.liveBytes() == vecA.capacity() * sizeof(int));
+        CHECK(vecA.get_allocator() == allocA);
+
+        /*拷贝构造沿用原来的分配器*/
+        My_Vector<int, ArenaAllocator<int>> copyA(vecA);
+        CHECK(copyA.get_allocator() == allocA && copyA.size() == 1000 && copyA[999] == 999);
+
+        /*分配器不相等、不传播：逐个移动，内存仍由各自的 arena 负责*/
+        My_Vector<int, ArenaAllocator<int>> vecB(allocB);
+        vecB = std::move(copyA);
+
+        CHECK(vecB.get_allocator() == allocB);
+        CHECK(vecB.size() == 1000 && vecB[500] == 500);
+        CHECK(arenaB.liveBytes() == vecB.capacity() * sizeof(int));
+
+        /*分配器相等：直接接管内存*/
+        My_Vector<int, ArenaAllocator<int>> moved(std::move(vecA));
+        CHECK(moved.size() == 1000 && vecA.size() == 0);
+    }
+
+    CHECK(arenaA.allocatedBytes > 0 && arenaA.liveBytes() == 0);
+    CHECK(arenaB.allocatedBytes > 0 && arenaB.liveBytes() == 0);
+
+    {
+        My_Vector<int, ByteAllocator> vec(100, 7);
+        CHECK(ByteAllocator::liveBytes == 100 * sizeof(int));
+    }
+
+    CHECK(ByteAllocator::liveBytes == 0);
+}
+
+void checkList(void)
 {
-    std::srand(std::time(nullptr));
+    CountingArena arenaA, arenaB;
+    ArenaAllocator<ListNode<std::string>> allocA(arenaA), allocB(arenaB);
+
+    {
+        MyList<std::string, ArenaAllocator<ListNode<std::string>>> listA(allocA);
+
+        for (int index = 0; index < 100; ++index) { listA.push_front(std::to_string(index)); }
+
+        CHECK(arenaA.liveBytes() == 101 * sizeof(ListNode<std::string>));     // 算上空白节点
+
+        listA.sort();
+        CHECK(listA.front() == "0" && listA.back() == "99");
+        CHECK(arenaA.liveBytes() == 101 * sizeof(ListNode<std::string>));
 
-    int * memPtr = Simple_Alloc<int, std::allocator<int>>::allocate(1000);
+        MyList<std::string, ArenaAllocator<ListNode<std::string>>> listB(allocB);
+        listB = listA;
+
+        CHECK(listB.size() == 100 && listB.get_allocator() == allocB);
+        CHECK(arenaB.liveBytes() == 101 * sizeof(ListNode<std::string>));
+
+        MyList<std::string, ArenaAllocator<ListNode<std::string>>> moved(std::move(listA));
+        CHECK(moved.size() == 100 && listA.empty());
+
+        listA.swap(moved);
+        CHECK(listA.size() == 100 && moved.empty());
+    }
+
+    CHECK(arenaA.liveBytes() == 0 && arenaB.liveBytes() == 0);
+}
+
+void checkDeque(void)
+{
+    CountingArena arenaA, arenaB;
+    ArenaAllocator<int> allocA(arenaA), allocB(arenaB);
 
-    for (int index = 0; index < 1000; ++index)
     {
-        memPtr[index] = std::rand() % 114 + 1;
+        My_Deque<int, 0, ArenaAllocator<int>> dequeA(allocA);
+
+        for (int index = 0; index < 5000; ++index)
+        {
+            dequeA.push_back(index);
+            dequeA.push_front(-index);
+        }
+
+        CHECK(dequeA.size() == 10000);
+        CHECK(arenaA.liveBytes() > 10000 * sizeof(int));
+
+        My_Deque<int, 0, ArenaAllocator<int>> dequeB(allocB);
+        dequeB = std::move(dequeA);
+
+        CHECK(dequeB.size() == 10000 && dequeB.get_allocator() == allocB);
+        CHECK(dequeB[0] == -4999 && dequeB[9999] == 4999);
+
+        My_Deque<int, 0, ArenaAllocator<int>> copyB(dequeB);
+        CHECK(copyB.get_allocator() == allocB && copyB.size() == 10000);
+
+        copyB.erase(copyB.begin() + 100, copyB.end() - 100);
+        CHECK(copyB.size() == 200);
     }
 
-    system("cls");
-    std::for_each(memPtr, memPtr + 1000, [](const int __n) { std::cout << __n << ' '; });
+    CHECK(arenaA.liveBytes() == 0 && arenaB.liveBytes() == 0);
+}
 
-    Simple_Alloc<int, std::allocator<int>>::deallocate(memPtr, 1000);
+int main(int argc, char const *argv[])
+{
+    checkContainerSize();
+    checkVector();
+    checkList();
+    checkDeque();
 
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+    return testResult();
+}
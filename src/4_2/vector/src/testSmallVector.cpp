@@ -0,0 +1,236 @@
+#include "../include/smallVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+    My_SmallVector 测试：
+    1. 元素不超过 N 个时不经过分配器，超出之后才在堆上分配，push_back / insert / reserve 的行为与 My_Vector 相同；
+    2. 拷贝、移动、交换在 “内联 / 堆上” 的各种组合下都正确，堆上的数组移动时直接接管；
+    3. shrink_to_fit() 在元素不超过 N 个时把元素搬回内联缓冲区并释放堆上的内存；
+    4. 非平凡元素（std::string、unique_ptr、计数对象）的构造与析构次数对得上；
+    5. 最后比较 “每个请求建一个约 12 个元素的小数组” 时 My_Vector 与 My_SmallVector<int, 16> 的耗时和分配次数。
+*/
+
+struct Counted
+{
+    static inline long live = 0;
+
+    std::string text;
+
+    Counted(std::string __text) : text(std::move(__text)) { ++live; }
+    Counted(const Counted & __other) : text(__other.text) { ++live; }
+    Counted(Counted && __other) noexcept : text(std::move(__other.text)) { ++live; }
+    Counted & operator=(const Counted &) = default;
+    Counted & operator=(Counted &&) = default;
+    ~Counted() { --live; }
+};
+
+template <typename Vector, typename Expected>
+bool equals(const Vector & __vec, const Expected & __expected)
+{
+    if (__vec.size() != __expected.size()) { return false; }
+
+    return std::equal(__vec.begin(), __vec.end(), __expected.begin());
+}
+
+void checkInlineStorage(void)
+{
+    using Alloc = CountingAllocator<int>;
+
+    Alloc::allocations = 0;
+
+    My_SmallVector<int, 8, Alloc> vec;
+    CHECK(vec.isInline() && vec.empty() && vec.capacity() == 8);
+
+    for (int index = 0; index < 7; ++index) { vec.push_back(index); }
+    vec.insert(vec.begin(), 100);
+    vec.erase(vec.begin());
+    vec.emplace_back(7);
+    vec.reserve(6);
+    CHECK(Alloc::allocations == 0 && vec.isInline());
+    CHECK(equals(vec, std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+
+    /*第 9 个元素：只分配一次*/
+    vec.push_back(8);
+    CHECK(Alloc::allocations == 1 && !vec.isInline() && vec.capacity() == 16);
+    CHECK(equals(vec, std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+    vec.append_range(std::vector<int>(100, 9));
+    CHECK(vec.size() == 109 && vec[108] == 9);
+
+    /*元素不超过 N 个时搬回内联缓冲区*/
+    vec.resize(5);
+    vec.shrink_to_fit();
+    CHECK(vec.isInline() && vec.capacity() == 8 && Alloc::liveBytes == 0);
+    CHECK(equals(vec, std::vector<int>{0, 1, 2, 3, 4}));
+
+    /*超过 N 个时与 My_Vector 相同*/
+    My_SmallVector<int, 4, Alloc> big(10, 3);
+    big.reserve(100);
+    big.shrink_to_fit();
+    CHECK(!big.isInline() && big.capacity() == 10 && big[9] == 3);
+
+    My_SmallVector<int, 4, Alloc> fromList{1, 2, 3};
+    My_SmallVector<int, 4, Alloc> fromRange(fromList.begin(), fromList.end());
+    My_SmallVector<int, 4, Alloc> sized(3);
+    CHECK(fromRange.isInline() && equals(fromRange, std::vector<int>{1, 2, 3}));
+    CHECK(sized.isInline() && equals(sized, std::vector<int>{0, 0, 0}));
+}
+
+void checkCopyAndMove(void)
+{
+    using Alloc = CountingAllocator<std::string>;
+
+    My_SmallVector<std::string, 4, Alloc> small{"a", "b"};
+    My_SmallVector<std::string, 4, Alloc> large{"1", "2", "3", "4", "5", "6"};
+
+    /*拷贝*/
+    My_SmallVector<std::string, 4, Alloc> smallCopy(small);
+    My_SmallVector<std::string, 4, Alloc> largeCopy(large);
+    CHECK(smallCopy.isInline() && equals(smallCopy, small));
+    CHECK(!largeCopy.isInline() && equals(largeCopy, large));
+
+    smallCopy = large;
+    largeCopy = small;
+    CHECK(equals(smallCopy, large) && equals(largeCopy, small));
+
+    /*移动：内联的元素逐个移动，堆上的数组直接接管*/
+    const std::string * largeData = large.data();
+
+    My_SmallVector<std::string, 4, Alloc> movedSmall(std::move(small));
+    My_SmallVector<std::string, 4, Alloc> movedLarge(std::move(large));
+    CHECK(movedSmall.isInline() && equals(movedSmall, std::vector<std::string>{"a", "b"}));
+    CHECK(movedLarge.data() == largeData && movedLarge.size() == 6);
+    CHECK(small.empty() && large.empty() && large.isInline());
+
+    /*被移走之后仍然可以正常使用*/
+    large.push_back("x");
+    CHECK(large.isInline() && large[0] == "x");
+
+    movedSmall = std::move(movedLarge);
+    CHECK(movedSmall.data() == largeData && movedLarge.empty() && movedLarge.isInline());
+
+    movedLarge = {"p", "q"};
+    movedSmall = std::move(movedLarge);
+    CHECK(movedSmall.isInline() && equals(movedSmall, std::vector<std::string>{"p", "q"}));
+
+    /*交换：内联与内联、内联与堆上、堆上与堆上*/
+    My_SmallVector<std::string, 4, Alloc> first{"f"};
+    My_SmallVector<std::string, 4, Alloc> second{"s", "t"};
+    My_SmallVector<std::string, 4, Alloc> third{"0", "1", "2", "3", "4"};
+    My_SmallVector<std::string, 4, Alloc> fourth{"5", "6", "7", "8", "9", "10"};
+
+    first.swap(second);
+    CHECK(equals(first, std::vector<std::string>{"s", "t"}) && equals(second, std::vector<std::string>{"f"}));
+
+    first.swap(third);
+    CHECK(equals(first, std::vector<std::string>{"0", "1", "2", "3", "4"}) && !first.isInline());
+    CHECK(equals(third, std::vector<std::string>{"s", "t"}) && third.isInline());
+
+    const std::string * firstData  = first.data();
+    const std::string * fourthData = fourth.data();
+
+    first.swap(fourth);
+    CHECK(first.data() == fourthData && fourth.data() == firstData);
+
+    first.swap(first);
+    CHECK(first.size() == 6);
+}
+
+void checkLifetimes(void)
+{
+    {
+        My_SmallVector<Counted, 3> vec;
+
+        vec.emplace_back("a");
+        vec.emplace_back("b");
+        vec.emplace(vec.begin(), "c");
+        CHECK(Counted::live == 3 && vec.isInline());
+
+        vec.emplace_back("d");
+        CHECK(Counted::live == 4 && !vec.isInline());
+
+        vec.erase(vec.begin());
+        vec.shrink_to_fit();
+        CHECK(Counted::live == 3 && vec.isInline() && vec[2].text == "d");
+
+        My_SmallVector<Counted, 3> other(std::move(vec));
+        CHECK(Counted::live == 3 && vec.empty());
+
+        vec = other;
+        CHECK(Counted::live == 6);
+    }
+
+    CHECK(Counted::live == 0);
+
+    My_SmallVector<std::unique_ptr<int>, 2> pointers;
+    for (int index = 0; index < 5; ++index) { pointers.push_back(std::make_unique<int>(index)); }
+
+    pointers.erase(pointers.begin() + 1, pointers.end() - 1);
+    pointers.shrink_to_fit();
+    CHECK(pointers.isInline() && *pointers[0] == 0 && *pointers[1] == 4);
+
+    My_SmallVector<std::unique_ptr<int>, 2> movedPointers(std::move(pointers));
+    CHECK(*movedPointers[1] == 4 && pointers.empty());
+}
+
+void compareSpeed(void)
+{
+    constexpr int REQUESTS = 2000000;
+    constexpr int ELEMENTS = 12;
+
+    using Alloc = CountingAllocator<int>;
+
+    long checksum = 0;
+
+    Alloc::allocations = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int request = 0; request < REQUESTS; ++request)
+    {
+        My_Vector<int, Alloc> vec;
+        for (int index = 0; index < ELEMENTS; ++index) { vec.push_back(request + index); }
+
+        checksum += vec.back();
+    }
+
+    std::chrono::duration<double, std::nano> vectorTime = std::chrono::steady_clock::now() - startTime;
+    std::size_t vectorAllocations = Alloc::allocations;
+
+    Alloc::allocations = 0;
+    startTime = std::chrono::steady_clock::now();
+
+    for (int request = 0; request < REQUESTS; ++request)
+    {
+        My_SmallVector<int, 16, Alloc> vec;
+        for (int index = 0; index < ELEMENTS; ++index) { vec.push_back(request + index); }
+
+        checksum -= vec.back();
+    }
+
+    std::chrono::duration<double, std::nano> smallTime = std::chrono::steady_clock::now() - startTime;
+
+    CHECK(checksum == 0 && Alloc::allocations == 0);
+
+    printf("build %d-element arrays  My_Vector : %.1f ns/request, %.2f allocations/request;  "
+           "My_SmallVector<int, 16> : %.1f ns/request, %.2f allocations/request\n",
+           ELEMENTS, vectorTime.count() / REQUESTS, double(vectorAllocations) / REQUESTS,
+           smallTime.count() / REQUESTS, double(Alloc::allocations) / REQUESTS);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkInlineStorage();
+    checkCopyAndMove();
+    CHECK(CountingAllocator<std::string>::liveBytes == 0);
+    checkLifetimes();
+    compareSpeed();
+
+    return testResult();
+}
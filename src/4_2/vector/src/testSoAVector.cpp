@@ -0,0 +1,249 @@
+#include "../include/soaVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+/*
+    My_SoAVector 测试：
+    1. emplace_back、push_back、operator[]、结构化绑定、field<I>() 的 span、迭代器配合标准算法，
+       erase、resize、reserve、shrink_to_fit、拷贝、移动之后内容正确，每个字段都是连续的数组；
+    2. 添加一行时某个字段构建失败、扩容时拷贝失败，容器保持不变，不泄漏任何元素和内存；
+    3. 最后比较 My_Vector<Particle> 与 My_SoAVector 在只读写一两个字段的扫描上的耗时。
+*/
+
+/**
+ * @brief 记录存活个数，第 failAt 次拷贝构造时抛出异常。
+*/
+struct Tracked
+{
+    static inline long live   = 0;
+    static inline long copies = 0;
+    static inline long failAt = -1;
+
+    int value;
+
+    Tracked(int __value = 0) : value(__value) { ++live; }
+
+    Tracked(const Tracked & __other) : value(__other.value)
+    {
+        if (copies++ == failAt) { throw std::runtime_error("copy failed"); }
+        ++live;
+    }
+
+    ~Tracked() { --live; }
+};
+
+void checkBasics(void)
+{
+    My_SoAVector<int, double, std::string> vec;
+    CHECK(vec.empty() && vec.capacity() == 0);
+
+    for (int index = 0; index < 1000; ++index) { vec.emplace_back(index, index * 0.5, std::to_string(index)); }
+    vec.push_back({1000, 500.0, "1000"});
+
+    CHECK(vec.size() == 1001 && vec.capacity() >= 1001);
+
+    /*按行访问：代理引用可以读写*/
+    auto [id, weight, name] = vec[10];
+    CHECK(id == 10 && weight == 5.0 && name == "10");
+
+    std::get<0>(vec[10]) = -10;
+    CHECK(std::get<0>(vec.at(10)) == -10 && std::get<2>(vec.back()) == "1000");
+
+    bool thrown = false;
+    try { vec.at(1001); }
+    catch (const std::out_of_range &) { thrown = true; }
+    CHECK(thrown);
+
+    /*按字段访问：每个字段都是一个连续的数组*/
+    std::span<double> weights = vec.field<1>();
+    CHECK(weights.size() == 1001 && weights.data() == vec.data<1>() && &weights[7] == &std::get<1>(vec[7]));
+    CHECK(std::accumulate(weights.begin(), weights.end(), 0.0) == 1000 * 1001 / 4.0);
+
+    /*迭代器与标准算法*/
+    for (auto && [rowId, rowWeight, rowName] : vec) { rowWeight *= 2; }
+    CHECK(vec.field<1>()[999] == 999.0);
+
+    auto found = std::find_if(vec.begin(), vec.end(), [](const auto & __row) { return std::get<2>(__row) == "500"; });
+    CHECK(found - vec.begin() == 500 && found.field<0>() == 500);
+    CHECK(std::count_if(vec.cbegin(), vec.cend(), [](const auto & __row) { return std::get<0>(__row) % 2 == 0; }) == 501);
+
+    /*erase、resize、reserve、shrink_to_fit*/
+    auto next = vec.erase(vec.begin() + 1, vec.begin() + 11);
+    CHECK(vec.size() == 991 && next.field<0>() == 11 && std::get<2>(vec[1]) == "11");
+
+    vec.erase(vec.begin());
+    CHECK(std::get<0>(vec.front()) == 11);
+
+    vec.resize(5);
+    vec.resize(7, {7, 7.5, "seven"});
+    vec.resize(8);
+    CHECK(vec.size() == 8 && std::get<2>(vec[6]) == "seven" && std::get<0>(vec[7]) == 0 && std::get<2>(vec[7]).empty());
+
+    vec.shrink_to_fit();
+    CHECK(vec.capacity() == 8 && std::get<1>(vec[0]) == 11.0);
+
+    vec.reserve(100);
+    CHECK(vec.capacity() == 100 && std::get<2>(vec[4]) == "15");
+
+    /*拷贝与移动*/
+    My_SoAVector<int, double, std::string> copied(vec);
+    CHECK(copied.size() == 8 && copied.capacity() == 8 && std::get<2>(copied[6]) == "seven" && copied.data<2>() != vec.data<2>());
+
+    My_SoAVector<int, double, std::string> moved(std::move(copied));
+    CHECK(moved.size() == 8 && copied.empty() && copied.data<0>() == nullptr);
+
+    copied = moved;
+    moved.clear();
+    moved = std::move(copied);
+    CHECK(moved.size() == 8 && std::get<2>(moved[6]) == "seven");
+
+    moved.swap(vec);
+    moved.pop_back();
+    CHECK(moved.size() == 7 && vec.size() == 8);
+
+    My_SoAVector<char, long> initialized{{'a', 1}, {'b', 2}, {'c', 3}};
+    CHECK(initialized.size() == 3 && initialized.field<0>()[2] == 'c' && initialized.field<1>()[1] == 2);
+}
+
+void checkExceptionSafety(void)
+{
+    using Vector = My_BasicSoAVector<CountingAllocator<char>, doublingGrowth, int, std::string, Tracked>;
+
+    {
+        Vector vec;
+        vec.reserve(4);
+
+        for (int index = 0; index < 4; ++index) { vec.emplace_back(index, std::to_string(index), Tracked(index)); }
+
+        /*原地添加：最后一个字段拷贝失败，前两个字段被析构*/
+        Tracked prototype(9);
+
+        Tracked::copies = 0;
+        Tracked::failAt = 0;
+
+        bool thrown = false;
+        try { vec.emplace_back(9, "nine", prototype); }
+        catch (const std::runtime_error &) { thrown = true; }
+
+        CHECK(thrown && vec.size() == 4 && Tracked::live == 5);
+
+        /*扩容：Tracked 的移动可能抛出异常，只能拷贝，拷贝到一半失败时容器保持不变*/
+        Tracked::copies = 0;
+        Tracked::failAt = 2;
+        thrown = false;
+
+        try { vec.emplace_back(4, "four", prototype); }
+        catch (const std::runtime_error &) { thrown = true; }
+
+        CHECK(thrown && vec.size() == 4 && vec.capacity() == 4 && Tracked::live == 5);
+        CHECK(std::get<1>(vec[3]) == "3" && std::get<2>(vec[3]).value == 3);
+
+        Tracked::failAt = -1;
+
+        /*参数引用的是本容器中的元素，扩容之后仍然正确*/
+        vec.push_back(vec[1]);
+        CHECK(vec.size() == 5 && std::get<1>(vec[4]) == "1" && std::get<2>(vec[4]).value == 1);
+    }
+
+    CHECK(Tracked::live == 0 && CountingAllocator<char>::liveBytes == 0);
+}
+
+/**
+ * @brief 基准用的粒子，热循环只用到其中一两个字段。
+*/
+struct Particle
+{
+    float   x, y, z;
+    float   vx, vy, vz;
+    float   mass;
+    int     id;
+    double  charge;
+    char    name[24];
+};
+
+/*防止编译器把整个循环优化掉*/
+volatile double sink = 0;
+
+template <typename Scan>
+double measure(Scan __scan, int __rounds)
+{
+    double total = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < __rounds; ++round) { total += __scan(); }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+    sink = total;
+
+    return elapsed.count() / __rounds;
+}
+
+void compareScans(void)
+{
+    constexpr std::size_t COUNT  = 1 << 22;
+    constexpr int         ROUNDS = 10;
+
+    My_Vector<Particle> aos;
+    My_SoAVector<float, float, float, float, float, float, float, int, double, std::array<char, 24>> soa;
+
+    aos.reserve(COUNT);
+    soa.reserve(COUNT);
+
+    for (std::size_t index = 0; index < COUNT; ++index)
+    {
+        const float value = float(index % 1000);
+        aos.push_back(Particle{value, value, value, 1, 2, 3, value * 0.25f, int(index), 1.0, {}});
+        soa.emplace_back(value, value, value, 1.f, 2.f, 3.f, value * 0.25f, int(index), 1.0, std::array<char, 24>{});
+    }
+
+    /*只读一个字段：总质量*/
+    double aosSum = measure([&] {
+        float sum = 0;
+        for (const Particle & particle : aos) { sum += particle.mass; }
+        return double(sum);
+    }, ROUNDS);
+
+    double soaSum = measure([&] {
+        float sum = 0;
+        for (float mass : soa.field<6>()) { sum += mass; }
+        return double(sum);
+    }, ROUNDS);
+
+    /*读写两个字段：x += vx*/
+    double aosUpdate = measure([&] {
+        for (Particle & particle : aos) { particle.x += particle.vx; }
+        return double(aos[COUNT - 1].x);
+    }, ROUNDS);
+
+    double soaUpdate = measure([&] {
+        float * x        = soa.data<0>();
+        const float * vx = soa.data<3>();
+        const std::size_t size = soa.size();
+
+        for (std::size_t index = 0; index < size; ++index) { x[index] += vx[index]; }
+        return double(x[COUNT - 1]);
+    }, ROUNDS);
+
+    CHECK(aos[COUNT - 1].x == soa.field<0>()[COUNT - 1] && aos[12].mass == std::get<6>(soa[12]));
+
+    printf("%zu particles (%zu bytes each)  sum one field : My_Vector %.2f ms, My_SoAVector %.2f ms;  "
+           "x += vx : My_Vector %.2f ms, My_SoAVector %.2f ms\n",
+           COUNT, sizeof(Particle), aosSum, soaSum, aosUpdate, soaUpdate);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkBasics();
+    checkExceptionSafety();
+    compareScans();
+
+    return testResult();
+}
@@ -0,0 +1,168 @@
+#define __VECTOR_CHECKED_ 1
+
+#include "../include/smallVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+/*
+    检查模式（__VECTOR_CHECKED_ 为 1）测试，检查失败时的处理函数换成抛出异常，以便逐项确认：
+    1. operator[] 越界、对空 vector 调用 front() / back() / pop_back() 被发现；
+    2. 扩容、reserve、shrink_to_fit 之后使用旧迭代器，解引用 end()、迭代器移出 [begin(), end()] 被发现；
+    3. 把别的 vector 的迭代器传给 insert() / erase() 被发现；
+    4. 正常的用法（遍历、标准算法、用 insert() / erase() 的返回值继续迭代）不会误报。
+*/
+
+struct CheckFailure : std::logic_error
+{
+    using std::logic_error::logic_error;
+};
+
+void throwOnCheckFailure(const char * __message) { throw CheckFailure(__message); }
+
+/**
+ * @brief __operation 触发了检查失败，并且失败原因包含 __reason。
+*/
+template <typename Operation>
+bool detects(Operation __operation, const std::string & __reason)
+{
+    try { __operation(); }
+    catch (const CheckFailure & failure) { return std::string(failure.what()).find(__reason) != std::string::npos; }
+
+    return false;
+}
+
+void checkBounds(void)
+{
+    My_Vector<int> vec{1, 2, 3};
+    My_Vector<int> empty;
+    const My_Vector<int> & constVec = vec;
+
+    CHECK(detects([&] { vec[3] = 0; }, "out of range"));
+    CHECK(detects([&] { return constVec[100]; }, "out of range"));
+    CHECK(detects([&] { return empty.front(); }, "empty"));
+    CHECK(detects([&] { return empty.back(); }, "empty"));
+    CHECK(detects([&] { empty.pop_back(); }, "empty"));
+
+    CHECK(vec[2] == 3 && vec.back() == 3 && constVec.front() == 1);
+
+    /*at() 仍然抛出 std::out_of_range*/
+    bool outOfRange = false;
+    try { vec.at(3); }
+    catch (const std::out_of_range &) { outOfRange = true; }
+    CHECK(outOfRange);
+}
+
+void checkInvalidation(void)
+{
+    My_Vector<std::string> vec{"a", "b", "c"};
+
+    My_Vector<std::string>::iterator first = vec.begin();
+    CHECK(*first == "a");
+
+    vec.reserve(100);
+    CHECK(detects([&] { return *first; }, "reallocation"));
+
+    /*在容量以内的插入不会重新分配*/
+    first = vec.begin();
+    vec.push_back("d");
+    CHECK(*first == "a");
+
+    vec.shrink_to_fit();
+    CHECK(detects([&] { ++first; }, "reallocation"));
+
+    My_Vector<std::string>::iterator last = vec.end();
+    CHECK(detects([&] { return *last; }, "out of range"));
+    CHECK(detects([&] { ++last; }, "out of range"));
+    CHECK(detects([&] { return vec.begin() - 1; }, "out of range"));
+    CHECK(detects([&] { return vec.begin()[4]; }, "out of range"));
+
+    /*push_back 扩容之后，之前的迭代器也失效*/
+    My_Vector<int> ints;
+    ints.push_back(1);
+    My_Vector<int>::constIterator element = ints.cbegin();
+    ints.push_back(2);
+    CHECK(detects([&] { return *element; }, "reallocation"));
+
+    /*erase 之后超出新 end() 的位置*/
+    My_Vector<int> numbers{1, 2, 3, 4};
+    My_Vector<int>::iterator fourth = numbers.begin() + 3;
+    numbers.erase(numbers.begin());
+    CHECK(detects([&] { return *fourth; }, "out of range"));
+
+    /*My_SmallVector 从内联缓冲区搬到堆上同样算重新分配*/
+    My_SmallVector<int, 2> small{1, 2};
+    My_SmallVector<int, 2>::iterator inlineElement = small.begin();
+    small.push_back(3);
+    CHECK(detects([&] { return *inlineElement; }, "reallocation"));
+}
+
+void checkOwnership(void)
+{
+    My_Vector<int> vec{1, 2, 3};
+    My_Vector<int> other{4, 5, 6};
+
+    CHECK(detects([&] { vec.erase(other.begin()); }, "does not belong"));
+    CHECK(detects([&] { vec.insert(other.begin(), 7); }, "does not belong"));
+    CHECK(detects([&] { vec.erase(vec.begin(), other.end()); }, "does not belong"));
+    CHECK(detects([&] { return vec.begin() == other.begin(); }, "different vectors"));
+    CHECK(detects([&] { return vec.cbegin() < other.end(); }, "different vectors"));
+    CHECK(detects([&] { return vec.end() - other.cbegin(); }, "different vectors"));
+    CHECK(detects([&] { vec.erase(vec.end()); }, "end()"));
+    CHECK(detects([&] { vec.erase(vec.end(), vec.begin()); }, "invalid range"));
+
+    CHECK(vec.size() == 3 && other.size() == 3);
+}
+
+void checkValidUse(void)
+{
+    My_Vector<int> vec;
+    for (int index = 0; index < 100; ++index) { vec.push_back(99 - index); }
+
+    std::sort(vec.begin(), vec.end());
+    CHECK(std::is_sorted(vec.cbegin(), vec.cend()) && vec.front() == 0);
+    CHECK(std::accumulate(vec.begin(), vec.end(), 0) == 4950);
+    CHECK(std::find(vec.rbegin(), vec.rend(), 50) != vec.rend());
+
+    /*用 erase() 的返回值继续迭代，删除所有偶数*/
+    for (My_Vector<int>::iterator iter = vec.begin(); iter != vec.end(); )
+    {
+        if (*iter % 2 == 0) { iter = vec.erase(iter); }
+        else { ++iter; }
+    }
+
+    CHECK(vec.size() == 50 && vec[0] == 1 && vec[49] == 99);
+
+    /*insert() 可能扩容，返回的迭代器指向新数组*/
+    vec.insert(vec.begin() + 10, 1000, -1);
+    My_Vector<int>::iterator next = vec.insert(vec.end(), {7, 8});
+    CHECK(*next == 7 && next[1] == 8);
+
+    My_Vector<int>::iterator inserted = vec.begin() + 10;
+    CHECK(*inserted == -1 && *(inserted + 999) == -1 && *(inserted + 1000) == 21);
+
+    My_Vector<int>::constIterator constIter = vec.begin();
+    CHECK(constIter == vec.cbegin() && std::size_t(vec.cend() - constIter) == vec.size());
+
+    /*iterator 与 constIterator 混用：比较、相减不需要先转换*/
+    CHECK(vec.begin() == vec.cbegin() && vec.cbegin() == vec.begin() && vec.end() != vec.cbegin());
+    CHECK(vec.begin() < vec.cend() && vec.cend() > vec.begin() && vec.cbegin() <= vec.begin() && vec.end() >= vec.cend());
+    CHECK(std::size_t(vec.end() - vec.cbegin()) == vec.size() && vec.cbegin() - vec.end() == -std::ptrdiff_t(vec.size()));
+}
+
+int main(int argc, char const *argv[])
+{
+    setVectorCheckHandler(throwOnCheckFailure);
+
+    checkBounds();
+    checkInvalidation();
+    checkOwnership();
+    checkValidUse();
+
+    return testResult();
+}
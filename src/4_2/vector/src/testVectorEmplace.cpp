@@ -0,0 +1,231 @@
+#include "../include/myVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+    移动语义与 emplace 测试：
+    1. emplace_back / emplace 原地构建元素，push_back(Type &&) 移动而不拷贝；
+    2. 扩容时移动构造不抛异常的元素被移动过去，可能抛异常的元素退而拷贝；
+    3. 扩容中途抛出异常时，vector 的内容、容量都保持不变（强异常安全保证），不可拷贝的元素也能使用；
+    4. 插入的值引用 vector 自身的元素时，扩容之后仍然插入正确的值；
+    5. 最后统计往 vector 中放入大量长字符串时 operator new 的调用次数和耗时，
+       对比移动（noexcept）与拷贝（移动构造可能抛异常）两种扩容方式。
+*/
+
+/*统计全局 operator new 的调用次数*/
+static std::size_t newCount = 0;
+
+void * operator new(std::size_t __bytes)
+{
+    ++newCount;
+
+    if (void * block = std::malloc(__bytes)) { return block; }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void * __ptr) noexcept { std::free(__ptr); }
+void operator delete(void * __ptr, std::size_t) noexcept { std::free(__ptr); }
+
+/**
+ * @brief 记录拷贝、移动次数的元素，可以指定在第几次拷贝时抛出异常。
+*/
+struct Tracked
+{
+    static inline int copies    = 0;
+    static inline int moves     = 0;
+    static inline int throwAt   = -1;     // 第 throwAt 次拷贝时抛出异常，-1 表示不抛出
+
+    int value;
+
+    Tracked(int __value) : value(__value) {}
+
+    Tracked(const Tracked & __other) : value(__other.value)
+    {
+        if (copies++ == throwAt) { throw std::runtime_error("copy failed"); }
+    }
+
+    Tracked(Tracked && __other) noexcept : value(__other.value) { ++moves; __other.value = -1; }
+
+    Tracked & operator=(const Tracked & __other) { value = __other.value; ++copies; return *this; }
+    Tracked & operator=(Tracked && __other) noexcept { value = __other.value; ++moves; __other.value = -1; return *this; }
+
+    static void resetCounters(void) { copies = moves = 0; throwAt = -1; }
+};
+
+/**
+ * @brief 移动构造可能抛出异常的字符串，vector 扩容时只能拷贝它。
+*/
+struct ThrowingMoveString
+{
+    std::string text;
+
+    ThrowingMoveString(std::string __text) : text(std::move(__text)) {}
+    ThrowingMoveString(const ThrowingMoveString &) = default;
+    ThrowingMoveString(ThrowingMoveString && __other) : text(std::move(__other.text)) {}
+
+    ThrowingMoveString & operator=(const ThrowingMoveString &) = default;
+    ThrowingMoveString & operator=(ThrowingMoveString &&) = default;
+};
+
+struct Point
+{
+    int x, y;
+
+    Point(int __x, int __y) : x(__x), y(__y) {}
+};
+
+void checkEmplace(void)
+{
+    My_Vector<Point> points;
+
+    Point & first = points.emplace_back(1, 2);
+    CHECK(first.x == 1 && first.y == 2);
+
+    points.emplace_back(5, 6);
+    auto pos = points.emplace(points.begin() + 1, 3, 4);
+    CHECK(pos == points.begin() + 1 && points.size() == 3);
+    CHECK(points[0].x == 1 && points[1].x == 3 && points[2].x == 5);
+
+    My_Vector<std::string> strings;
+    std::string text(100, 'a');
+
+    strings.push_back(std::move(text));
+    CHECK(strings[0].size() == 100 && text.empty());
+
+    strings.insert(strings.begin(), std::string(50, 'b'));
+    CHECK(strings[0].size() == 50 && strings[1].size() == 100);
+
+    strings.emplace(strings.end(), 3, 'c');
+    CHECK(strings.back() == "ccc");
+}
+
+void checkGrowthMoves(void)
+{
+    Tracked::resetCounters();
+
+    My_Vector<Tracked> vec;
+    for (int index = 0; index < 1000; ++index) { vec.emplace_back(index); }
+
+    CHECK(Tracked::copies == 0);
+    CHECK(Tracked::moves > 0);
+    CHECK(vec[0].value == 0 && vec[999].value == 999);
+
+    /*中间插入和删除也只移动*/
+    Tracked::resetCounters();
+    vec.emplace(vec.begin(), -5);
+    vec.erase(vec.begin() + 10, vec.begin() + 20);
+    vec.erase(vec.begin());
+    CHECK(Tracked::copies == 0);
+    CHECK(vec.size() == 990 && vec[0].value == 0 && vec[8].value == 8 && vec[9].value == 19);
+}
+
+void checkStrongGuarantee(void)
+{
+    My_Vector<ThrowingMoveString> vec;
+
+    for (int index = 0; index < 8; ++index) { vec.emplace_back(std::string(40, char('a' + index))); }
+    CHECK(vec.size() == vec.capacity());
+
+    /*new 元素构建时抛出异常：内容和容量都不变*/
+    const ThrowingMoveString * data = &vec[0];
+
+    try
+    {
+        vec.emplace(vec.begin() + 3, std::string(std::string().max_size(), 'x'));
+        CHECK(false);
+    }
+    catch (const std::exception &) {}
+
+    CHECK(vec.size() == 8 && vec.capacity() == 8 && &vec[0] == data);
+    CHECK(vec[3].text == std::string(40, 'd'));
+
+    /*搬移元素时拷贝抛出异常：同样保持不变*/
+    struct CopyOnly
+    {
+        Tracked inner;
+
+        CopyOnly(int __value) : inner(__value) {}
+        CopyOnly(const CopyOnly &) = default;
+    };
+
+    My_Vector<CopyOnly> copyOnly;
+    for (int index = 0; index < 4; ++index) { copyOnly.emplace_back(index); }
+    CHECK(copyOnly.size() == copyOnly.capacity());
+
+    Tracked::resetCounters();
+    Tracked::throwAt = 2;
+
+    try
+    {
+        copyOnly.emplace_back(4);
+        CHECK(false);
+    }
+    catch (const std::runtime_error &) {}
+
+    Tracked::throwAt = -1;
+    CHECK(copyOnly.size() == 4 && copyOnly.capacity() == 4);
+    CHECK(copyOnly[0].inner.value == 0 && copyOnly[3].inner.value == 3);
+
+    /*不可拷贝的元素*/
+    My_Vector<std::unique_ptr<int>> owners;
+    for (int index = 0; index < 100; ++index) { owners.push_back(std::make_unique<int>(index)); }
+    owners.emplace(owners.begin(), new int(-1));
+    owners.erase(owners.begin() + 1);
+    CHECK(owners.size() == 100 && *owners[0] == -1 && *owners[99] == 99);
+}
+
+void checkAliasing(void)
+{
+    My_Vector<std::string> strings;
+    for (int index = 0; index < 4; ++index) { strings.push_back(std::string(30, char('a' + index))); }
+    CHECK(strings.size() == strings.capacity());
+
+    strings.push_back(strings[0]);
+    CHECK(strings[4] == std::string(30, 'a') && strings[0] == strings[4]);
+
+    strings.insert(strings.begin(), strings[2]);
+    CHECK(strings[0] == std::string(30, 'c') && strings[3] == strings[0]);
+
+    strings.insert(strings.begin() + 1, 20, strings[1]);
+    CHECK(strings.size() == 26 && strings[1] == std::string(30, 'a') && strings[20] == strings[1]);
+}
+
+template <typename Element>
+void fillStrings(const char * __label, std::size_t __count)
+{
+    const std::string text(64, 'x');     // 超出短字符串优化的长度，每个副本都要分配一次内存
+
+    newCount = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    {
+        My_Vector<Element> vec;
+        for (std::size_t index = 0; index < __count; ++index) { vec.emplace_back(text); }
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    printf("%-28s %zu strings : %8zu operator new calls (%.2f per string), %.2f ns/string\n",
+           __label, __count, newCount, double(newCount) / __count, elapsed.count() / __count);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkEmplace();
+    checkGrowthMoves();
+    checkStrongGuarantee();
+    checkAliasing();
+
+    fillStrings<std::string>("move on growth (noexcept)", 1000000);
+    fillStrings<ThrowingMoveString>("copy on growth (may throw)", 1000000);
+
+    return testResult();
+}
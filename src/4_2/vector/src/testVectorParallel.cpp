@@ -0,0 +1,173 @@
+#include "../include/myVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+/*
+    并行构建测试：
+    1. My_Vector(n, x, parallelInit)、My_Vector(n, parallelInit)、resize(n, x, parallelInit) 的结果与串行构建相同，
+       并且确实由指定个数的线程构建；
+    2. 某个线程构建失败时，所有已经构建的元素都被析构、新分配的内存被释放，resize 之前的元素保持不变；
+    3. 最后比较串行与 1、2、4、8 个线程构建 64M 个 int（256 MiB）的耗时。
+*/
+
+/**
+ * @brief 记录存活个数与构建它的线程，第 failAt 次拷贝构造时抛出异常。
+*/
+struct Tracked
+{
+    static inline std::atomic<long> live{0};
+    static inline std::atomic<long> copies{0};
+    static inline long              failAt = -1;
+
+    static inline std::mutex            threadsLock;
+    static inline std::set<std::thread::id> threads;
+
+    int value;
+
+    explicit Tracked(int __value = 0) : value(__value) { ++live; }
+
+    Tracked(const Tracked & __other) : value(__other.value)
+    {
+        if (copies++ == failAt) { throw std::runtime_error("copy failed"); }
+
+        ++live;
+
+        std::lock_guard<std::mutex> lock(threadsLock);
+        threads.insert(std::this_thread::get_id());
+    }
+
+    ~Tracked() { --live; }
+};
+
+void checkResults(void)
+{
+    __ParallelInit fourThreads{4, 0};
+
+    My_Vector<int> filled(1000000, 7, fourThreads);
+    bool allSeven = filled.size() == 1000000 && filled.capacity() == 1000000;
+    for (int value : filled) { allSeven = allSeven && value == 7; }
+    CHECK(allSeven);
+
+    My_Vector<long> zeros(300000, fourThreads);
+    bool allZero = zeros.size() == 300000;
+    for (long value : zeros) { allZero = allZero && value == 0; }
+    CHECK(allZero);
+
+    /*resize：x 是本 vector 的元素，原有的元素保持不变*/
+    My_Vector<std::string> strings{"a", "b"};
+    strings.resize(200000, strings[1], fourThreads);
+    CHECK(strings.size() == 200000 && strings[0] == "a" && strings[1] == "b" && strings[199999] == "b");
+
+    strings.resize(5, "ignored", fourThreads);
+    CHECK(strings.size() == 5 && strings[4] == "b");
+
+    /*区间太小时不并行*/
+    My_Vector<int> small(10, 3, parallelInit);
+    CHECK(small.size() == 10 && small[9] == 3);
+
+    /*确实使用了 4 个线程*/
+    {
+        Tracked prototype(5);
+
+        Tracked::threads.clear();
+        My_Vector<Tracked> tracked(100000, prototype, fourThreads);
+
+        CHECK(Tracked::threads.size() == 4);
+        CHECK(tracked.size() == 100000 && tracked[99999].value == 5 && Tracked::live == 100001);
+    }
+
+    CHECK(Tracked::live == 0);
+}
+
+void checkExceptionSafety(void)
+{
+    using Alloc = CountingAllocator<Tracked>;
+
+    __ParallelInit fourThreads{4, 0};
+
+    {
+        Tracked prototype(1);
+
+        /*构造函数失败：不留下任何元素和内存*/
+        Tracked::copies = 0;
+        Tracked::failAt = 70000;
+
+        bool thrown = false;
+
+        try { My_Vector<Tracked, Alloc> vec(100000, prototype, fourThreads); }
+        catch (const std::runtime_error &) { thrown = true; }
+
+        CHECK(thrown && Tracked::live == 1 && Alloc::liveBytes == 0);
+
+        /*resize 失败：新增的元素全部析构，原有的元素保持不变*/
+        My_Vector<Tracked, Alloc> vec(10, prototype);
+
+        Tracked::copies = 0;
+        Tracked::failAt = 123456;
+        thrown = false;
+
+        try { vec.resize(200000, prototype, fourThreads); }
+        catch (const std::runtime_error &) { thrown = true; }
+
+        CHECK(thrown && vec.size() == 10 && Tracked::live == 11);
+
+        Tracked::failAt = -1;
+    }
+
+    CHECK(Tracked::live == 0 && Alloc::liveBytes == 0);
+}
+
+void compareSpeed(void)
+{
+    constexpr std::size_t COUNT = 64 * 1024 * 1024;
+
+    auto timeBuild = [](__ParallelInit __policy, bool __parallel) {
+        auto startTime = std::chrono::steady_clock::now();
+
+        long checksum;
+
+        if (__parallel)
+        {
+            My_Vector<int> vec(COUNT, 1, __policy);
+            checksum = vec[COUNT / 2] + vec[COUNT - 1];
+        }
+        else
+        {
+            My_Vector<int> vec(COUNT, 1);
+            checksum = vec[COUNT / 2] + vec[COUNT - 1];
+        }
+
+        CHECK(checksum == 2);
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        return elapsed.count();
+    };
+
+    printf("build %zu ints (%u hardware threads)  serial : %.1f ms", COUNT, std::thread::hardware_concurrency(), timeBuild({}, false));
+
+    for (unsigned threads : {1u, 2u, 4u, 8u})
+    {
+        printf(", %u thread(s) : %.1f ms", threads, timeBuild(__ParallelInit{threads}, true));
+    }
+
+    printf("\n");
+}
+
+int main(int argc, char const *argv[])
+{
+    checkResults();
+    checkExceptionSafety();
+    compareSpeed();
+
+    return testResult();
+}
@@ -0,0 +1,202 @@
+#include "../include/myVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <forward_list>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+    区间操作测试：
+    1. insert(pos, first, last) 对前向迭代器最多分配一次内存，空间足够时不分配；
+    2. 单趟的输入迭代器（istream_iterator）插入到中间、追加到末尾都得到正确的结果；
+    3. assign() 的三种版本在容量够与不够、元素变多与变少时都正确，析构次数与构造次数对得上；
+    4. insert(pos, n, x) 这类整数参数不会被误当作迭代器区间；
+    5. 最后比较逐个 push_back 与 append_range 追加大量 int 的耗时和分配次数。
+*/
+
+/**
+ * @brief 记录存活对象个数的元素。
+*/
+struct Counted
+{
+    static inline long live = 0;
+
+    std::string text;
+
+    Counted(std::string __text) : text(std::move(__text)) { ++live; }
+    Counted(const Counted & __other) : text(__other.text) { ++live; }
+    Counted(Counted && __other) noexcept : text(std::move(__other.text)) { ++live; }
+    Counted & operator=(const Counted &) = default;
+    Counted & operator=(Counted &&) = default;
+    ~Counted() { --live; }
+};
+
+template <typename Vector, typename Expected>
+bool equals(const Vector & __vec, const Expected & __expected)
+{
+    if (__vec.size() != __expected.size()) { return false; }
+
+    return std::equal(__vec.begin(), __vec.end(), __expected.begin());
+}
+
+void checkForwardInsert(void)
+{
+    using Alloc = CountingAllocator<int>;
+
+    My_Vector<int, Alloc> vec{1, 2, 3};
+    std::forward_list<int> source{10, 11, 12, 13, 14};
+
+    Alloc::allocations = 0;
+    auto pos = vec.insert(vec.begin() + 1, source.begin(), source.end());
+    CHECK(Alloc::allocations == 1);
+    CHECK(pos == vec.begin() + 1);
+    CHECK(equals(vec, std::vector<int>{1, 10, 11, 12, 13, 14, 2, 3}));
+
+    /*空间足够时不分配*/
+    vec.insert(vec.end(), 100, 0);
+    vec.erase(vec.begin() + 8, vec.end());
+    Alloc::allocations = 0;
+    vec.insert(vec.begin(), {7, 8});
+    vec.insert(vec.end() - 1, source.begin(), source.end());
+    CHECK(Alloc::allocations == 0);
+    CHECK(equals(vec, std::vector<int>{7, 8, 1, 10, 11, 12, 13, 14, 2, 10, 11, 12, 13, 14, 3}));
+
+    /*非平凡的元素：插入点之后的元素比新元素多、少两种情况*/
+    My_Vector<std::string> strings{"a", "b", "c", "d"};
+    std::vector<std::string> two{"x", "y"};
+    std::vector<std::string> five{"1", "2", "3", "4", "5"};
+
+    strings.insert(strings.end(), 20, "");
+    strings.erase(strings.begin() + 4, strings.end());
+    strings.insert(strings.begin() + 1, two.begin(), two.end());
+    CHECK(equals(strings, std::vector<std::string>{"a", "x", "y", "b", "c", "d"}));
+
+    strings.insert(strings.end() - 1, five.begin(), five.end());
+    CHECK(equals(strings, std::vector<std::string>{"a", "x", "y", "b", "c", "1", "2", "3", "4", "5", "d"}));
+
+    strings.insert(strings.begin(), five.begin(), five.begin());
+    CHECK(strings.size() == 11);
+
+    /*整数参数仍然是 insert(pos, n, x)*/
+    My_Vector<int> ints;
+    ints.insert(ints.begin(), 3, 9);
+    CHECK(equals(ints, std::vector<int>{9, 9, 9}));
+}
+
+void checkInputInsert(void)
+{
+    std::istringstream stream("4 5 6");
+
+    My_Vector<int> vec{1, 2, 3};
+    auto pos = vec.insert(vec.begin() + 1, std::istream_iterator<int>(stream), std::istream_iterator<int>());
+
+    CHECK(*pos == 4);
+    CHECK(equals(vec, std::vector<int>{1, 4, 5, 6, 2, 3}));
+
+    std::istringstream words("p q r");
+    My_Vector<std::string> strings{"a"};
+    strings.append_range(std::vector<std::string>{"b", "c"});
+    strings.insert(strings.end(), std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+    CHECK(equals(strings, std::vector<std::string>{"a", "b", "c", "p", "q", "r"}));
+}
+
+void checkAssign(void)
+{
+    {
+        My_Vector<Counted> vec;
+
+        std::vector<Counted> many, few;
+        for (int index = 0; index < 10; ++index) { many.emplace_back(std::to_string(index)); }
+        for (int index = 0; index < 3; ++index) { few.emplace_back("f" + std::to_string(index)); }
+
+        const long before = Counted::live;
+
+        vec.assign(many.begin(), many.end());   // 容量不够
+        CHECK(vec.size() == 10 && vec[9].text == "9" && Counted::live == before + 10);
+
+        vec.assign(few.begin(), few.end());     // 变少
+        CHECK(vec.size() == 3 && vec[2].text == "f2" && Counted::live == before + 3);
+
+        vec.assign(many.begin(), many.end());   // 变多，容量足够
+        CHECK(vec.size() == 10 && vec[0].text == "0" && Counted::live == before + 10);
+
+        std::istringstream words("u v");
+        My_Vector<std::string> strings{"a", "b", "c"};
+        strings.assign(std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+        CHECK(equals(strings, std::vector<std::string>{"u", "v"}));
+
+        std::istringstream moreWords("1 2 3 4 5");
+        strings.assign(std::istream_iterator<std::string>(moreWords), std::istream_iterator<std::string>());
+        CHECK(equals(strings, std::vector<std::string>{"1", "2", "3", "4", "5"}));
+    }
+
+    CHECK(Counted::live == 0);
+
+    My_Vector<std::string> strings{"a", "b"};
+    strings.assign(5, strings[1]);              // __x 是 vector 自己的元素
+    CHECK(equals(strings, std::vector<std::string>(5, "b")));
+
+    strings.assign(2, "z");
+    CHECK(equals(strings, std::vector<std::string>(2, "z")));
+
+    strings.assign(4, "y");
+    CHECK(equals(strings, std::vector<std::string>(4, "y")));
+
+    strings.assign({"k"});
+    CHECK(equals(strings, std::vector<std::string>{"k"}));
+}
+
+void compareSpeed(void)
+{
+    using Alloc = CountingAllocator<int>;
+
+    constexpr int COUNT  = 1 << 20;
+    constexpr int ROUNDS = 20;
+
+    std::vector<int> source(COUNT);
+    for (int index = 0; index < COUNT; ++index) { source[index] = index; }
+
+    Alloc::allocations = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        My_Vector<int, Alloc> vec{0};
+        for (int value : source) { vec.push_back(value); }
+    }
+
+    std::chrono::duration<double, std::nano> loopTime = std::chrono::steady_clock::now() - startTime;
+    std::size_t loopAllocations = Alloc::allocations / ROUNDS;
+
+    Alloc::allocations = 0;
+    startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        My_Vector<int, Alloc> vec{0};
+        vec.append_range(source);
+
+        CHECK(vec.size() == COUNT + 1 && vec[COUNT] == COUNT - 1);
+    }
+
+    std::chrono::duration<double, std::nano> rangeTime = std::chrono::steady_clock::now() - startTime;
+
+    printf("append %d ints  push_back loop : %.2f ns/elem, %zu allocations;  append_range : %.2f ns/elem, %zu allocations\n",
+           COUNT, loopTime.count() / (double(COUNT) * ROUNDS), loopAllocations,
+           rangeTime.count() / (double(COUNT) * ROUNDS), Alloc::allocations / ROUNDS);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkForwardInsert();
+    checkInputInsert();
+    checkAssign();
+    compareSpeed();
+
+    return testResult();
+}
@@ -0,0 +1,235 @@
+#include "../include/myVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+    可平凡重定位（trivially relocatable）元素的测试：
+    1. 特化了 __isTriviallyRelocatable 的类型，在中间 insert / erase、扩容时都不调用移动构造和移动赋值；
+    2. std::unique_ptr、std::shared_ptr 默认可平凡重定位，插入、删除之后所有权和引用计数都正确；
+    3. 原地插入时构造新元素抛出异常，后移的元素搬回原处，vector 保持不变；
+    4. 最后比较可平凡重定位与不可平凡重定位（包一层的 unique_ptr）两种元素在中间反复插入、删除的耗时。
+*/
+
+/**
+ * @brief 持有一块堆内存的句柄，统计移动构造、移动赋值的次数和存活对象个数。
+*/
+struct Handle
+{
+    static inline long live  = 0;
+    static inline long moves = 0;
+
+    int * value;
+
+    Handle(int __value) : value(new int(__value)) { ++live; }
+    Handle(const Handle & __other) : value(new int(*__other.value)) { ++live; }
+    Handle(Handle && __other) noexcept : value(__other.value) { __other.value = nullptr; ++live; ++moves; }
+
+    Handle & operator=(const Handle & __other) { *this = Handle(__other); return *this; }
+    Handle & operator=(Handle && __other) noexcept
+    {
+        std::swap(this->value, __other.value);
+        ++moves;
+
+        return *this;
+    }
+
+    ~Handle() { delete this->value; --live; }
+};
+
+template <>
+struct __isTriviallyRelocatable<Handle> : std::true_type {};
+
+/**
+ * @brief 与 unique_ptr 行为相同、但没有特化 __isTriviallyRelocatable 的元素，用于对比。
+*/
+struct Boxed
+{
+    std::unique_ptr<int> pointer;
+
+    explicit Boxed(int * __pointer) : pointer(__pointer) {}
+    Boxed(Boxed &&) noexcept = default;
+    Boxed & operator=(Boxed &&) noexcept = default;
+};
+
+/**
+ * @brief 解引用到第 failAt 个元素时抛出异常的前向迭代器。
+*/
+struct ThrowingIterator
+{
+    typedef std::forward_iterator_tag   iterator_category;
+    typedef Handle                      value_type;
+    typedef std::ptrdiff_t              difference_type;
+    typedef const Handle *              pointer;
+    typedef Handle                      reference;
+
+    int current;
+    int failAt;
+
+    Handle operator*() const
+    {
+        if (this->current == this->failAt) { throw std::runtime_error("iterator failed"); }
+
+        return Handle(this->current);
+    }
+
+    ThrowingIterator & operator++() { ++this->current; return *this; }
+    ThrowingIterator operator++(int) { ThrowingIterator old = *this; ++this->current; return old; }
+
+    bool operator==(const ThrowingIterator & __other) const { return this->current == __other.current; }
+    bool operator!=(const ThrowingIterator & __other) const { return this->current != __other.current; }
+};
+
+template <typename Vector>
+bool valuesAre(const Vector & __vec, std::initializer_list<int> __expected)
+{
+    if (__vec.size() != __expected.size()) { return false; }
+
+    auto expected = __expected.begin();
+
+    for (const Handle & handle : __vec)
+    {
+        if (handle.value == nullptr || *handle.value != *expected++) { return false; }
+    }
+
+    return true;
+}
+
+void checkHandles(void)
+{
+    {
+        My_Vector<Handle> vec;
+
+        for (int index = 0; index < 6; ++index) { vec.emplace_back(index); }
+        vec.reserve(32);
+
+        std::vector<Handle> source;
+        source.emplace_back(30);
+        source.emplace_back(31);
+
+        Handle::moves = 0;
+
+        vec.emplace(vec.begin() + 2, 10);
+        vec.insert(vec.begin(), Handle(20));    // 临时对象移动构造一次，搬进数组不再移动
+        vec.erase(vec.begin() + 3);
+        vec.erase(vec.begin() + 1, vec.begin() + 3);
+        vec.insert(vec.begin() + 1, source.begin(), source.end());
+        vec.insert(vec.end() - 1, 2, Handle(40));
+
+        CHECK(Handle::moves == 1);
+        CHECK(valuesAre(vec, {20, 30, 31, 2, 3, 4, 40, 40, 5}));
+
+        /*扩容时旧元素按字节搬到新数组*/
+        Handle::moves = 0;
+        vec.shrink_to_fit();
+        vec.emplace(vec.begin() + 4, 50);
+        vec.insert(vec.begin(), 100, Handle(60));
+        CHECK(Handle::moves == 0 && vec.size() == 110);
+        CHECK(*vec[0].value == 60 && *vec[104].value == 50 && *vec[109].value == 5);
+
+        /*插入的值引用 vector 自身的元素*/
+        vec.erase(vec.begin(), vec.begin() + 100);
+        vec.shrink_to_fit();
+        vec.insert(vec.begin(), vec.back());
+        vec.insert(vec.begin(), vec[5]);
+        CHECK(valuesAre(vec, {50, 5, 20, 30, 31, 2, 50, 3, 4, 40, 40, 5}));
+    }
+
+    CHECK(Handle::live == 0);
+}
+
+void checkSmartPointers(void)
+{
+    My_Vector<std::unique_ptr<int>> pointers;
+    for (int index = 0; index < 10; ++index) { pointers.push_back(std::make_unique<int>(index)); }
+
+    pointers.erase(pointers.begin() + 2, pointers.begin() + 5);
+    pointers.emplace(pointers.begin(), std::make_unique<int>(100));
+    pointers.erase(pointers.begin() + 3);
+
+    std::vector<int> values;
+    for (const std::unique_ptr<int> & pointer : pointers) { values.push_back(*pointer); }
+    CHECK((values == std::vector<int>{100, 0, 1, 6, 7, 8, 9}));
+
+    std::shared_ptr<int> shared = std::make_shared<int>(7);
+
+    {
+        My_Vector<std::shared_ptr<int>> shareds(5, shared);
+        shareds.insert(shareds.begin() + 2, 3, shared);
+        shareds.erase(shareds.begin(), shareds.begin() + 4);
+        shareds.push_back(std::move(shareds.front()));
+
+        CHECK(shared.use_count() == 1 + 4);
+        CHECK(shareds.front() == nullptr && shareds.back() == shared);
+    }
+
+    CHECK(shared.use_count() == 1);
+}
+
+void checkExceptionSafety(void)
+{
+    {
+        My_Vector<Handle> vec;
+        for (int index = 0; index < 5; ++index) { vec.emplace_back(index); }
+        vec.reserve(20);
+
+        const long liveBefore = Handle::live;
+        bool thrown = false;
+
+        try { vec.insert(vec.begin() + 1, ThrowingIterator{0, 2}, ThrowingIterator{4, 2}); }
+        catch (const std::runtime_error &) { thrown = true; }
+
+        CHECK(thrown && Handle::live == liveBefore);
+        CHECK(valuesAre(vec, {0, 1, 2, 3, 4}));
+    }
+
+    CHECK(Handle::live == 0);
+}
+
+template <typename Element>
+double churn(int __size, int __rounds)
+{
+    My_Vector<Element> vec;
+    for (int index = 0; index < __size; ++index) { vec.emplace_back(new int(index)); }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < __rounds; ++round)
+    {
+        vec.emplace(vec.begin() + (round * 7919) % __size, new int(round));
+        vec.erase(vec.begin() + (round * 104729) % __size);
+    }
+
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    return elapsed.count() / __rounds;
+}
+
+void compareSpeed(void)
+{
+    constexpr int SIZE   = 100000;
+    constexpr int ROUNDS = 2000;
+
+    double relocated = churn<std::unique_ptr<int>>(SIZE, ROUNDS);
+    double moved     = churn<Boxed>(SIZE, ROUNDS);
+
+    printf("insert + erase in the middle of %d elements  unique_ptr (memmove) : %.2f us, "
+           "wrapped unique_ptr (move assignment) : %.2f us\n", SIZE, relocated, moved);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkHandles();
+    checkSmartPointers();
+    checkExceptionSafety();
+    compareSpeed();
+
+    return testResult();
+}
@@ -0,0 +1,161 @@
+#include "../include/myVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+
+/*
+    reserve / resize / shrink_to_fit 测试：
+    1. reserve() 只分配一次，不改变 size()，之后的 push_back 不再分配；
+    2. resize() 增大时最多分配一次，新元素值初始化，缩小时析构多出的元素；
+    3. resize(n, defaultInit) 与 My_Vector(n, defaultInit) 对平凡类型不做初始化；
+    4. shrink_to_fit() 只分配一次，让 capacity() == size()，空的 vector 直接释放内存；
+    5. 最后比较 10M 个 int 的 “逐个 push_back”、reserve + push_back、resize 与 resize(n, defaultInit) 的耗时。
+*/
+
+struct Counted
+{
+    static inline long live = 0;
+
+    std::string text;
+
+    Counted() : text("default") { ++live; }
+    Counted(const Counted & __other) : text(__other.text) { ++live; }
+    Counted(Counted && __other) noexcept : text(std::move(__other.text)) { ++live; }
+    ~Counted() { --live; }
+};
+
+void checkReserve(void)
+{
+    using Alloc = CountingAllocator<int>;
+
+    My_Vector<int, Alloc> vec{1, 2, 3};
+
+    Alloc::allocations = 0;
+    vec.reserve(10000000);
+    CHECK(Alloc::allocations == 1);
+    CHECK(vec.size() == 3 && vec.capacity() == 10000000);
+    CHECK(vec[0] == 1 && vec[2] == 3);
+
+    for (int index = 0; index < 1000; ++index) { vec.push_back(index); }
+    vec.reserve(100);
+    CHECK(Alloc::allocations == 1 && vec.size() == 1003);
+
+    /*shrink_to_fit 只分配一次*/
+    vec.shrink_to_fit();
+    CHECK(Alloc::allocations == 2);
+    CHECK(vec.capacity() == 1003 && vec[1002] == 999);
+    CHECK(Alloc::liveBytes == 1003 * sizeof(int));
+
+    vec.clear();
+    vec.shrink_to_fit();
+    CHECK(vec.capacity() == 0 && Alloc::liveBytes == 0);
+}
+
+void checkResize(void)
+{
+    using Alloc = CountingAllocator<int>;
+
+    My_Vector<int, Alloc> vec{5};
+
+    Alloc::allocations = 0;
+    vec.resize(1000000);
+    CHECK(Alloc::allocations == 1);
+    CHECK(vec.size() == 1000000 && vec[0] == 5 && vec[1] == 0 && vec[999999] == 0);
+
+    vec.resize(10);
+    CHECK(vec.size() == 10 && Alloc::allocations == 1);
+
+    vec.resize(20, vec[0]);
+    CHECK(vec.size() == 20 && vec[19] == 5 && vec[10] == 5 && vec[9] == 0);
+
+    /*默认初始化：只检查大小和已有元素，新元素的值不确定*/
+    vec.resize(5000000, defaultInit);
+    CHECK(vec.size() == 5000000 && vec[0] == 5 && vec[19] == 5);
+
+    My_Vector<int, Alloc> raw(1000, defaultInit);
+    CHECK(raw.size() == 1000 && raw.capacity() == 1000);
+
+    My_Vector<int, Alloc> zeros(1000);
+    CHECK(zeros.size() == 1000 && zeros[999] == 0);
+
+    /*非平凡类型：defaultInit 同样调用默认构造函数*/
+    {
+        My_Vector<Counted> objects;
+        objects.resize(100);
+        CHECK(Counted::live == 100 && objects[99].text == "default");
+
+        objects.resize(300, defaultInit);
+        CHECK(Counted::live == 300 && objects[299].text == "default");
+
+        objects.resize(50);
+        CHECK(Counted::live == 50);
+
+        objects.shrink_to_fit();
+        CHECK(Counted::live == 50 && objects.capacity() == 50 && objects[49].text == "default");
+    }
+
+    CHECK(Counted::live == 0);
+
+    /*__x 是本 vector 的元素，扩容之后仍然正确*/
+    My_Vector<std::string> strings;
+    strings.resize(3, "abc");
+    strings.resize(1000, strings[1]);
+    CHECK(strings.size() == 1000 && strings[999] == "abc");
+}
+
+template <typename Fill>
+double measure(Fill __fill, int __rounds)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < __rounds; ++round) { __fill(); }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    return elapsed.count() / __rounds;
+}
+
+void compareSpeed(void)
+{
+    constexpr int COUNT  = 10000000;
+    constexpr int ROUNDS = 5;
+
+    double pushBack = measure([] {
+        My_Vector<int> vec;
+        for (int index = 0; index < COUNT; ++index) { vec.push_back(index); }
+    }, ROUNDS);
+
+    double reserved = measure([] {
+        My_Vector<int> vec;
+        vec.reserve(COUNT);
+        for (int index = 0; index < COUNT; ++index) { vec.push_back(index); }
+    }, ROUNDS);
+
+    double valueInit = measure([] {
+        My_Vector<int> vec;
+        vec.resize(COUNT);
+        for (int index = 0; index < COUNT; ++index) { vec[index] = index; }
+    }, ROUNDS);
+
+    double defaultInitialized = measure([] {
+        My_Vector<int> vec;
+        vec.resize(COUNT, defaultInit);
+        for (int index = 0; index < COUNT; ++index) { vec[index] = index; }
+    }, ROUNDS);
+
+    printf("fill %d ints  push_back : %.2f ms, reserve + push_back : %.2f ms, "
+           "resize : %.2f ms, resize(defaultInit) : %.2f ms\n",
+           COUNT, pushBack, reserved, valueInit, defaultInitialized);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkReserve();
+    checkResize();
+    compareSpeed();
+
+    return testResult();
+}
@@ -0,0 +1,83 @@
+#include "../include/myVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <memory>
+#include <numeric>
+
+/*
+    元素访问基准：对同样的 int 数组，比较原生指针与 My_Vector 的 operator[]、迭代器、范围 for 三种遍历的耗时。
+
+    默认编译（__VECTOR_CHECKED_ 为 0）时迭代器就是原生指针，几种遍历的耗时应当与原生指针相同；
+    定义 __VECTOR_CHECKED_=1 再编译一次，得到检查模式的开销作为对比。
+*/
+
+#if !__VECTOR_CHECKED_
+static_assert(std::is_same<My_Vector<int>::iterator, int *>::value, "release iterators must be raw pointers");
+static_assert(std::is_same<My_Vector<int>::constIterator, const int *>::value, "release iterators must be raw pointers");
+#endif
+
+/*防止编译器把整个循环优化掉*/
+volatile long long sink = 0;
+
+template <typename Scan>
+double measure(Scan __scan, int __rounds)
+{
+    long long total = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < __rounds; ++round) { total += __scan(); }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+    sink = total;
+
+    return elapsed.count() / __rounds;
+}
+
+int main(int argc, char const *argv[])
+{
+    constexpr std::size_t COUNT  = 1 << 24;
+    constexpr int         ROUNDS = 20;
+
+    std::unique_ptr<int[]> raw(new int[COUNT]);
+    My_Vector<int> vec(COUNT, defaultInit);
+
+    for (std::size_t index = 0; index < COUNT; ++index) { raw[index] = vec[index] = int(index % 1000); }
+
+    const int * rawData = raw.get();
+    const My_Vector<int> & constVec = vec;
+
+    double rawTime = measure([&] {
+        long long sum = 0;
+        for (std::size_t index = 0; index < COUNT; ++index) { sum += rawData[index]; }
+        return sum;
+    }, ROUNDS);
+
+    double indexTime = measure([&] {
+        long long sum = 0;
+        for (std::size_t index = 0; index < constVec.size(); ++index) { sum += constVec[index]; }
+        return sum;
+    }, ROUNDS);
+
+    double iteratorTime = measure([&] {
+        long long sum = 0;
+        for (My_Vector<int>::constIterator iter = constVec.begin(); iter != constVec.end(); ++iter) { sum += *iter; }
+        return sum;
+    }, ROUNDS);
+
+    double rangeForTime = measure([&] {
+        long long sum = 0;
+        for (int value : constVec) { sum += value; }
+        return sum;
+    }, ROUNDS);
+
+    const long long expected = std::accumulate(rawData, rawData + COUNT, 0LL);
+    CHECK(sink == expected * ROUNDS);
+
+    printf("%s build, sum %zu ints  raw pointer : %.2f ms, operator[] : %.2f ms, iterator : %.2f ms, range for : %.2f ms\n",
+           __VECTOR_CHECKED_ ? "checked" : "release", COUNT, rawTime, indexTime, iteratorTime, rangeForTime);
+
+    return testResult();
+}
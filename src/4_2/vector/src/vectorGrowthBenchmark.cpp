@@ -0,0 +1,167 @@
+#include "../../../2_2_6-10/src/include/defaultAllocTemplate.h"
+#include "../include/myVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/*
+    扩容策略测试与基准：
+    1. doublingGrowth、oneAndHalfGrowth 的容量序列符合预期，insert 多个元素时至少扩到所需的大小；
+    2. pageGrowth 超过一页之后数组总是整页大小；
+    3. sizeClassGrowth 在 sgiAlloc 上每次扩容后，区块里剩下的空间都放不下一个元素；
+    4. 对每种策略（分别配合 std::allocator 与带 reallocate 的 mallocAlloc）在子进程中 push_back 大量 int，
+       报告吞吐量、峰值 RSS 与最终容量。
+*/
+
+/*3 字节的元素，容易看出尺寸级别取整的效果*/
+struct Triple { char bytes[3]; };
+
+template <typename Vector>
+bool capacitySequence(Vector & __vec, std::initializer_list<std::size_t> __expected)
+{
+    for (std::size_t capacity : __expected)
+    {
+        while (__vec.size() != __vec.capacity()) { __vec.push_back(0); }
+
+        __vec.push_back(0);
+        if (__vec.capacity() != capacity) { return false; }
+    }
+
+    return true;
+}
+
+void checkPolicies(void)
+{
+    My_Vector<int, std::allocator<int>, doublingGrowth> doubling;
+    CHECK(capacitySequence(doubling, {1, 2, 4, 8, 16, 32}));
+
+    My_Vector<int, std::allocator<int>, oneAndHalfGrowth> oneAndHalf;
+    CHECK(capacitySequence(oneAndHalf, {1, 2, 3, 5, 8, 12, 18, 27}));
+
+    /*一次插入很多元素时，至少扩到所需的大小*/
+    const std::size_t oldSize = oneAndHalf.size();
+    oneAndHalf.insert(oneAndHalf.end(), 1000, 7);
+    CHECK(oneAndHalf.capacity() == oldSize + 1000);
+
+    My_Vector<int, std::allocator<int>, pageGrowth> paged;
+    bool wholePages = true;
+
+    for (int index = 0; index < 1000000; ++index)
+    {
+        paged.push_back(index);
+
+        const std::size_t bytes = paged.capacity() * sizeof(int);
+        if (bytes >= 4096) { wholePages = wholePages && (bytes % 4096 == 0); }
+    }
+
+    CHECK(wholePages && paged[999999] == 999999);
+
+    My_Vector<Triple, sgiAlloc, sizeClassGrowth> classed;
+    bool noSlack = true;
+
+    for (int index = 0; index < 100000; ++index)
+    {
+        classed.push_back(Triple{});
+
+        const std::size_t bytes = classed.capacity() * sizeof(Triple);
+        noSlack = noSlack && (sgiAlloc::goodSize(bytes) - bytes < sizeof(Triple));
+    }
+
+    CHECK(noSlack);
+
+    /*sgiAlloc 的 8 字节区块能放下 2 个 Triple，第一次扩容就用上*/
+    My_Vector<Triple, sgiAlloc, sizeClassGrowth> small;
+    small.push_back(Triple{});
+    CHECK(small.capacity() == 2);
+}
+
+struct RunResult
+{
+    double      nsPerElement;
+    long        peakRssKiB;
+    std::size_t capacity;
+};
+
+template <typename Alloc, typename Policy>
+RunResult appendInts(long __count)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    My_Vector<int, Alloc, Policy> vec;
+    for (long index = 0; index < __count; ++index) { vec.push_back((int)index); }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    RunResult result{elapsed.count() / __count, 0, vec.capacity()};
+
+#if !defined(_WIN32)
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    result.peakRssKiB = usage.ru_maxrss;
+#endif
+
+    return result;
+}
+
+/**
+ * @brief 在子进程中运行一次，峰值 RSS 才不会被之前的运行抬高（Windows 下直接在本进程运行，不报告 RSS）。
+*/
+template <typename Alloc, typename Policy>
+void runIsolated(const char * __label, long __count)
+{
+#if !defined(_WIN32)
+    std::fflush(stdout);
+
+    pid_t child = fork();
+
+    if (child == 0)
+    {
+        RunResult result = appendInts<Alloc, Policy>(__count);
+
+        printf("%-36s %6.2f ns/elem   peak RSS %7.1f MiB   capacity %zu\n",
+               __label, result.nsPerElement, result.peakRssKiB / 1024.0, result.capacity);
+        std::fflush(stdout);
+        _exit(EXIT_SUCCESS);
+    }
+
+    int status = 0;
+    waitpid(child, &status, 0);
+#else
+    RunResult result = appendInts<Alloc, Policy>(__count);
+
+    printf("%-36s %6.2f ns/elem   capacity %zu\n", __label, result.nsPerElement, result.capacity);
+#endif
+}
+
+void compareSpeed(void)
+{
+    constexpr long COUNT = 24L * 1024 * 1024;
+
+    printf("push_back %ld ints (%.0f MiB of data)\n", COUNT, COUNT * sizeof(int) / 1048576.0);
+
+    runIsolated<std::allocator<int>, doublingGrowth>("std::allocator  doublingGrowth", COUNT);
+    runIsolated<std::allocator<int>, oneAndHalfGrowth>("std::allocator  oneAndHalfGrowth", COUNT);
+    runIsolated<std::allocator<int>, pageGrowth>("std::allocator  pageGrowth", COUNT);
+    runIsolated<std::allocator<int>, sizeClassGrowth>("std::allocator  sizeClassGrowth", COUNT);
+
+    runIsolated<mallocAlloc, doublingGrowth>("mallocAlloc     doublingGrowth", COUNT);
+    runIsolated<mallocAlloc, oneAndHalfGrowth>("mallocAlloc     oneAndHalfGrowth", COUNT);
+    runIsolated<mallocAlloc, pageGrowth>("mallocAlloc     pageGrowth", COUNT);
+    runIsolated<mallocAlloc, sizeClassGrowth>("mallocAlloc     sizeClassGrowth", COUNT);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkPolicies();
+    compareSpeed();
+
+    return testResult();
+}
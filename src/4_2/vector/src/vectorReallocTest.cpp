@@ -0,0 +1,199 @@
+#include "../../../2_2_6-10/src/include/defaultAllocTemplate.h"
+#include "../../../2_2_6-10/src/include/monotonicArena.h"
+#include "../include/myVector.h"
+#include "../../../common/include/testHarness.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <string>
+
+/*
+    reallocate 扩容测试：
+    1. 第二级配置器的 reallocate 在内存池和第一级配置器之间跨越时，区块各自还给原来的那一级，
+       同一尺寸级别内不搬移，两端都是大块内存时才交给 realloc；
+    2. 可平凡重定位的元素在提供 reallocate 的分配器上扩容，内容、对齐都不变，
+       arena 上最近一次分配的数组原地扩展，地址不变；
+    3. 插入的值引用数组自身的元素时，扩容之后仍然插入正确的值；
+    4. 非平凡的元素照旧走申请、拷贝、释放；
+    5. 最后比较一下 std::allocator 和 mallocAlloc 上 push_back 大量 int 的耗时。
+*/
+
+using singleAlloc = SGIAllocator::__DefaultAllocTemplate<false, 60>;
+using threadAlloc = SGIAllocator::__DefaultAllocTemplate<true, 61>;
+
+bool isAligned(const void * __ptr, std::size_t __align) { return ((std::uintptr_t)__ptr & (__align - 1)) == 0; }
+
+struct alignas(64) PaddedCounter
+{
+    long value;
+
+    PaddedCounter(long __value = 0) : value(__value) {}
+};
+
+template <typename Alloc>
+std::size_t liveBlocks(void)
+{
+    std::size_t count = 0;
+
+    for (const SGIAllocator::__SizeClassStats & sizeClass : Alloc::getStats().sizeClasses) { count += sizeClass.liveBlocks; }
+
+    return count;
+}
+
+bool isFilled(const void * __ptr, std::size_t __bytes, unsigned char __value)
+{
+    const unsigned char * bytes = (const unsigned char *)__ptr;
+
+    for (std::size_t index = 0; index < __bytes; ++index) { if (bytes[index] != __value) { return false; } }
+
+    return true;
+}
+
+template <typename Alloc>
+void checkDefaultReallocate(void)
+{
+    /*同一尺寸级别内不搬移*/
+    void * block = Alloc::allocate(20);
+    std::memset(block, 0x11, 20);
+    CHECK(Alloc::reallocate(block, 20, 24) == block);
+
+    /*内存池 -> 第一级配置器：小区块还给内存池*/
+    const std::size_t liveBefore = liveBlocks<Alloc>();
+    block = Alloc::reallocate(block, 24, 1000);
+    CHECK(liveBlocks<Alloc>() == liveBefore - 1);
+    CHECK(isFilled(block, 20, 0x11));
+
+    /*第一级配置器 -> 第一级配置器：交给 realloc*/
+    const std::size_t reallocsBefore = mallocAlloc::getStats().reallocations;
+    std::memset(block, 0x22, 1000);
+    block = Alloc::reallocate(block, 1000, 100000);
+    CHECK(mallocAlloc::getStats().reallocations == reallocsBefore + 1);
+    CHECK(isFilled(block, 1000, 0x22));
+
+    /*第一级配置器 -> 内存池：大块还给第一级配置器，新的区块来自内存池*/
+    block = Alloc::reallocate(block, 100000, 64);
+    CHECK(liveBlocks<Alloc>() == liveBefore);
+    CHECK(isFilled(block, 64, 0x22));
+    Alloc::deallocate(block, 64);
+
+    /*超出 __ALIGN 的对齐要求始终留在第一级配置器的对齐版本上*/
+    block = Alloc::allocate(64, 64);
+    std::memset(block, 0x33, 64);
+    block = Alloc::reallocate(block, 64, 4096, 64);
+    CHECK(isAligned(block, 64) && isFilled(block, 64, 0x33));
+    Alloc::deallocate(block, 4096, 64);
+}
+
+template <typename Vector>
+void fillAndCheck(Vector & __vec, long __count)
+{
+    for (long index = 0; index < __count; ++index) { __vec.push_back(index); }
+
+    bool allEqual = (__vec.size() == (std::size_t)__count);
+    for (long index = 0; allEqual && index < __count; ++index) { allEqual = (__vec[index] == index); }
+
+    CHECK(allEqual);
+}
+
+void checkVectorGrowth(void)
+{
+    {
+        My_Vector<long, mallocAlloc> vec;
+        fillAndCheck(vec, 100000);
+
+        /*插入的值来自数组自身*/
+        while (vec.size() != vec.capacity()) { vec.push_back(-1); }
+        vec.push_back(vec[7]);
+        CHECK(vec.back() == 7);
+
+        vec.insert(vec.begin() + 3, 5, vec[2]);
+        CHECK(vec[3] == 2 && vec[7] == 2 && vec[8] == 3);
+    }
+
+    {
+        My_Vector<int, sgiAlloc> vec;
+        fillAndCheck(vec, 100000);
+
+        while (vec.size() != vec.capacity()) { vec.push_back(-1); }
+        vec.insert(vec.begin() + 1, vec.capacity(), vec[0]);
+        CHECK(vec[0] == 0 && vec[1] == 0 && vec[vec.size() / 2 + 1] == 1);
+    }
+
+    {
+        My_Vector<PaddedCounter, sgiAlloc> vec;
+
+        for (long index = 0; index < 1000; ++index)
+        {
+            vec.push_back(PaddedCounter(index));
+            CHECK(isAligned(vec.data(), 64));
+        }
+
+        CHECK(vec[999].value == 999);
+    }
+
+    {
+        /*arena 上只有一个数组时，chunk 放得下就原地扩展*/
+        monotonicArena arena;
+        My_Vector<int, arenaAlloc<int>> vec{arenaAlloc<int>(arena)};
+
+        vec.push_back(0);
+        int * data = vec.data();
+
+        for (int index = 1; index < 8192; ++index) { vec.push_back(index); }
+
+        CHECK(vec.data() == data && vec[8191] == 8191);
+
+        for (int index = 8192; index < 100000; ++index) { vec.push_back(index); }
+        CHECK(vec[99999] == 99999 && vec[8191] == 8191);
+    }
+
+    {
+        My_Vector<std::string, mallocAlloc> vec;
+
+        for (int index = 0; index < 1000; ++index) { vec.push_back(std::to_string(index)); }
+
+        CHECK(vec[999] == "999");
+    }
+}
+
+template <typename Alloc>
+double pushBackLatency(long __count, int __rounds)
+{
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int round = 0; round < __rounds; ++round)
+    {
+        My_Vector<int, Alloc> vec;
+
+        for (long index = 0; index < __count; ++index) { vec.push_back((int)index); }
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    return elapsed.count() / (double(__count) * __rounds);
+}
+
+void compareSpeed(void)
+{
+    constexpr long COUNT  = 1L << 24;
+    constexpr int  ROUNDS = 5;
+
+    double stdLatency     = pushBackLatency<std::allocator<int>>(COUNT, ROUNDS);
+    double reallocLatency = pushBackLatency<mallocAlloc>(COUNT, ROUNDS);
+
+    printf("push_back %ld ints  std::allocator : %.2f ns/elem, mallocAlloc (reallocate) : %.2f ns/elem\n",
+           COUNT, stdLatency, reallocLatency);
+}
+
+int main(int argc, char const *argv[])
+{
+    checkDefaultReallocate<singleAlloc>();
+    checkDefaultReallocate<threadAlloc>();
+    checkVectorGrowth();
+    compareSpeed();
+
+    return testResult();
+}
@@ -17,7 +17,7 @@ template <
     typename Key, typename Value, typename KeyOfValue, 
     typename Compare, typename Alloc = std::allocator<RBTree_Node<Value>>
 >
-class RB_Tree
+class RB_Tree : protected Simple_Alloc<RBTree_Node<Value>, Alloc>
 {
     protected:  
         typedef void *                              void_pointer;
@@ -37,6 +37,7 @@ class RB_Tree
 
         typedef std::size_t         size_type;
         typedef std::ptrdiff_t      differece_type;
+        typedef Alloc               allocator_type;
     
     protected:
         /**
@@ -65,8 +66,9 @@ class RB_Tree
             }
             catch (...)
             {
-                /*创建失败就得销毁*/
+                /*创建失败就得销毁，再把异常交给调用端*/
                 this->put_node(temp_node);
+                throw;
             }
             
             return temp_node;
@@ -208,8 +210,56 @@ class RB_Tree
     private:
         iterator insert(base_ptr x, base_ptr y, const value_type & value);
 
+        /**
+         * @brief 复制以 x 为根的整棵子树，新子树的根挂在 p 之下，
+         *        途中抛出异常时已经复制的节点全部销毁。
+         * 
+         * @return 新子树的根
+        */
         link_type copy(link_type x, link_type p);
 
+        /**
+         * @brief 析构并释放以 x 为根的整棵子树（不做任何平衡调整）。
+        */
+        void destroy_subtree(link_type x)
+        {
+            while (x != nullptr)
+            {
+                this->destroy_subtree(right(x));
+
+                link_type y = left(x);
+                this->destory_node(x);
+                x = y;
+            }
+        }
+
+        /**
+         * @brief 把 __x 的所有节点复制到这颗（空的）树中。
+        */
+        void copy_from(const RB_Tree & __x)
+        {
+            if (__x.root() != nullptr)
+            {
+                this->root()      = this->copy(__x.root(), this->header);
+                this->leftmost()  = min_value(this->root());
+                this->rightmost() = max_value(this->root());
+            }
+
+            this->node_count = __x.node_count;
+        }
+
+        /**
+         * @brief 交换两颗树的 header、节点数和排序规则（不涉及分配器）。
+        */
+        static void swap_contents(RB_Tree & __a, RB_Tree & __b) noexcept
+        {
+            using std::swap;
+
+            swap(__a.header, __b.header);
+            swap(__a.node_count, __b.node_count);
+            swap(__a.key_compare, __b.key_compare);
+        }
+
         /**
          * @brief 移除掉红黑树中的指定节点 x
         */
@@ -242,11 +292,119 @@ class RB_Tree
         RB_Tree(const Compare & __comp = Compare()) : node_count(0ULL), key_compare(__comp)
         { this->init(); }
 
+        /**
+         * @brief 使用指定的分配器对象（比如一块 arena）构造红黑树
+         * 
+         * @param __comp    指定节点间的比较规则
+         * @param __alloc   节点分配器对象，所有节点（包括 header）都从它分配
+        */
+        RB_Tree(const Compare & __comp, const Alloc & __alloc) 
+            : rb_tree_node_allocator(__alloc), node_count(0ULL), key_compare(__comp)
+        { this->init(); }
+
+        /**
+         * @brief 拷贝构造函数，新树的分配器由 select_on_container_copy_construction 决定，
+         *        header 是新树自己的，节点逐个复制。
+        */
+        RB_Tree(const RB_Tree & __x) 
+            : rb_tree_node_allocator(__x.selectOnCopy()), node_count(0ULL), key_compare(__x.key_compare)
+        { 
+            this->init(); 
+
+            try { this->copy_from(__x); }
+            catch (...) { this->put_node(this->header); throw; }
+        }
+
+        /**
+         * @brief 移动构造函数，分配器随节点一起移动过来，`__x` 留下一颗空树（换到新分配的 header）。
+        */
+        RB_Tree(RB_Tree && __x) 
+            : rb_tree_node_allocator(__x.getAllocator()), node_count(0ULL), key_compare(__x.key_compare)
+        { 
+            this->init();
+            this->swap_contents(*this, __x);
+        }
+
+        /**
+         * @brief 拷贝赋值，分配器是否随之拷贝由 propagate_on_container_copy_assignment 决定。
+        */
+        RB_Tree & operator=(const RB_Tree & __x)
+        {
+            if (this != &__x)
+            {
+                this->clear();
+
+                if (rb_tree_node_allocator::propagateOnCopyAssignment::value && !this->equalAllocator(__x))
+                {
+                    /*旧的 header 只能由旧分配器释放*/
+                    this->put_node(this->header);
+                    this->copyAssignAllocator(__x);
+                    this->init();
+                }
+                else { this->copyAssignAllocator(__x); }
+
+                this->key_compare = __x.key_compare;
+                this->copy_from(__x);
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief 移动赋值。
+         * 
+         * @brief - 两个分配器相等时，直接交换双方的 header；
+         *          分配器会随之移动时，先用旧分配器释放自己的 header，再接管 `__x` 的节点；
+         *          否则本树的分配器无法释放 `__x` 的节点，只能逐个复制。
+        */
+        RB_Tree & operator=(RB_Tree && __x)
+        {
+            if (this != &__x)
+            {
+                this->clear();
+
+                if (this->equalAllocator(__x))
+                {
+                    this->moveAssignAllocator(__x);
+                    this->swap_contents(*this, __x);
+                }
+                else if (rb_tree_node_allocator::propagateOnMoveAssignment::value)
+                {
+                    this->put_node(this->header);
+                    this->moveAssignAllocator(__x);
+                    this->init();
+                    this->swap_contents(*this, __x);
+                }
+                else
+                {
+                    this->key_compare = __x.key_compare;
+                    this->copy_from(__x);
+                }
+            }
+
+            return *this;
+        }
+
         /**
          * @brief 销毁掉整棵红黑树
         */
         ~RB_Tree() { this->clear(); this->put_node(this->header); }
 
+        /**
+         * @brief 获取这颗树使用的分配器对象的副本。
+        */
+        allocator_type get_allocator() const { return allocator_type(this->getAllocator()); }
+
+        /**
+         * @brief 交换两颗树的内容，
+         *        分配器是否随之交换由 propagate_on_container_swap 决定（不交换时两个分配器必须相等）。
+        */
+        void swap(RB_Tree & __x) noexcept
+        {
+            this->swapAllocator(__x);
+            this->swap_contents(*this, __x);
+        }
+
         /**
          * @brief 获取这颗树的排序规则函数对象。
         */
@@ -282,13 +440,54 @@ template <
 >
 void RB_Tree<Key,  Value, KeyOfValue, Compare, Alloc>::clear(void)
 {
+    if (this->root() != nullptr)
+    {
+        this->destroy_subtree(this->root());
 
-#if false
-    std::for_each(
-        this->begin(), this->end(),
-        [&](iterator node_iter) -> void { this->destory_node(node_iter.node); }
-    );
-#endif
+        this->root()      = nullptr;
+        this->leftmost()  = this->header;
+        this->rightmost() = this->header;
+    }
 
     this->node_count = 0ULL;
+}
+
+template <
+    typename Key, typename Value, typename KeyOfValue, 
+    typename Compare, typename Alloc
+>
+typename RB_Tree<Key,  Value, KeyOfValue, Compare, Alloc>::link_type 
+RB_Tree<Key,  Value, KeyOfValue, Compare, Alloc>::copy(link_type x, link_type p)
+{
+    /*右子树递归复制，左侧的一串节点循环复制，递归深度不超过树高*/
+    link_type top = this->clone_node(x);
+    top->parent = p;
+
+    try
+    {
+        if (x->right != nullptr) { top->right = this->copy(right(x), top); }
+
+        p = top;
+        x = left(x);
+
+        while (x != nullptr)
+        {
+            link_type y = this->clone_node(x);
+
+            p->left   = y;
+            y->parent = p;
+
+            if (x->right != nullptr) { y->right = this->copy(right(x), y); }
+
+            p = y;
+            x = left(x);
+        }
+    }
+    catch (...)
+    {
+        this->destroy_subtree(top);
+        throw;
+    }
+
+    return top;
 }
\ No newline at end of file
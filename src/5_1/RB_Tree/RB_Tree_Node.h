@@ -58,7 +58,7 @@ struct  RBTree_Node_Base
  * @tparam Type 节点值类型
 */
 template <typename Type>
-class RBTree_Node : public RBTree_Node_Base
+struct RBTree_Node : public RBTree_Node_Base
 {
     typedef RBTree_Node<Type> * link_type;
 
@@ -1,5 +1,17 @@
 #include "../RB_Tree.h"
+#include "../../../common/include/testHarness.h"
+
 #include <functional>
+#include <stdexcept>
+
+/*
+    RB_Tree 拷贝与析构的测试（insert_unique 尚未实现，由测试子类用 create_node 直接挂节点建树）：
+    1. 空树的拷贝、移动、赋值、交换之后，每颗树都有自己的 header；
+    2. 拷贝构造得到结构、颜色、键值完全相同，但节点各自独立的树；
+    3. 分配器不相等且随拷贝赋值传播时，旧节点由旧分配器释放，新节点来自源树的分配器；
+       不传播时，新节点仍由本树的分配器分配；
+    4. 复制途中抛出异常时，已经复制的节点全部销毁，源树不受影响。
+*/
 
 template <typename Key, typename Value>
 struct KeyGetter
@@ -8,10 +20,277 @@ struct KeyGetter
     { return __pair.first; }
 };
 
+/**
+ * @brief 记录存活对象数的节点值，copiesUntilThrow 次拷贝之后的那次拷贝抛出异常（为负时不抛）。
+*/
+struct Tracked
+{
+    int key;
 
-int main(int argc, char const *argv[])
+    static inline long live = 0;
+    static inline long copiesUntilThrow = -1;
+
+    explicit Tracked(int __key) : key(__key) { ++live; }
+
+    Tracked(const Tracked & __other) : key(__other.key)
+    {
+        if (copiesUntilThrow >= 0 && copiesUntilThrow-- == 0) { throw std::runtime_error("injected copy failure"); }
+
+        ++live;
+    }
+
+    ~Tracked() { --live; }
+};
+
+struct TrackedKey
+{
+    int operator() (const Tracked & __value) const { return __value.key; }
+};
+
+/**
+ * @brief 带编号的有状态分配器，编号不同即不相等，按编号统计存活的节点数。
+*/
+template <typename Type, bool Propagate>
+struct TaggedAllocator
+{
+    typedef Type value_type;
+    typedef std::bool_constant<Propagate> propagate_on_container_copy_assignment;
+
+    template <typename Other>
+    struct rebind { typedef TaggedAllocator<Other, Propagate> other; };
+
+    static inline long live[4] = {0, 0, 0, 0};
+
+    int id;
+
+    explicit TaggedAllocator(int __id) : id(__id) {}
+
+    template <typename Other>
+    TaggedAllocator(const TaggedAllocator<Other, Propagate> & __other) : id(__other.id) {}
+
+    Type * allocate(std::size_t __n)
+    {
+        ++live[this->id];
+        return std::allocator<Type>().allocate(__n);
+    }
+
+    void deallocate(Type * __ptr, std::size_t __n)
+    {
+        --live[this->id];
+        std::allocator<Type>().deallocate(__ptr, __n);
+    }
+
+    template <typename Other>
+    bool operator==(const TaggedAllocator<Other, Propagate> & __other) const { return this->id == __other.id; }
+};
+
+/**
+ * @brief 能直接建树、检查结构的测试子类。
+*/
+template <typename Alloc>
+class TestTree : public RB_Tree<int, Tracked, TrackedKey, std::less<int>, Alloc>
+{
+    private:
+        typedef RB_Tree<int, Tracked, TrackedKey, std::less<int>, Alloc> base;
+        typedef typename base::link_type link_type;
+
+        /**
+         * @brief 用 [__first, __last) 中的键建一颗平衡的子树，按深度交替着色。
+        */
+        link_type attach(int __first, int __last, link_type __parent, int __depth)
+        {
+            if (__first >= __last) { return nullptr; }
+
+            const int middle = __first + (__last - __first) / 2;
+            link_type node   = this->create_node(Tracked(middle));
+
+            node->color  = (__depth % 2 == 0) ? RB_TREE_BLACK : RB_TREE_RED;
+            node->parent = __parent;
+            node->left   = this->attach(__first, middle, node, __depth + 1);
+            node->right  = this->attach(middle + 1, __last, node, __depth + 1);
+
+            return node;
+        }
+
+        /**
+         * @brief 两颗子树的键值、颜色、形状相同，节点互不共享，且父指针都指向各自树中的节点。
+        */
+        static bool sameSubtree(link_type __x, link_type __y, link_type __xParent, link_type __yParent)
+        {
+            if (__x == nullptr || __y == nullptr) { return __x == __y; }
+
+            return __x != __y && __x->parent == __xParent && __y->parent == __yParent &&
+                   __x->value_field.key == __y->value_field.key && __x->color == __y->color &&
+                   sameSubtree(base::left(__x), base::left(__y), __x, __y) &&
+                   sameSubtree(base::right(__x), base::right(__y), __x, __y);
+        }
+
+    public:
+        using base::base;
+
+        /**
+         * @brief 把空树建成键为 [__first, __last) 的树。
+        */
+        void build(int __first, int __last)
+        {
+            this->root()      = this->attach(__first, __last, this->header, 0);
+            this->leftmost()  = base::min_value(this->root());
+            this->rightmost() = base::max_value(this->root());
+            this->node_count  = __last - __first;
+        }
+
+        bool sameAs(const TestTree & __other) const
+        {
+            if (this->node_count != __other.node_count || this->header == __other.header) { return false; }
+
+            if (this->root() == nullptr)
+            {
+                return __other.root() == nullptr &&
+                       this->leftmost() == this->header && this->rightmost() == this->header;
+            }
+
+            return this->leftmost()  == base::min_value(this->root()) &&
+                   this->rightmost() == base::max_value(this->root()) &&
+                   sameSubtree(this->root(), __other.root(), this->header, __other.header);
+        }
+
+        int firstKey(void) const { return this->leftmost()->value_field.key; }
+        int lastKey(void)  const { return this->rightmost()->value_field.key; }
+};
+
+void checkEmpty(void)
 {
     RB_Tree<int, int, KeyGetter<int, int>, std::less<int>> testRB_Tree;
 
-    return EXIT_SUCCESS;
+    /*拷贝、移动、交换之后每颗树都有自己的 header，析构时不会重复释放*/
+    RB_Tree<int, int, KeyGetter<int, int>, std::less<int>> copyTree(testRB_Tree);
+    RB_Tree<int, int, KeyGetter<int, int>, std::less<int>> moveTree(std::move(copyTree));
+
+    copyTree = moveTree;
+    moveTree = std::move(testRB_Tree);
+    copyTree.swap(moveTree);
+
+    CHECK(copyTree.empty() && moveTree.empty() && testRB_Tree.empty());
+}
+
+void checkCopyConstruct(void)
+{
+    typedef TaggedAllocator<RBTree_Node<Tracked>, true> alloc;
+
+    TestTree<alloc> source(std::less<int>(), alloc(1));
+    source.build(0, 100);
+
+    {
+        TestTree<alloc> copy(source);
+
+        CHECK(copy.sameAs(source));
+        CHECK(copy.size() == 100 && copy.firstKey() == 0 && copy.lastKey() == 99);
+        CHECK(copy.get_allocator().id == 1);
+        CHECK(Tracked::live == 200 && alloc::live[1] == 2 * 101);
+    }
+
+    CHECK(Tracked::live == 100 && alloc::live[1] == 101);
+
+    /*只有一个节点的树*/
+    TestTree<alloc> single(std::less<int>(), alloc(1));
+    single.build(7, 8);
+
+    TestTree<alloc> singleCopy(single);
+    CHECK(singleCopy.sameAs(single) && singleCopy.firstKey() == 7 && singleCopy.lastKey() == 7);
+}
+
+template <bool Propagate>
+void checkCopyAssign(void)
+{
+    typedef TaggedAllocator<RBTree_Node<Tracked>, Propagate> alloc;
+
+    {
+        TestTree<alloc> source(std::less<int>(), alloc(1));
+        TestTree<alloc> target(std::less<int>(), alloc(2));
+
+        source.build(0, 50);
+        target.build(100, 130);
+
+        target = source;
+
+        CHECK(target.sameAs(source));
+        CHECK(target.firstKey() == 0 && target.lastKey() == 49);
+        CHECK(Tracked::live == 100);
+
+        if constexpr (Propagate)
+        {
+            /*旧的节点和 header 都还给了 2 号分配器，新的都来自 1 号*/
+            CHECK(target.get_allocator().id == 1);
+            CHECK(alloc::live[1] == 2 * 51 && alloc::live[2] == 0);
+        }
+        else
+        {
+            CHECK(target.get_allocator().id == 2);
+            CHECK(alloc::live[1] == 51 && alloc::live[2] == 51);
+        }
+
+        /*赋值给空树，再赋值回空树*/
+        TestTree<alloc> empty(std::less<int>(), alloc(3));
+        target = empty;
+        CHECK(target.sameAs(empty) && target.empty());
+
+        empty = source;
+        CHECK(empty.sameAs(source));
+    }
+
+    CHECK(Tracked::live == 0);
+    CHECK(alloc::live[1] == 0 && alloc::live[2] == 0 && alloc::live[3] == 0);
+}
+
+void checkThrowDuringClone(void)
+{
+    typedef TaggedAllocator<RBTree_Node<Tracked>, true> alloc;
+
+    TestTree<alloc> source(std::less<int>(), alloc(1));
+    source.build(0, 63);
+
+    TestTree<alloc> reference(source);
+
+    /*在复制的不同阶段抛出：根节点、右子树的递归中、左侧链的循环中*/
+    for (long throwAt : {0L, 1L, 5L, 31L, 62L})
+    {
+        bool thrown = false;
+        Tracked::copiesUntilThrow = throwAt;
+
+        try { TestTree<alloc> copy(source); }
+        catch (const std::runtime_error &) { thrown = true; }
+
+        CHECK(thrown);
+        CHECK(Tracked::live == 2 * 63 && alloc::live[1] == 2 * 64);
+        CHECK(source.sameAs(reference));
+
+        /*拷贝赋值失败后，目标留下一颗空树*/
+        TestTree<alloc> target(std::less<int>(), alloc(2));
+        target.build(200, 210);
+
+        thrown = false;
+        Tracked::copiesUntilThrow = throwAt;
+
+        try { target = source; }
+        catch (const std::runtime_error &) { thrown = true; }
+
+        CHECK(thrown && target.empty());
+        CHECK(Tracked::live == 2 * 63 && alloc::live[2] == 0);
+        CHECK(source.sameAs(reference));
+    }
+
+    Tracked::copiesUntilThrow = -1;
+}
+
+int main(int argc, char const *argv[])
+{
+    checkEmpty();
+    checkCopyConstruct();
+    checkCopyAssign<true>();
+    checkCopyAssign<false>();
+    checkThrowDuringClone();
+
+    CHECK(Tracked::live == 0);
+
+    return testResult();
 }
@@ -1,38 +1,5 @@
-#ifndef _SIMPLE_ALLOC_H_
-#define _SIMPLE_ALLOC_H_
-
-#include <cctype>
-
-template <typename Type, typename Alloc>
-class Simple_Alloc
-{
-    public:
-        static Type * allocate(std::size_t __n)
-        {
-            Alloc allocInstance;
-            return (!__n) ? nullptr : (Type *)allocInstance.allocate(__n * sizeof(Type));
-        }
-
-        static Type * allocate(void)
-        {
-            Alloc allocInstance;
-            return (Type *)allocInstance.allocate(sizeof(Type));
-        }
-
-        static void deallocate(Type * __ptr, std::size_t __n)
-        {
-            Alloc allocInstance;
-            if (__n != 0)
-            {
-                allocInstance.deallocate(__ptr, __n * sizeof(Type));
-            }
-        }
-
-        static void deallocate(Type *__ptr)
-        {
-            Alloc allocInstance;
-            allocInstance.deallocate(__ptr, sizeof(Type));
-        }
-};
-
-#endif // _SIMPLE_ALLOC_H_
\ No newline at end of file
+/*
+    RB_Tree 与第 4 章的容器共用同一份 Simple_Alloc，实现只在 4_2/simple_allocator/simpleAlloc.h 里维护，
+    这里仅做转发，保证两边的分配器特性不会各自演变。
+*/
+#include "../../4_2/simple_allocator/simpleAlloc.h"
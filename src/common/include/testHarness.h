@@ -0,0 +1,88 @@
+#ifndef _TEST_HARNESS_H_
+#define _TEST_HARNESS_H_
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+/*
+    各章测试程序共用的部分：
+    1. CHECK 宏与失败计数，检查失败时打印所在的文件、行号与表达式，但不中止程序；
+    2. testResult() 汇总结果，打印 PASSED 或 FAILED 并给出 main() 的返回值；
+    3. 统计申请次数与存活字节数的标准风格分配器 CountingAllocator。
+*/
+
+/**
+ * @brief 失败的检查数。
+*/
+inline std::size_t failedCount = 0;
+
+#define CHECK(condition)                                                        \
+    do                                                                          \
+    {                                                                           \
+        if (!(condition))                                                       \
+        {                                                                       \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);\
+            ++failedCount;                                                      \
+        }                                                                       \
+    } while (false)
+
+/**
+ * @brief 打印测试结果。
+ *
+ * @return 供 main() 返回的 EXIT_SUCCESS 或 EXIT_FAILURE
+*/
+inline int testResult(void)
+{
+    if (failedCount != 0)
+    {
+        printf("FAILED: %zu check(s)\n", failedCount);
+        return EXIT_FAILURE;
+    }
+
+    printf("PASSED\n");
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief 分别统计每种类型的 allocate() 次数和存活字节数的标准风格分配器，
+ *        计数是原子的，多线程的测试也能使用。
+ *
+ * @brief - 容器 rebind 出的每种类型各有一组计数，
+ *          例如 My_Deque 的缓冲区记在 CountingAllocator<Type>，map 记在 CountingAllocator<Type *>。
+*/
+template <typename Type>
+struct CountingAllocator
+{
+    typedef Type value_type;
+
+    static inline std::atomic<std::size_t> allocations{0};
+    static inline std::atomic<std::size_t> liveBytes{0};
+
+    CountingAllocator() = default;
+
+    template <typename Other>
+    CountingAllocator(const CountingAllocator<Other> &) {}
+
+    Type * allocate(std::size_t __n)
+    {
+        ++allocations;
+        liveBytes += __n * sizeof(Type);
+
+        return std::allocator<Type>().allocate(__n);
+    }
+
+    void deallocate(Type * __ptr, std::size_t __n)
+    {
+        liveBytes -= __n * sizeof(Type);
+        std::allocator<Type>().deallocate(__ptr, __n);
+    }
+
+    template <typename Other>
+    bool operator==(const CountingAllocator<Other> &) const { return true; }
+};
+
+#endif // _TEST_HARNESS_H_